@@ -6,6 +6,8 @@
 
 #include "concurrencpp/timers/timer.h"
 #include "concurrencpp/timers/timer_queue.h"
+#include "concurrencpp/timers/rate_limiter.h"
+#include "concurrencpp/timers/retry.h"
 #include "concurrencpp/runtime/runtime.h"
 #include "concurrencpp/results/result.h"
 #include "concurrencpp/results/lazy_result.h"
@@ -16,8 +18,19 @@
 #include "concurrencpp/results/promises.h"
 #include "concurrencpp/results/resume_on.h"
 #include "concurrencpp/results/generator.h"
+#include "concurrencpp/results/async_generator.h"
+#include "concurrencpp/results/chunked_generator.h"
+#include "concurrencpp/results/parallel_map.h"
+#include "concurrencpp/results/async_lazy.h"
+#include "concurrencpp/results/single_flight.h"
 #include "concurrencpp/executors/executor_all.h"
 #include "concurrencpp/threads/async_lock.h"
+#include "concurrencpp/threads/async_shared_mutex.h"
+#include "concurrencpp/threads/async_semaphore.h"
+#include "concurrencpp/threads/async_event.h"
+#include "concurrencpp/threads/async_latch.h"
+#include "concurrencpp/threads/async_barrier.h"
+#include "concurrencpp/threads/channel.h"
 #include "concurrencpp/threads/async_condition_variable.h"
 
 #endif
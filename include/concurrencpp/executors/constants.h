@@ -18,6 +18,10 @@ namespace concurrencpp::details::consts {
 
     inline const char* k_manual_executor_name = "concurrencpp::manual_executor";
     constexpr int k_manual_executor_max_concurrency_level = std::numeric_limits<int>::max();
+    inline const char* k_manual_executor_null_timer_queue_err_msg = "manual_executor - given timer_queue is null.";
+    inline const char* k_manual_executor_real_time_timer_queue_err_msg =
+        "manual_executor - given timer_queue does not use virtual time.";
+    inline const char* k_manual_executor_not_virtual_err_msg = "manual_executor - *this does not use virtual time.";
 
     inline const char* k_executor_shutdown_err_msg = " - shutdown has been called on this executor.";
 }  // namespace concurrencpp::details::consts
@@ -13,11 +13,15 @@ namespace concurrencpp {
     class CRCPP_API alignas(CRCPP_CACHE_LINE_ALIGNMENT) manual_executor final : public derivable_executor<manual_executor> {
 
        private:
+        using virtual_time_point = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
         mutable std::mutex m_lock;
         std::deque<task> m_tasks;
         std::condition_variable m_condition;
         bool m_abort;
         std::atomic_bool m_atomic_abort;
+        const std::weak_ptr<timer_queue> m_virtual_timer_queue;
+        const bool m_virtual_time;
 
         template<class clock_type, class duration_type>
         static std::chrono::system_clock::time_point to_system_time_point(
@@ -31,14 +35,38 @@ namespace concurrencpp {
             return std::chrono::system_clock::now() + ms;
         }
 
+        /*
+         * time points of a real clock (high_resolution_clock included, which may be system_clock) are relative to that
+         * clock: the virtual clock may move as far as the real one would have. virtual time points are passed with
+         * virtual_time_tag. max() stays unbounded.
+         */
+        template<class clock_type, class duration_type>
+        virtual_time_point to_virtual_time_point(std::chrono::time_point<clock_type, duration_type> time_point) const {
+            if (time_point == std::chrono::time_point<clock_type, duration_type>::max()) {
+                return virtual_time_point::max();
+            }
+
+            const auto now = virtual_now();
+            const auto remaining = std::chrono::duration_cast<virtual_time_point::duration>(time_point - clock_type::now());
+            if (remaining <= virtual_time_point::duration::zero()) {
+                return now;
+            }
+
+            return (remaining >= virtual_time_point::max() - now) ? virtual_time_point::max() : now + remaining;
+        }
+
+        virtual_time_point virtual_now() const;
+
         size_t loop_impl(size_t max_count);
         size_t loop_until_impl(size_t max_count, std::chrono::time_point<std::chrono::system_clock> deadline);
+        size_t loop_until_virtual_impl(size_t max_count, virtual_time_point deadline);
 
         void wait_for_tasks_impl(size_t count);
         size_t wait_for_tasks_impl(size_t count, std::chrono::time_point<std::chrono::system_clock> deadline);
 
        public:
         manual_executor();
+        manual_executor(std::shared_ptr<timer_queue> virtual_timer_queue);
 
         void enqueue(task task) override;
         void enqueue(std::span<task> tasks) override;
@@ -58,17 +86,29 @@ namespace concurrencpp {
 
         template<class clock_type, class duration_type>
         bool loop_once_until(std::chrono::time_point<clock_type, duration_type> timeout_time) {
+            if (m_virtual_time) {
+                return loop_until_virtual_impl(1, to_virtual_time_point(timeout_time));
+            }
+
             return loop_until_impl(1, to_system_time_point(timeout_time));
         }
 
+        bool loop_once_until(virtual_time_tag, std::chrono::time_point<std::chrono::high_resolution_clock> timeout_time);
+
         size_t loop(size_t max_count);
         size_t loop_for(size_t max_count, std::chrono::milliseconds max_waiting_time);
 
         template<class clock_type, class duration_type>
         size_t loop_until(size_t max_count, std::chrono::time_point<clock_type, duration_type> timeout_time) {
+            if (m_virtual_time) {
+                return loop_until_virtual_impl(max_count, to_virtual_time_point(timeout_time));
+            }
+
             return loop_until_impl(max_count, to_system_time_point(timeout_time));
         }
 
+        size_t loop_until(size_t max_count, virtual_time_tag, std::chrono::time_point<std::chrono::high_resolution_clock> timeout_time);
+
         void wait_for_task();
         bool wait_for_task_for(std::chrono::milliseconds max_waiting_time);
 
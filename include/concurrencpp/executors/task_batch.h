@@ -0,0 +1,57 @@
+#ifndef CONCURRENCPP_TASK_BATCH_H
+#define CONCURRENCPP_TASK_BATCH_H
+
+#include "concurrencpp/task.h"
+#include "concurrencpp/platform_defs.h"
+#include "concurrencpp/coroutines/coroutine.h"
+#include "concurrencpp/forward_declarations.h"
+
+#include <memory>
+#include <vector>
+
+namespace concurrencpp::details {
+    /*
+     * Groups tasks by the executor they should run in, so each executor receives a single enqueue(std::span<task>) call
+     * per batch instead of one post per task. used for fired timers and for coroutines resumed by the async primitives.
+     * if an executor throws (e.g. it was shut down), the tasks it didn't consume are destroyed, so await_via_functor
+     * tasks resume their coroutines inline with an interrupt.
+     * the buffers are reused across batches: a batch that lives on the stack borrows them from a per-thread cache, and
+     * gives them back when it's destroyed.
+     */
+    class CRCPP_API task_batch {
+
+        struct executor_batch {
+            std::shared_ptr<concurrencpp::executor> executor;
+            std::vector<task> tasks;
+        };
+
+       private:
+        std::vector<executor_batch> m_batches;
+        size_t m_active_batches = 0;
+
+        static std::vector<executor_batch>* thread_cached_batches() noexcept;
+
+        std::vector<task>& reserve_task(const std::shared_ptr<concurrencpp::executor>& executor);
+
+       public:
+        task_batch() noexcept;
+        ~task_batch() noexcept;
+
+        task_batch(const task_batch&) = delete;
+        task_batch& operator=(const task_batch&) = delete;
+
+        bool empty() const noexcept {
+            return m_active_batches == 0;
+        }
+
+        void add(const std::shared_ptr<concurrencpp::executor>& executor, task task);
+
+        // resumes caller_handle in executor. if this throws, nothing was added and the coroutine was not touched.
+        void add(const std::shared_ptr<concurrencpp::executor>& executor, coroutine_handle<void> caller_handle, bool* interrupted);
+
+        void submit() noexcept;
+        void reset_memory() noexcept;
+    };
+}  // namespace concurrencpp::details
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef CONCURRENCPP_FORWARD_DECLARATIONS_H
 #define CONCURRENCPP_FORWARD_DECLARATIONS_H
 
+#include <cstddef>
+
 namespace concurrencpp {
     struct null_result;
 
@@ -16,10 +18,18 @@ namespace concurrencpp {
     template<class type>
     class result_promise;
 
+    template<class type>
+    class async_lazy;
+
+    template<class key_type, class value_type, class hash_type, class key_equal_type>
+    class single_flight;
+
     class runtime;
 
     class timer_queue;
+    struct virtual_time_tag;
     class timer;
+    class rate_limiter;
 
     class executor;
     class inline_executor;
@@ -31,7 +41,24 @@ namespace concurrencpp {
     template<typename type>
     class generator;
 
+    template<typename type>
+    class elements_of;
+
+    template<typename type, size_t chunk_size>
+    class chunked_generator;
+
+    template<typename type>
+    class async_generator;
+
     class async_lock;
+    class async_shared_mutex;
+    class async_semaphore;
+    class async_manual_reset_event;
+    class async_latch;
+    class async_barrier;
+
+    template<typename type>
+    class channel;
     class async_condition_variable;
 }  // namespace concurrencpp
 
@@ -0,0 +1,56 @@
+#ifndef CONCURRENCPP_ASYNC_GENERATOR_H
+#define CONCURRENCPP_ASYNC_GENERATOR_H
+
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/impl/async_generator_state.h"
+#include "concurrencpp/errors.h"
+
+namespace concurrencpp {
+    /*
+     * A lazy coroutine that produces a stream of values and may co_await between them. the consumer pulls values with
+     * co_await next(): control is transferred to the generator, and back to the consumer when the next value is yielded,
+     * without posting to any executor and without allocating per value.
+     */
+    template<typename type>
+    class async_generator {
+
+       public:
+        using promise_type = details::async_generator_state<type>;
+        using value_type = typename promise_type::value_type;
+
+        static_assert(!std::is_same_v<type, void>, "concurrencpp::async_generator<type> - <<type>> can not be void.");
+
+       private:
+        details::coroutine_handle<promise_type> m_coro_handle;
+
+       public:
+        async_generator(details::coroutine_handle<promise_type> handle) noexcept : m_coro_handle(handle) {}
+
+        async_generator(async_generator&& rhs) noexcept : m_coro_handle(std::exchange(rhs.m_coro_handle, {})) {}
+
+        ~async_generator() noexcept {
+            if (static_cast<bool>(m_coro_handle)) {
+                m_coro_handle.destroy();
+            }
+        }
+
+        async_generator(const async_generator& rhs) = delete;
+
+        async_generator& operator=(async_generator&& rhs) = delete;
+        async_generator& operator=(const async_generator& rhs) = delete;
+
+        explicit operator bool() const noexcept {
+            return static_cast<bool>(m_coro_handle);
+        }
+
+        details::async_generator_next_awaitable<type> next() {
+            if (!static_cast<bool>(m_coro_handle)) {
+                throw errors::empty_generator(details::consts::k_empty_async_generator_next_err_msg);
+            }
+
+            return {m_coro_handle};
+        }
+    };
+}  // namespace concurrencpp
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef CONCURRENCPP_ASYNC_LAZY_H
+#define CONCURRENCPP_ASYNC_LAZY_H
+
+#include "concurrencpp/task.h"
+#include "concurrencpp/results/promises.h"
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/shared_result.h"
+#include "concurrencpp/results/impl/awaitable_traits.h"
+#include "concurrencpp/results/impl/shared_result_state.h"
+#include "concurrencpp/executors/executor.h"
+#include "concurrencpp/forward_declarations.h"
+#include "concurrencpp/errors.h"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace concurrencpp::details {
+    /*
+     * The one-shot task that is posted to the executor of an async_lazy. it publishes the value (or the exception) of the
+     * initializer to the shared state. if the executor destroys the task without running it, the state is completed
+     * with a broken_task exception, so the coroutines that wait on it are not left hanging.
+     */
+    template<class type, class callable_type>
+    class async_lazy_initializer {
+
+       private:
+        std::shared_ptr<shared_result_state<type>> m_state;
+        callable_type m_callable;
+
+        static null_result run(std::shared_ptr<shared_result_state<type>> state, callable_type callable) {
+            using traits = callable_awaitable_traits<callable_type>;
+
+            try {
+                if constexpr (traits::is_awaitable) {
+                    if constexpr (std::is_same_v<type, void>) {
+                        co_await callable();
+                        state->set_result();
+                    } else {
+                        state->set_result(co_await callable());
+                    }
+                } else {
+                    if constexpr (std::is_same_v<type, void>) {
+                        callable();
+                        state->set_result();
+                    } else {
+                        state->set_result(callable());
+                    }
+                }
+            } catch (...) {
+                state->unhandled_exception();
+            }
+
+            state->complete_producer();
+        }
+
+       public:
+        async_lazy_initializer(std::shared_ptr<shared_result_state<type>> state, callable_type callable) noexcept(
+            std::is_nothrow_move_constructible_v<callable_type>) :
+            m_state(std::move(state)),
+            m_callable(std::move(callable)) {}
+
+        async_lazy_initializer(async_lazy_initializer&& rhs) noexcept(std::is_nothrow_move_constructible_v<callable_type>) =
+            default;
+
+        ~async_lazy_initializer() noexcept {
+            if (!static_cast<bool>(m_state)) {
+                return;
+            }
+
+            try {
+                throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+            } catch (...) {
+                m_state->unhandled_exception();
+            }
+
+            m_state->complete_producer();
+        }
+
+        void operator()() {
+            run(std::move(m_state), std::move(m_callable));
+        }
+    };
+
+    template<class type>
+    class async_lazy_awaitable : public suspend_always {
+
+       private:
+        async_lazy<type>& m_parent;
+        shared_await_context m_await_ctx;
+
+       public:
+        async_lazy_awaitable(async_lazy<type>& parent) noexcept : m_parent(parent) {}
+
+        async_lazy_awaitable(const async_lazy_awaitable&) = delete;
+        async_lazy_awaitable(async_lazy_awaitable&&) = delete;
+
+        bool await_ready() const noexcept {
+            return m_parent.m_state->status() != result_status::idle;
+        }
+
+        bool await_suspend(coroutine_handle<void> caller_handle) noexcept {
+            m_parent.start();
+            m_await_ctx.caller_handle = caller_handle;
+            return m_parent.m_state->await(m_await_ctx);
+        }
+
+        std::add_lvalue_reference_t<type> await_resume() {
+            return m_parent.m_state->get();
+        }
+    };
+}  // namespace concurrencpp::details
+
+namespace concurrencpp {
+    /*
+     * A value that is produced once, asynchronously, the first time it is needed. the initializer runs exactly once on the
+     * given executor; coroutines that await the async_lazy meanwhile are parked on its shared state and are resumed by the
+     * initializer when it's done. once the value is ready, awaiting it costs a single acquire load.
+     * if the initializer returns a result or a lazy_result, it is awaited and its value (or exception) is the value.
+     * the async_lazy must outlive the coroutines that await it.
+     */
+    template<class type>
+    class async_lazy {
+
+        friend class details::async_lazy_awaitable<type>;
+
+       private:
+        const std::shared_ptr<details::shared_result_state<type>> m_state;
+        const std::shared_ptr<executor> m_executor;
+        std::atomic_bool m_started {false};
+        task m_initializer;
+
+        static std::shared_ptr<executor> verify_executor(std::shared_ptr<executor> executor) {
+            if (!static_cast<bool>(executor)) {
+                throw std::invalid_argument(details::consts::k_async_lazy_null_executor_err_msg);
+            }
+
+            return executor;
+        }
+
+       public:
+        template<class callable_type>
+        async_lazy(std::shared_ptr<executor> executor, callable_type&& callable) :
+            m_state(std::make_shared<details::shared_result_state<type>>()), m_executor(verify_executor(std::move(executor))),
+            m_initializer(details::async_lazy_initializer<type, std::decay_t<callable_type>>(
+                m_state,
+                std::forward<callable_type>(callable))) {
+            static_assert(
+                std::is_same_v<typename details::callable_awaitable_traits<std::decay_t<callable_type>>::value_type, type>,
+                "concurrencpp::async_lazy - <<callable_type>> does not produce <<type>>.");
+        }
+
+        async_lazy(const async_lazy&) = delete;
+        async_lazy(async_lazy&&) = delete;
+
+        void start() noexcept {
+            if (m_started.load(std::memory_order_acquire) || m_started.exchange(true, std::memory_order_acq_rel)) {
+                return;
+            }
+
+            // if enqueue throws, the initializer is destroyed and completes the state with a broken_task exception.
+            try {
+                m_executor->enqueue(std::move(m_initializer));
+            } catch (...) {
+            }
+        }
+
+        result_status status() const noexcept {
+            return m_state->status();
+        }
+
+        std::add_lvalue_reference_t<type> get() {
+            start();
+            m_state->wait();
+            return m_state->get();
+        }
+
+        auto operator co_await() noexcept {
+            return details::async_lazy_awaitable<type> {*this};
+        }
+
+        shared_result<type> share() {
+            start();
+            return {m_state};
+        }
+    };
+
+    /*
+     * An async_lazy without a value: runs an asynchronous initialization exactly once.
+     */
+    using async_once = async_lazy<void>;
+}  // namespace concurrencpp
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef CONCURRENCPP_CHUNKED_GENERATOR_H
+#define CONCURRENCPP_CHUNKED_GENERATOR_H
+
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/impl/chunked_generator_state.h"
+#include "concurrencpp/errors.h"
+
+namespace concurrencpp {
+    /*
+     * A generator that hands out its values in contiguous chunks of up to chunk_size values. values yielded one by one
+     * are buffered, and the generator is resumed once per chunk instead of once per value. spans of values can be
+     * yielded as well, and are handed out as chunks of their own without being copied.
+     * the buffer is a std::array<type, chunk_size>, so type must be default constructible.
+     */
+    template<typename type, size_t chunk_size>
+    class chunked_generator {
+
+       public:
+        using promise_type = details::chunked_generator_state<type, chunk_size>;
+        using iterator = details::chunked_generator_iterator<type, chunk_size>;
+        using chunk_iterator = details::chunked_generator_chunk_iterator<type, chunk_size>;
+
+        static_assert(!std::is_reference_v<type> && !std::is_const_v<type>,
+                      "concurrencpp::chunked_generator<type, chunk_size> - <<type>> must be a non-const value type.");
+        static_assert(chunk_size != 0, "concurrencpp::chunked_generator<type, chunk_size> - <<chunk_size>> can not be zero.");
+        static_assert(std::is_default_constructible_v<type>,
+                      "concurrencpp::chunked_generator<type, chunk_size> - <<type>> must be default constructible.");
+
+        class chunk_range {
+
+           private:
+            details::coroutine_handle<promise_type> m_coro_handle;
+
+           public:
+            chunk_range(details::coroutine_handle<promise_type> handle) noexcept : m_coro_handle(handle) {}
+
+            chunk_iterator begin() {
+                m_coro_handle.promise().next_chunk(m_coro_handle);
+                return chunk_iterator {m_coro_handle};
+            }
+
+            static details::chunked_generator_end_iterator end() noexcept {
+                return {};
+            }
+        };
+
+       private:
+        details::coroutine_handle<promise_type> m_coro_handle;
+
+        void throw_if_empty(const char* error_message) const {
+            if (!static_cast<bool>(m_coro_handle)) {
+                throw errors::empty_generator(error_message);
+            }
+        }
+
+       public:
+        chunked_generator(details::coroutine_handle<promise_type> handle) noexcept : m_coro_handle(handle) {}
+
+        chunked_generator(chunked_generator&& rhs) noexcept : m_coro_handle(std::exchange(rhs.m_coro_handle, {})) {}
+
+        ~chunked_generator() noexcept {
+            if (static_cast<bool>(m_coro_handle)) {
+                m_coro_handle.destroy();
+            }
+        }
+
+        chunked_generator(const chunked_generator& rhs) = delete;
+
+        chunked_generator& operator=(chunked_generator&& rhs) = delete;
+        chunked_generator& operator=(const chunked_generator& rhs) = delete;
+
+        explicit operator bool() const noexcept {
+            return static_cast<bool>(m_coro_handle);
+        }
+
+        iterator begin() {
+            throw_if_empty(details::consts::k_empty_chunked_generator_begin_err_msg);
+            m_coro_handle.promise().next_chunk(m_coro_handle);
+            return iterator {m_coro_handle};
+        }
+
+        static details::chunked_generator_end_iterator end() noexcept {
+            return {};
+        }
+
+        // the range doesn't own the generator, which has to outlive it.
+        chunk_range chunks() const& {
+            throw_if_empty(details::consts::k_empty_chunked_generator_chunks_err_msg);
+            return {m_coro_handle};
+        }
+
+        chunk_range chunks() && = delete;
+    };
+}  // namespace concurrencpp
+
+#endif
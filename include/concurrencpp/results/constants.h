@@ -38,6 +38,16 @@ namespace concurrencpp::details::consts {
 
     inline const char* k_result_resolve_error_msg = "result::resolve() - result is empty.";
 
+    inline const char* k_result_resolve_for_error_msg = "result::resolve_for() - result is empty.";
+
+    inline const char* k_result_resolve_until_error_msg = "result::resolve_until() - result is empty.";
+
+    inline const char* k_result_then_error_msg = "result::then() - result is empty.";
+
+    inline const char* k_result_then_null_executor_error_msg = "result::then() - given executor is null.";
+
+    inline const char* k_result_then_inline_error_msg = "result::then_inline() - result is empty.";
+
     inline const char* k_executor_exception_error_msg =
         "concurrencpp::result - an exception was thrown while trying to enqueue result continuation.";
 
@@ -63,6 +73,8 @@ namespace concurrencpp::details::consts {
      * shared_result
      */
 
+    inline const char* k_shared_result_null_resume_executor_error_msg = "shared_result::shared_result() - given resume executor is null.";
+
     inline const char* k_shared_result_status_error_msg = "shared_result::status() - result is empty.";
 
     inline const char* k_shared_result_get_error_msg = "shared_result::get() - result is empty.";
@@ -77,6 +89,10 @@ namespace concurrencpp::details::consts {
 
     inline const char* k_shared_result_resolve_error_msg = "shared_result::resolve() - result is empty.";
 
+    inline const char* k_shared_result_resolve_for_error_msg = "shared_result::resolve_for() - result is empty.";
+
+    inline const char* k_shared_result_resolve_until_error_msg = "shared_result::resolve_until() - result is empty.";
+
     /*
      * lazy_result
      */
@@ -89,6 +105,18 @@ namespace concurrencpp::details::consts {
 
     inline const char* k_empty_lazy_result_run_err_msg = "lazy_result::run - result is empty.";
 
+    inline const char* k_empty_lazy_result_resolve_for_err_msg = "lazy_result::resolve_for - result is empty.";
+
+    inline const char* k_empty_lazy_result_resolve_until_err_msg = "lazy_result::resolve_until - result is empty.";
+
+    /*
+     * resolve_for / resolve_until
+     */
+
+    inline const char* k_resolve_timeout_null_timer_queue_error_msg = "resolve_for/resolve_until - given timer_queue is null.";
+
+    inline const char* k_resolve_timeout_null_executor_error_msg = "resolve_for/resolve_until - given timeout executor is null.";
+
     /*
      * resume_on
      */
@@ -99,6 +127,42 @@ namespace concurrencpp::details::consts {
      * generator
      */
     inline const char* k_empty_generator_begin_err_msg = "generator::begin - generator is empty.";
+    inline const char* k_empty_generator_elements_of_err_msg = "elements_of - given generator is empty.";
+
+    /*
+     * chunked_generator
+     */
+    inline const char* k_empty_chunked_generator_begin_err_msg = "chunked_generator::begin - generator is empty.";
+    inline const char* k_empty_chunked_generator_chunks_err_msg = "chunked_generator::chunks - generator is empty.";
+
+    /*
+     * async_generator
+     */
+    inline const char* k_empty_async_generator_next_err_msg = "async_generator::next - async_generator is empty.";
+
+    /*
+     * parallel_map
+     */
+    inline const char* k_parallel_map_null_executor_err_msg = "parallel_map - given executor is null.";
+    inline const char* k_parallel_map_empty_generator_err_msg = "parallel_map - given generator is empty.";
+    inline const char* k_parallel_map_zero_window_err_msg = "parallel_map - window must be greater than zero.";
+    inline const char* k_parallel_map_zero_chunk_size_err_msg = "parallel_map - chunk_size must be greater than zero.";
+
+    /*
+     * async_lazy
+     */
+    inline const char* k_async_lazy_null_executor_err_msg = "async_lazy::async_lazy() - given executor is null.";
+
+    /*
+     * single_flight
+     */
+    inline const char* k_single_flight_null_executor_err_msg = "single_flight::single_flight() - given executor is null.";
+
+    inline const char* k_single_flight_null_timer_queue_err_msg = "single_flight::single_flight() - given timer_queue is null.";
+
+    inline const char* k_single_flight_invalid_ttl_err_msg = "single_flight::single_flight() - ttl must be positive.";
+
+    inline const char* k_single_flight_invalid_shard_count_err_msg = "single_flight::single_flight() - shard count must be positive.";
 
     /*
      * parallel-coroutine
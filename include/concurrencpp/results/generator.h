@@ -8,6 +8,8 @@ namespace concurrencpp {
     template<typename type>
     class generator {
 
+        friend class details::generator_state<type>;
+
        public:
         using promise_type = details::generator_state<type>;
         using iterator = details::generator_iterator<type>;
@@ -43,7 +45,7 @@ namespace concurrencpp {
             }
 
             assert(!m_coro_handle.done());
-            m_coro_handle.resume();
+            m_coro_handle.promise().resume();
 
             if (m_coro_handle.done()) {
                 m_coro_handle.promise().throw_if_exception();
@@ -56,6 +58,30 @@ namespace concurrencpp {
             return {};
         }
     };
+
+    /*
+     * co_yield elements_of(nested_generator) yields all the values of nested_generator from the current generator.
+     * the nested generator is resumed directly by the outermost iterator, so a value costs a single resumption
+     * however deep the nesting is. like std::ranges::elements_of, an rvalue generator is moved into the elements_of
+     * object, so it lives as long as the elements_of object does. an lvalue generator is referenced.
+     */
+    template<typename type>
+    class elements_of {
+
+       private:
+        generator<type> m_owned;
+        generator<type>* m_borrowed;
+
+       public:
+        explicit elements_of(generator<type>& generator) noexcept : m_owned(nullptr), m_borrowed(std::addressof(generator)) {}
+        explicit elements_of(generator<type>&& generator) noexcept : m_owned(std::move(generator)), m_borrowed(nullptr) {}
+
+        elements_of(elements_of&& rhs) noexcept = default;
+
+        generator<type>& get() noexcept {
+            return (m_borrowed != nullptr) ? *m_borrowed : m_owned;
+        }
+    };
 }  // namespace concurrencpp
 
 #endif
\ No newline at end of file
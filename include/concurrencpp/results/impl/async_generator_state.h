@@ -0,0 +1,120 @@
+#ifndef CONCURRENCPP_ASYNC_GENERATOR_STATE_H
+#define CONCURRENCPP_ASYNC_GENERATOR_STATE_H
+
+#include "concurrencpp/forward_declarations.h"
+#include "concurrencpp/coroutines/coroutine.h"
+
+#include <utility>
+#include <exception>
+#include <type_traits>
+
+namespace concurrencpp::details {
+    template<typename type>
+    class async_generator_state {
+
+       public:
+        using value_type = std::remove_reference_t<type>;
+
+       private:
+        value_type* m_value = nullptr;
+        std::exception_ptr m_exception;
+        coroutine_handle<void> m_consumer_handle;
+
+        // transfers control to the consumer that awaits next(), inside the thread that produced the value.
+        class consumer_resumer : public suspend_always {
+
+           private:
+            const coroutine_handle<void> m_consumer_handle;
+
+           public:
+            consumer_resumer(coroutine_handle<void> consumer_handle) noexcept : m_consumer_handle(consumer_handle) {}
+
+            coroutine_handle<void> await_suspend(coroutine_handle<void>) const noexcept {
+                assert(static_cast<bool>(m_consumer_handle));
+                return m_consumer_handle;
+            }
+        };
+
+       public:
+        async_generator<type> get_return_object() noexcept {
+            return async_generator<type> {coroutine_handle<async_generator_state<type>>::from_promise(*this)};
+        }
+
+        suspend_always initial_suspend() const noexcept {
+            return {};
+        }
+
+        consumer_resumer final_suspend() const noexcept {
+            return {m_consumer_handle};
+        }
+
+        consumer_resumer yield_value(value_type& ref) noexcept {
+            m_value = std::addressof(ref);
+            return {m_consumer_handle};
+        }
+
+        consumer_resumer yield_value(value_type&& ref) noexcept {
+            m_value = std::addressof(ref);
+            return {m_consumer_handle};
+        }
+
+        void unhandled_exception() noexcept {
+            m_exception = std::current_exception();
+        }
+
+        void return_void() const noexcept {}
+
+        void set_consumer(coroutine_handle<void> consumer_handle) noexcept {
+            m_consumer_handle = consumer_handle;
+        }
+
+        value_type& value() const noexcept {
+            assert(m_value != nullptr);
+            assert(reinterpret_cast<std::intptr_t>(m_value) % alignof(value_type) == 0);
+            return *m_value;
+        }
+
+        // the exception is thrown once, later calls to next() just report the end of the sequence.
+        void throw_if_exception() {
+            if (static_cast<bool>(m_exception)) {
+                std::rethrow_exception(std::exchange(m_exception, {}));
+            }
+        }
+    };
+
+    template<typename type>
+    class async_generator_next_awaitable {
+
+       private:
+        const coroutine_handle<async_generator_state<type>> m_coro_handle;
+
+       public:
+        using value_type = std::remove_reference_t<type>;
+
+        async_generator_next_awaitable(coroutine_handle<async_generator_state<type>> handle) noexcept : m_coro_handle(handle) {
+            assert(static_cast<bool>(m_coro_handle));
+        }
+
+        bool await_ready() const noexcept {
+            return m_coro_handle.done();
+        }
+
+        // the consumer suspends and the generator runs until it yields (or awaits something and yields later).
+        coroutine_handle<void> await_suspend(coroutine_handle<void> caller_handle) const noexcept {
+            m_coro_handle.promise().set_consumer(caller_handle);
+            return m_coro_handle;
+        }
+
+        value_type* await_resume() const {
+            auto& promise = m_coro_handle.promise();
+            if (m_coro_handle.done()) {
+                promise.throw_if_exception();
+                return nullptr;
+            }
+
+            return std::addressof(promise.value());
+        }
+    };
+}  // namespace concurrencpp::details
+
+#endif
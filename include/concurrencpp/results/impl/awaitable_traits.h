@@ -0,0 +1,35 @@
+#ifndef CONCURRENCPP_AWAITABLE_TRAITS_H
+#define CONCURRENCPP_AWAITABLE_TRAITS_H
+
+#include "concurrencpp/forward_declarations.h"
+
+#include <type_traits>
+
+namespace concurrencpp::details {
+    /*
+     * Tells apart callables that return a value from callables that return a result or a lazy_result, which are awaited
+     * for their value.
+     */
+    template<class type>
+    struct awaitable_traits {
+        using value_type = type;
+        static constexpr bool is_awaitable = false;
+    };
+
+    template<class type>
+    struct awaitable_traits<result<type>> {
+        using value_type = type;
+        static constexpr bool is_awaitable = true;
+    };
+
+    template<class type>
+    struct awaitable_traits<lazy_result<type>> {
+        using value_type = type;
+        static constexpr bool is_awaitable = true;
+    };
+
+    template<class callable_type>
+    using callable_awaitable_traits = awaitable_traits<std::decay_t<std::invoke_result_t<callable_type&>>>;
+}  // namespace concurrencpp::details
+
+#endif
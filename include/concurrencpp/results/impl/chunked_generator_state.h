@@ -0,0 +1,261 @@
+#ifndef CONCURRENCPP_CHUNKED_GENERATOR_STATE_H
+#define CONCURRENCPP_CHUNKED_GENERATOR_STATE_H
+
+#include "concurrencpp/forward_declarations.h"
+#include "concurrencpp/coroutines/coroutine.h"
+
+#include <span>
+#include <array>
+#include <utility>
+#include <exception>
+#include <type_traits>
+
+namespace concurrencpp::details {
+    /*
+     * Values yielded one by one are gathered in a fixed buffer, and the generator suspends only when the buffer is full
+     * (or when it finishes). yielded spans are handed out as they are, after the values that were buffered before them.
+     * the consumer sees a sequence of non-empty chunks, and an empty chunk marks the end of the sequence.
+     */
+    template<typename type, size_t chunk_size>
+    class chunked_generator_state {
+
+       public:
+        using value_type = type;
+        using chunk_type = std::span<const type>;
+
+       private:
+        std::array<type, chunk_size> m_buffer;
+        size_t m_size = 0;
+        chunk_type m_chunk;
+        chunk_type m_pending;  // a yielded span, waiting behind the chunk of buffered values
+        std::exception_ptr m_exception;
+
+        class yield_awaiter : public suspend_always {
+
+           private:
+            const bool m_ready;
+
+           public:
+            yield_awaiter(bool ready) noexcept : m_ready(ready) {}
+
+            bool await_ready() const noexcept {
+                return m_ready;
+            }
+        };
+
+        chunk_type buffered_chunk() const noexcept {
+            return {m_buffer.data(), m_size};
+        }
+
+        yield_awaiter on_value_buffered() noexcept {
+            if (m_size != chunk_size) {
+                return {true};
+            }
+
+            m_chunk = buffered_chunk();
+            return {false};
+        }
+
+       public:
+        chunked_generator<type, chunk_size> get_return_object() noexcept {
+            return chunked_generator<type, chunk_size> {coroutine_handle<chunked_generator_state>::from_promise(*this)};
+        }
+
+        suspend_always initial_suspend() const noexcept {
+            return {};
+        }
+
+        suspend_always final_suspend() const noexcept {
+            return {};
+        }
+
+        yield_awaiter yield_value(const type& value) {
+            m_buffer[m_size] = value;
+            ++m_size;
+            return on_value_buffered();
+        }
+
+        yield_awaiter yield_value(type&& value) {
+            m_buffer[m_size] = std::move(value);
+            ++m_size;
+            return on_value_buffered();
+        }
+
+        // the span is handed out without being copied, and must stay valid until the generator is resumed.
+        yield_awaiter yield_value(chunk_type values) noexcept {
+            if (values.empty()) {
+                return {true};
+            }
+
+            if (m_size == 0) {
+                m_chunk = values;
+            } else {
+                m_chunk = buffered_chunk();
+                m_pending = values;
+            }
+
+            return {false};
+        }
+
+        void unhandled_exception() noexcept {
+            m_exception = std::current_exception();
+        }
+
+        void return_void() const noexcept {}
+
+        chunk_type chunk() const noexcept {
+            return m_chunk;
+        }
+
+        // moves to the next chunk, resuming the generator only if no chunk is waiting. returns false at the end.
+        bool next_chunk(coroutine_handle<chunked_generator_state> handle) {
+            if (!m_pending.empty()) {
+                m_chunk = std::exchange(m_pending, {});
+                return true;
+            }
+
+            m_chunk = {};
+
+            if (handle.done()) {
+                // the values buffered before the exception were handed out already
+                if (static_cast<bool>(m_exception)) {
+                    std::rethrow_exception(std::exchange(m_exception, {}));
+                }
+
+                return false;
+            }
+
+            m_size = 0;
+            handle.resume();
+
+            if (!handle.done()) {
+                return true;
+            }
+
+            // the last values, that didn't fill the buffer
+            if (m_size != 0) {
+                m_chunk = buffered_chunk();
+                return true;
+            }
+
+            return next_chunk(handle);
+        }
+    };
+
+    struct chunked_generator_end_iterator {};
+
+    template<typename type, size_t chunk_size>
+    class chunked_generator_iterator {
+
+       private:
+        coroutine_handle<chunked_generator_state<type, chunk_size>> m_coro_handle;
+        size_t m_index = 0;
+
+       public:
+        using value_type = type;
+        using reference = const value_type&;
+        using pointer = const value_type*;
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+
+       public:
+        chunked_generator_iterator(coroutine_handle<chunked_generator_state<type, chunk_size>> handle) noexcept : m_coro_handle(handle) {
+            assert(static_cast<bool>(m_coro_handle));
+        }
+
+        chunked_generator_iterator& operator++() {
+            assert(static_cast<bool>(m_coro_handle));
+            auto& state = m_coro_handle.promise();
+
+            ++m_index;
+            if (m_index == state.chunk().size()) {
+                m_index = 0;
+                state.next_chunk(m_coro_handle);
+            }
+
+            return *this;
+        }
+
+        void operator++(int) {
+            (void)operator++();
+        }
+
+        reference operator*() const noexcept {
+            assert(static_cast<bool>(m_coro_handle));
+            return m_coro_handle.promise().chunk()[m_index];
+        }
+
+        pointer operator->() const noexcept {
+            assert(static_cast<bool>(m_coro_handle));
+            return std::addressof(operator*());
+        }
+
+        friend bool operator==(const chunked_generator_iterator& it, chunked_generator_end_iterator) noexcept {
+            return it.m_coro_handle.promise().chunk().empty();
+        }
+
+        friend bool operator==(chunked_generator_end_iterator end_it, const chunked_generator_iterator& it) noexcept {
+            return (it == end_it);
+        }
+
+        friend bool operator!=(const chunked_generator_iterator& it, chunked_generator_end_iterator end_it) noexcept {
+            return !(it == end_it);
+        }
+
+        friend bool operator!=(chunked_generator_end_iterator end_it, const chunked_generator_iterator& it) noexcept {
+            return it != end_it;
+        }
+    };
+
+    template<typename type, size_t chunk_size>
+    class chunked_generator_chunk_iterator {
+
+       private:
+        coroutine_handle<chunked_generator_state<type, chunk_size>> m_coro_handle;
+
+       public:
+        using value_type = std::span<const type>;
+        using reference = value_type;
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+
+       public:
+        chunked_generator_chunk_iterator(coroutine_handle<chunked_generator_state<type, chunk_size>> handle) noexcept :
+            m_coro_handle(handle) {
+            assert(static_cast<bool>(m_coro_handle));
+        }
+
+        chunked_generator_chunk_iterator& operator++() {
+            assert(static_cast<bool>(m_coro_handle));
+            m_coro_handle.promise().next_chunk(m_coro_handle);
+            return *this;
+        }
+
+        void operator++(int) {
+            (void)operator++();
+        }
+
+        reference operator*() const noexcept {
+            assert(static_cast<bool>(m_coro_handle));
+            return m_coro_handle.promise().chunk();
+        }
+
+        friend bool operator==(const chunked_generator_chunk_iterator& it, chunked_generator_end_iterator) noexcept {
+            return it.m_coro_handle.promise().chunk().empty();
+        }
+
+        friend bool operator==(chunked_generator_end_iterator end_it, const chunked_generator_chunk_iterator& it) noexcept {
+            return (it == end_it);
+        }
+
+        friend bool operator!=(const chunked_generator_chunk_iterator& it, chunked_generator_end_iterator end_it) noexcept {
+            return !(it == end_it);
+        }
+
+        friend bool operator!=(chunked_generator_end_iterator end_it, const chunked_generator_chunk_iterator& it) noexcept {
+            return it != end_it;
+        }
+    };
+}  // namespace concurrencpp::details
+
+#endif
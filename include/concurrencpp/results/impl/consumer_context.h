@@ -5,9 +5,11 @@
 #include "concurrencpp/results/result_fwd_declarations.h"
 
 #include <atomic>
-#include <semaphore>
+#include <cstdint>
 
 namespace concurrencpp::details {
+    class result_continuation;
+
     class CRCPP_API await_via_functor {
 
        private:
@@ -22,35 +24,52 @@ namespace concurrencpp::details {
         void operator()() noexcept;
     };
 
+    /*
+     * Lives inside the awaitable of the when_any coroutine frame. producers race on m_status, and count themselves out
+     * in m_finished_producers once they are done touching the context, so the frame can't go away under their feet.
+     */
     class CRCPP_API when_any_context {
 
        private:
         std::atomic<const result_state_base*> m_status;
+        std::atomic_int32_t m_finished_producers;  // a count, plus k_consumer_waiting once the consumer parks on it
         coroutine_handle<void> m_coro_handle;
 
         static const result_state_base* k_processing;
         static const result_state_base* k_done_processing;
+        static constexpr size_t k_spin_count = 128;
+        static constexpr std::int32_t k_consumer_waiting = std::int32_t(1) << 30;
+
+        coroutine_handle<void> try_resume_impl(result_state_base& completed_result) noexcept;
 
        public:
-        when_any_context(coroutine_handle<void> coro_handle) noexcept;
+        when_any_context() noexcept;
+
+        void set_coro_handle(coroutine_handle<void> coro_handle) noexcept;
 
         bool any_result_finished() const noexcept;
         bool finish_processing() noexcept;
         const result_state_base* completed_result() const noexcept;
 
-        void try_resume(result_state_base& completed_result) noexcept;
+        // returns the when_any coroutine if completed_result is the one that resumes it, a null handle otherwise.
+        coroutine_handle<void> try_resume(result_state_base& completed_result) noexcept;
         bool resume_inline(result_state_base& completed_result) noexcept;
+
+        // waits until producer_count producers have returned from try_resume. the producers must have published their
+        // results already: they are a few atomic operations away, so a short spin usually suffices. after it, the
+        // consumer parks until the last of them is done.
+        void wait_for_producers(size_t producer_count) noexcept;
     };
 
     class CRCPP_API consumer_context {
 
        private:
-        enum class consumer_status { idle, await, wait_for, when_any };
+        enum class consumer_status { idle, await, when_any, continuation };
 
         union storage {
             coroutine_handle<void> caller_handle;
-            std::shared_ptr<std::binary_semaphore> wait_for_ctx;
-            std::shared_ptr<when_any_context> when_any_ctx;
+            when_any_context* when_any_ctx;  // lives in the when_any coroutine frame
+            result_continuation* continuation;  // the continuation owns the result state, not the other way around
 
             storage() noexcept {}
             ~storage() noexcept {}
@@ -66,11 +85,12 @@ namespace concurrencpp::details {
         ~consumer_context() noexcept;
 
         void clear() noexcept;
-        void resume_consumer(result_state_base& self) const;
+        // returns the coroutine the producer should transfer control to, a null handle if there is none.
+        coroutine_handle<void> resume_consumer(result_state_base& self) const noexcept;
 
         void set_await_handle(coroutine_handle<void> caller_handle) noexcept;
-        void set_wait_for_context(const std::shared_ptr<std::binary_semaphore>& wait_ctx) noexcept;
-        void set_when_any_context(const std::shared_ptr<when_any_context>& when_any_ctx) noexcept;
+        void set_when_any_context(when_any_context& when_any_ctx) noexcept;
+        void set_continuation(result_continuation& continuation) noexcept;
     };
 }  // namespace concurrencpp::details
 
@@ -3,8 +3,15 @@
 
 #include "concurrencpp/forward_declarations.h"
 #include "concurrencpp/coroutines/coroutine.h"
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/errors.h"
 
 namespace concurrencpp::details {
+    /*
+     * Generators nested with co_yield elements_of(...) form a stack: every state knows the outermost (root) generator
+     * and the generator that yielded it. the root keeps the innermost running generator and the latest value, so its
+     * iterator resumes the innermost generator directly, whatever the depth is.
+     */
     template<typename type>
     class generator_state {
 
@@ -14,36 +21,104 @@ namespace concurrencpp::details {
        private:
         value_type* m_value = nullptr;
         std::exception_ptr m_exception;
+        generator_state* m_root = this;
+        coroutine_handle<generator_state> m_parent;
+        coroutine_handle<generator_state> m_active;  // meaningful in the root only
+
+        class final_awaiter : public suspend_always {
+
+           public:
+            // a nested generator that finishes hands control back to the generator that yielded it.
+            coroutine_handle<void> await_suspend(coroutine_handle<generator_state> handle) const noexcept {
+                auto& state = handle.promise();
+                if (!static_cast<bool>(state.m_parent)) {
+                    return noop_coroutine();
+                }
+
+                state.m_root->m_active = state.m_parent;
+                return state.m_parent;
+            }
+        };
+
+        class nested_awaiter : public suspend_always {
+
+           private:
+            const coroutine_handle<generator_state> m_child;
+
+           public:
+            nested_awaiter(coroutine_handle<generator_state> child) noexcept : m_child(child) {}
+
+            // an exhausted nested generator has nothing left to yield.
+            bool await_ready() const noexcept {
+                return m_child.done();
+            }
+
+            coroutine_handle<void> await_suspend(coroutine_handle<generator_state> parent_handle) const noexcept {
+                auto& child = m_child.promise();
+                child.m_parent = parent_handle;
+                child.m_root = parent_handle.promise().m_root;
+                child.m_root->m_active = m_child;
+                return m_child;
+            }
+
+            // re-throws an exception the nested generator has thrown, inside the generator that yielded it.
+            void await_resume() const {
+                m_child.promise().throw_if_exception();
+            }
+        };
 
        public:
         generator<type> get_return_object() noexcept {
-            return generator<type> {coroutine_handle<generator_state<type>>::from_promise(*this)};
+            m_active = coroutine_handle<generator_state<type>>::from_promise(*this);
+            return generator<type> {m_active};
         }
 
         suspend_always initial_suspend() const noexcept {
             return {};
         }
 
-        suspend_always final_suspend() const noexcept {
+        final_awaiter final_suspend() const noexcept {
             return {};
         }
 
         suspend_always yield_value(value_type& ref) noexcept {
-            m_value = std::addressof(ref);
+            m_root->m_value = std::addressof(ref);
             return {};
         }
 
         suspend_always yield_value(value_type&& ref) noexcept {
-            m_value = std::addressof(ref);
+            m_root->m_value = std::addressof(ref);
             return {};
         }
 
+        // nested is taken by reference: an elements_of that owns its generator has to outlive the suspension.
+        nested_awaiter yield_value(elements_of<type>& nested) {
+            auto& nested_generator = nested.get();
+            if (!static_cast<bool>(nested_generator)) {
+                throw errors::empty_generator(consts::k_empty_generator_elements_of_err_msg);
+            }
+
+            const auto child_handle = nested_generator.m_coro_handle;
+            assert(child_handle.done() || child_handle.promise().m_active == child_handle);  // not inside its own nested generator
+            return {child_handle};
+        }
+
+        nested_awaiter yield_value(elements_of<type>&& nested) {
+            return yield_value(nested);
+        }
+
         void unhandled_exception() noexcept {
             m_exception = std::current_exception();
         }
 
         void return_void() const noexcept {}
 
+        // resumes the innermost running generator, until it yields a value or the root generator finishes.
+        void resume() const {
+            assert(m_root == this);
+            m_active.resume();
+        }
+
         value_type& value() const noexcept {
             assert(m_value != nullptr);
             assert(reinterpret_cast<std::intptr_t>(m_value) % alignof(value_type) == 0);
@@ -80,7 +155,7 @@ namespace concurrencpp::details {
         generator_iterator& operator++() {
             assert(static_cast<bool>(m_coro_handle));
             assert(!m_coro_handle.done());
-            m_coro_handle.resume();
+            m_coro_handle.promise().resume();
 
             if (m_coro_handle.done()) {
                 m_coro_handle.promise().throw_if_exception();
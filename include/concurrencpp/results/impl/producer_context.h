@@ -3,11 +3,18 @@
 
 #include "concurrencpp/results/result_fwd_declarations.h"
 
+#include <utility>
 #include <exception>
+#include <cstddef>
+#include <type_traits>
 
 #include <cassert>
 
 namespace concurrencpp::details {
+    /*
+     * Unless a value is stored, the exception member is the active member of the storage (a null exception_ptr while
+     * idle). this way it's always initialized when it's read, moved or destroyed.
+     */
     template<class type>
     class producer_context {
 
@@ -15,7 +22,7 @@ namespace concurrencpp::details {
             type object;
             std::exception_ptr exception;
 
-            storage() noexcept {}
+            storage() noexcept : exception() {}
             ~storage() noexcept {}
         };
 
@@ -24,67 +31,75 @@ namespace concurrencpp::details {
         result_status m_status = result_status::idle;
 
        public:
-        ~producer_context() noexcept {
-            switch (m_status) {
-                case result_status::value: {
-                    m_storage.object.~type();
-                    break;
-                }
-
-                case result_status::exception: {
-                    m_storage.exception.~exception_ptr();
-                    break;
-                }
+        producer_context() noexcept = default;
 
-                case result_status::idle: {
-                    break;
-                }
+        producer_context(producer_context&& rhs) noexcept {
+            *this = std::move(rhs);
+        }
 
-                default: {
-                    assert(false);
-                }
+        ~producer_context() noexcept {
+            if (m_status == result_status::value) {
+                m_storage.object.~type();
+            } else {
+                m_storage.exception.~exception_ptr();
             }
         }
 
-        producer_context& operator=(producer_context&& rhs) noexcept {
-            assert(m_status == result_status::idle);
-            m_status = std::exchange(rhs.m_status, result_status::idle);
+        void clear() noexcept {
+            if (m_status == result_status::value) {
+                m_storage.object.~type();
+                new (std::addressof(m_storage.exception)) std::exception_ptr();
+            } else {
+                m_storage.exception = nullptr;
+            }
 
-            switch (m_status) {
-                case result_status::value: {
-                    new (std::addressof(m_storage.object)) type(std::move(rhs.m_storage.object));
-                    rhs.m_storage.object.~type();
-                    break;
-                }
+            m_status = result_status::idle;
+        }
 
-                case result_status::exception: {
-                    new (std::addressof(m_storage.exception)) std::exception_ptr(rhs.m_storage.exception);
-                    rhs.m_storage.exception.~exception_ptr();
-                    break;
-                }
+        producer_context& operator=(producer_context&& rhs) noexcept {
+            static_assert(std::is_nothrow_move_constructible_v<type>,
+                          "concurrencpp::details::producer_context - only no-throw-move constructible values can be moved.");
 
-                case result_status::idle: {
-                    break;
-                }
+            assert(m_status == result_status::idle);
+            const auto status = rhs.m_status;
 
-                default: {
-                    assert(false);
-                }
+            if (status != result_status::value) {
+                m_storage.exception = std::exchange(rhs.m_storage.exception, nullptr);
+                rhs.clear();
+                m_status = status;
+                return *this;
             }
 
+            m_storage.exception.~exception_ptr();
+            new (std::addressof(m_storage.object)) type(std::move(rhs.m_storage.object));
+            m_status = result_status::value;
+
+            rhs.clear();
             return *this;
         }
 
         template<class... argument_types>
-        void build_result(argument_types&&... arguments) noexcept(noexcept(type(std::forward<argument_types>(arguments)...))) {
+        void build_result(argument_types&&... arguments) noexcept(std::is_nothrow_constructible_v<type, argument_types...>) {
             assert(m_status == result_status::idle);
-            new (std::addressof(m_storage.object)) type(std::forward<argument_types>(arguments)...);
+            m_storage.exception.~exception_ptr();
+
+            if constexpr (std::is_nothrow_constructible_v<type, argument_types...>) {
+                new (std::addressof(m_storage.object)) type(std::forward<argument_types>(arguments)...);
+            } else {
+                try {
+                    new (std::addressof(m_storage.object)) type(std::forward<argument_types>(arguments)...);
+                } catch (...) {
+                    new (std::addressof(m_storage.exception)) std::exception_ptr();
+                    throw;
+                }
+            }
+
             m_status = result_status::value;
         }
 
         void build_exception(const std::exception_ptr& exception) noexcept {
             assert(m_status == result_status::idle);
-            new (std::addressof(m_storage.exception)) std::exception_ptr(exception);
+            m_storage.exception = exception;
             m_status = result_status::exception;
         }
 
@@ -111,33 +126,26 @@ namespace concurrencpp::details {
     template<>
     class producer_context<void> {
 
-        union storage {
-            std::exception_ptr exception;
-
-            storage() noexcept {}
-            ~storage() noexcept {}
-        };
-
        private:
-        storage m_storage;
+        std::exception_ptr m_exception;
         result_status m_status = result_status::idle;
 
        public:
-        ~producer_context() noexcept {
-            if (m_status == result_status::exception) {
-                m_storage.exception.~exception_ptr();
-            }
+        producer_context() noexcept = default;
+
+        producer_context(producer_context&& rhs) noexcept {
+            *this = std::move(rhs);
+        }
+
+        void clear() noexcept {
+            m_exception = nullptr;
+            m_status = result_status::idle;
         }
 
         producer_context& operator=(producer_context&& rhs) noexcept {
             assert(m_status == result_status::idle);
+            m_exception = std::exchange(rhs.m_exception, nullptr);
             m_status = std::exchange(rhs.m_status, result_status::idle);
-
-            if (m_status == result_status::exception) {
-                new (std::addressof(m_storage.exception)) std::exception_ptr(rhs.m_storage.exception);
-                rhs.m_storage.exception.~exception_ptr();
-            }
-
             return *this;
         }
 
@@ -148,7 +156,7 @@ namespace concurrencpp::details {
 
         void build_exception(const std::exception_ptr& exception) noexcept {
             assert(m_status == result_status::idle);
-            new (std::addressof(m_storage.exception)) std::exception_ptr(exception);
+            m_exception = exception;
             m_status = result_status::exception;
         }
 
@@ -163,8 +171,8 @@ namespace concurrencpp::details {
         void get_ref() const {
             assert(m_status != result_status::idle);
             if (m_status == result_status::exception) {
-                assert(static_cast<bool>(m_storage.exception));
-                std::rethrow_exception(m_storage.exception);
+                assert(static_cast<bool>(m_exception));
+                std::rethrow_exception(m_exception);
             }
         }
     };
@@ -176,7 +184,7 @@ namespace concurrencpp::details {
             type* pointer;
             std::exception_ptr exception;
 
-            storage() noexcept {}
+            storage() noexcept : exception() {}
             ~storage() noexcept {}
         };
 
@@ -185,37 +193,41 @@ namespace concurrencpp::details {
         result_status m_status = result_status::idle;
 
        public:
+        producer_context() noexcept = default;
+
+        producer_context(producer_context&& rhs) noexcept {
+            *this = std::move(rhs);
+        }
+
         ~producer_context() noexcept {
-            if (m_status == result_status::exception) {
+            if (m_status != result_status::value) {
                 m_storage.exception.~exception_ptr();
             }
         }
 
-        producer_context& operator=(producer_context&& rhs) noexcept {
-            assert(m_status == result_status::idle);
-            m_status = std::exchange(rhs.m_status, result_status::idle);
-
-            switch (m_status) {
-                case result_status::value: {
-                    m_storage.pointer = rhs.m_storage.pointer;
-                    break;
-                }
+        void clear() noexcept {
+            if (m_status == result_status::value) {
+                new (std::addressof(m_storage.exception)) std::exception_ptr();
+            } else {
+                m_storage.exception = nullptr;
+            }
 
-                case result_status::exception: {
-                    new (std::addressof(m_storage.exception)) std::exception_ptr(rhs.m_storage.exception);
-                    rhs.m_storage.exception.~exception_ptr();
-                    break;
-                }
+            m_status = result_status::idle;
+        }
 
-                case result_status::idle: {
-                    break;
-                }
+        producer_context& operator=(producer_context&& rhs) noexcept {
+            assert(m_status == result_status::idle);
+            const auto status = rhs.m_status;
 
-                default: {
-                    assert(false);
-                }
+            if (status == result_status::value) {
+                m_storage.exception.~exception_ptr();
+                m_storage.pointer = rhs.m_storage.pointer;
+            } else {
+                m_storage.exception = std::exchange(rhs.m_storage.exception, nullptr);
             }
 
+            rhs.clear();
+            m_status = status;
             return *this;
         }
 
@@ -226,13 +238,14 @@ namespace concurrencpp::details {
             assert(pointer != nullptr);
             assert(reinterpret_cast<size_t>(pointer) % alignof(type) == 0);
 
+            m_storage.exception.~exception_ptr();
             m_storage.pointer = pointer;
             m_status = result_status::value;
         }
 
         void build_exception(const std::exception_ptr& exception) noexcept {
             assert(m_status == result_status::idle);
-            new (std::addressof(m_storage.exception)) std::exception_ptr(exception);
+            m_storage.exception = exception;
             m_status = result_status::exception;
         }
 
@@ -258,6 +271,45 @@ namespace concurrencpp::details {
             std::rethrow_exception(m_storage.exception);
         }
     };
+
+    /*
+     * A result that is created ready keeps its value inline only when moving the value can't fail and the value
+     * doesn't make every result<type> bigger. other values get a shared state, like results that aren't ready.
+     */
+    inline constexpr size_t k_max_inline_ready_result_size = 64;
+
+    template<class type>
+    struct is_inline_ready_result :
+        std::bool_constant<std::is_nothrow_move_constructible_v<type> && sizeof(type) <= k_max_inline_ready_result_size> {};
+
+    template<>
+    struct is_inline_ready_result<void> : std::true_type {};
+
+    template<class type>
+    struct is_inline_ready_result<type&> : std::true_type {};
+
+    template<class type>
+    inline constexpr bool is_inline_ready_result_v = is_inline_ready_result<type>::value;
+
+    // takes the place of the inline slot for values that are never kept inline, it's always idle.
+    template<class type>
+    class no_ready_result {
+
+       public:
+        void clear() noexcept {}
+
+        result_status status() const noexcept {
+            return result_status::idle;
+        }
+
+        [[noreturn]] type get() {
+            assert(false);
+            std::terminate();
+        }
+    };
+
+    template<class type>
+    using ready_result = std::conditional_t<is_inline_ready_result_v<type>, producer_context<type>, no_ready_result<type>>;
 }  // namespace concurrencpp::details
 
 #endif
\ No newline at end of file
@@ -0,0 +1,153 @@
+#ifndef CONCURRENCPP_RESULT_CONTINUATION_H
+#define CONCURRENCPP_RESULT_CONTINUATION_H
+
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/impl/result_state.h"
+#include "concurrencpp/forward_declarations.h"
+#include "concurrencpp/errors.h"
+
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+namespace concurrencpp::details {
+    class continuation_task;
+
+    /*
+     * A callable attached to a result with result::then / result::then_inline. it is the consumer of the input result,
+     * and the producer of the result it returns. when the input is ready, the producer runs it directly (inline
+     * continuations) or posts it to an executor. a continuation is a single heap node that owns both the input state
+     * and the callable; nothing else is allocated except the output state.
+     */
+    class CRCPP_API result_continuation {
+
+        friend class continuation_task;
+
+       private:
+        std::shared_ptr<executor> m_executor;  // null for inline continuations
+
+       protected:
+        // runs the callable, publishes the output and deletes this.
+        virtual void execute() noexcept = 0;
+
+        // the executor dropped the continuation without running it: publishes a broken_task and deletes this.
+        virtual void interrupt() noexcept = 0;
+
+       public:
+        result_continuation(std::shared_ptr<executor> executor) noexcept;
+        virtual ~result_continuation() noexcept = default;
+
+        // called once the input is ready.
+        void schedule() noexcept;
+
+        static void verify_executor(const std::shared_ptr<executor>& executor);
+    };
+
+    /*
+     * The callables passed to a single then(executor, f, g, h) / then_inline(f, g, h) call are fused into one callable,
+     * so the whole chain costs a single node and a single task. separate then() calls still create a node each.
+     */
+    template<class first_type, class second_type>
+    class fused_continuation {
+
+       private:
+        first_type m_first;
+        second_type m_second;
+
+       public:
+        template<class first_arg_type, class second_arg_type>
+        fused_continuation(first_arg_type&& first, second_arg_type&& second) :
+            m_first(std::forward<first_arg_type>(first)), m_second(std::forward<second_arg_type>(second)) {}
+
+        template<class... argument_types>
+        decltype(auto) operator()(argument_types&&... arguments) {
+            if constexpr (std::is_void_v<std::invoke_result_t<first_type&, argument_types...>>) {
+                m_first(std::forward<argument_types>(arguments)...);
+                return m_second();
+            } else {
+                return m_second(m_first(std::forward<argument_types>(arguments)...));
+            }
+        }
+    };
+
+    template<class callable_type>
+    std::decay_t<callable_type> fuse_continuations(callable_type&& callable) {
+        return std::forward<callable_type>(callable);
+    }
+
+    template<class callable_type, class... callable_types>
+    auto fuse_continuations(callable_type&& callable, callable_types&&... callables) {
+        using rest_type = decltype(fuse_continuations(std::forward<callable_types>(callables)...));
+        return fused_continuation<std::decay_t<callable_type>, rest_type>(std::forward<callable_type>(callable),
+                                                                          fuse_continuations(std::forward<callable_types>(callables)...));
+    }
+
+    template<class input_type, class callable_type>
+    struct continuation_traits {
+        using output_type = std::invoke_result_t<callable_type&, input_type>;
+    };
+
+    template<class callable_type>
+    struct continuation_traits<void, callable_type> {
+        using output_type = std::invoke_result_t<callable_type&>;
+    };
+
+    template<class input_type, class callable_type>
+    class continuation_node final : public result_continuation {
+
+       public:
+        using output_type = typename continuation_traits<input_type, callable_type>::output_type;
+
+       private:
+        // declared first: if allocating the output state throws, the input result was not taken yet.
+        producer_result_state_ptr<output_type> m_output;
+        consumer_result_state_ptr<input_type> m_input;
+        callable_type m_callable;
+
+        output_type invoke(result_state<input_type>& input) {
+            if constexpr (std::is_void_v<input_type>) {
+                input.get();
+                return m_callable();
+            } else {
+                return m_callable(input.get());
+            }
+        }
+
+       protected:
+        void execute() noexcept override {
+            {
+                joined_consumer_result_state_ptr<input_type> input(m_input.release());
+                m_output->from_callable([this, &input]() -> output_type {
+                    return invoke(*input);
+                });
+            }
+
+            delete this;  // m_output publishes the output
+        }
+
+        void interrupt() noexcept override {
+            m_input.reset();
+            m_output->set_exception(std::make_exception_ptr(errors::broken_task(consts::k_broken_task_exception_error_msg)));
+            delete this;
+        }
+
+       public:
+        template<class callable_arg_type>
+        continuation_node(consumer_result_state_ptr<input_type>&& input, std::shared_ptr<executor> executor, callable_arg_type&& callable) :
+            result_continuation(std::move(executor)), m_output(new result_state<output_type>()), m_input(std::move(input)),
+            m_callable(std::forward<callable_arg_type>(callable)) {}
+
+        result<output_type> get_result() noexcept {
+            return {m_output.get()};
+        }
+
+        // hands the node over to the input state. the node may run and be deleted before this function returns.
+        void start() noexcept {
+            if (!m_input->then(*this)) {
+                schedule();
+            }
+        }
+    };
+}  // namespace concurrencpp::details
+
+#endif
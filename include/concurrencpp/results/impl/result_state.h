@@ -3,8 +3,12 @@
 
 #include "concurrencpp/results/impl/consumer_context.h"
 #include "concurrencpp/results/impl/producer_context.h"
+#include "concurrencpp/results/impl/result_state_allocator.h"
+#include "concurrencpp/threads/atomic_wait.h"
 
+#include <new>
 #include <atomic>
+#include <chrono>
 #include <type_traits>
 
 #include <cassert>
@@ -13,7 +17,7 @@ namespace concurrencpp::details {
     class CRCPP_API result_state_base {
 
        public:
-        enum class pc_state { idle, consumer_set, consumer_waiting, consumer_done, producer_done };
+        enum class pc_state { idle, consumer_set, consumer_waiting, consumer_waiting_for, consumer_done, producer_done };
 
        protected:
         std::atomic<pc_state> m_pc_state {pc_state::idle};
@@ -22,12 +26,18 @@ namespace concurrencpp::details {
 
         void assert_done() const noexcept;
 
+        // returns true if the producer is done, false on timeout.
+        bool wait_until_impl(std::chrono::steady_clock::time_point deadline);
+
        public:
         void wait();
         bool await(coroutine_handle<void> caller_handle) noexcept;
-        pc_state when_any(const std::shared_ptr<when_any_context>& when_any_state) noexcept;
+        pc_state when_any(when_any_context& when_any_state) noexcept;
+
+        // returns false if the producer is already done, in which case the continuation was not registered.
+        bool then(result_continuation& continuation) noexcept;
 
-        void try_rewind_consumer() noexcept;
+        bool try_rewind_consumer() noexcept;
     };
 
     template<class type>
@@ -58,11 +68,33 @@ namespace concurrencpp::details {
         }
 
        public:
+        // standalone states are recycled per thread. states that live inside coroutine frames are not affected.
+        static void* operator new(size_t size) {
+            if constexpr (alignof(result_state) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                return ::operator new(size, std::align_val_t(alignof(result_state)));
+            } else {
+                return result_state_allocator::allocate(size);
+            }
+        }
+
+        static void operator delete(void* pointer, size_t size) noexcept {
+            if constexpr (alignof(result_state) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                ::operator delete(pointer, size, std::align_val_t(alignof(result_state)));
+            } else {
+                result_state_allocator::deallocate(pointer, size);
+            }
+        }
+
         template<class... argument_types>
         void set_result(argument_types&&... arguments) noexcept(noexcept(type(std::forward<argument_types>(arguments)...))) {
             m_producer.build_result(std::forward<argument_types>(arguments)...);
         }
 
+        void set_ready_result(producer_context<type>&& ready) noexcept {
+            assert(ready.status() != result_status::idle);
+            m_producer = std::move(ready);
+        }
+
         void set_exception(const std::exception_ptr& error) noexcept {
             assert(error != nullptr);
             m_producer.build_exception(error);
@@ -87,47 +119,15 @@ namespace concurrencpp::details {
                 return m_producer.status();
             }
 
-            const auto wait_ctx = std::make_shared<std::binary_semaphore>(0);
-            m_consumer.set_wait_for_context(wait_ctx);
-
-            auto expected_idle_state = pc_state::idle;
-            const auto idle_0 = m_pc_state.compare_exchange_strong(expected_idle_state,
-                                                                   pc_state::consumer_set,
-                                                                   std::memory_order_acq_rel,
-                                                                   std::memory_order_acquire);
-
-            if (!idle_0) {
-                assert_done();
-                return m_producer.status();
-            }
-
-            if (wait_ctx->try_acquire_for(duration + std::chrono::milliseconds(1))) {
-                assert_done();
-                return m_producer.status();
-            }
+            const auto deadline = std::chrono::steady_clock::now() +
+                std::chrono::ceil<std::chrono::steady_clock::duration>(duration) + std::chrono::milliseconds(1);
 
-            /*
-                now we need to rewind what we've done: the producer might try to
-                access the consumer context while we rewind the consumer context back to
-                nothing. first we'll cas the status back to idle. if we failed - the
-                producer has set its result, then there's no point in continue rewinding
-                - we just return the status of the result. if we managed to rewind the
-                status back to idle, then the consumer is "protected" because the
-                producer will not try to access the consumer if the flag doesn't say so.
-            */
-            auto expected_consumer_state = pc_state::consumer_set;
-            const auto idle_1 = m_pc_state.compare_exchange_strong(expected_consumer_state,
-                                                                   pc_state::idle,
-                                                                   std::memory_order_acq_rel,
-                                                                   std::memory_order_acquire);
-
-            if (!idle_1) {
-                assert_done();
-                return m_producer.status();
+            if (!wait_until_impl(deadline)) {
+                return result_status::idle;
             }
 
-            m_consumer.clear();
-            return result_status::idle;
+            assert_done();
+            return m_producer.status();
         }
 
         template<class clock, class duration>
@@ -157,7 +157,11 @@ namespace concurrencpp::details {
             }
         }
 
-        void complete_producer(coroutine_handle<void> done_handle = {}) {
+        /*
+         * Publishes the result. returns the consumer coroutine that should run next instead of resuming it, so a
+         * producer coroutine can transfer control to it from its final suspension point without growing the stack.
+         */
+        coroutine_handle<void> publish_result(coroutine_handle<void> done_handle) noexcept {
             m_done_handle = done_handle;
 
             const auto state_before = this->m_pc_state.exchange(pc_state::producer_done, std::memory_order_acq_rel);
@@ -169,15 +173,22 @@ namespace concurrencpp::details {
                 }
 
                 case pc_state::idle: {
-                    return;
+                    return {};
                 }
 
                 case pc_state::consumer_waiting: {
-                    return m_pc_state.notify_one();
+                    m_pc_state.notify_one();
+                    return {};
+                }
+
+                case pc_state::consumer_waiting_for: {
+                    details::atomic_notify_one(&this->m_pc_state);  // not std::atomic_notify_one, found by adl
+                    return {};
                 }
 
                 case pc_state::consumer_done: {
-                    return delete_self(this);
+                    delete_self(this);
+                    return {};
                 }
 
                 default: {
@@ -186,6 +197,14 @@ namespace concurrencpp::details {
             }
 
             assert(false);
+            return {};
+        }
+
+        void complete_producer(coroutine_handle<void> done_handle = {}) {
+            const auto consumer_handle = publish_result(done_handle);
+            if (static_cast<bool>(consumer_handle)) {
+                consumer_handle();
+            }
         }
 
         void complete_consumer() noexcept {
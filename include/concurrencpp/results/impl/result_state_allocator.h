@@ -0,0 +1,24 @@
+#ifndef CONCURRENCPP_RESULT_STATE_ALLOCATOR_H
+#define CONCURRENCPP_RESULT_STATE_ALLOCATOR_H
+
+#include "concurrencpp/platform_defs.h"
+
+#include <cstddef>
+
+namespace concurrencpp::details {
+    /*
+     * Recycles the memory of standalone result states (the ones created by result_promise, result::then and friends).
+     * every thread keeps a small cache of freed blocks per size class, so a state that is allocated and freed on a hot path
+     * usually costs a few pointer moves instead of a malloc / free pair. a block may be freed by a different thread than
+     * the one that allocated it, it simply moves to the freeing thread's cache. blocks that are too large, or that don't fit
+     * in a full cache, go to the global heap.
+     */
+    class CRCPP_API result_state_allocator {
+
+       public:
+        static void* allocate(size_t size);
+        static void deallocate(void* pointer, size_t size) noexcept;
+    };
+}  // namespace concurrencpp::details
+
+#endif
@@ -5,37 +5,115 @@
 #include "concurrencpp/forward_declarations.h"
 #include "concurrencpp/results/impl/producer_context.h"
 #include "concurrencpp/results/impl/return_value_struct.h"
+#include "concurrencpp/threads/atomic_wait.h"
 
 #include <atomic>
 #include <mutex>
-#include <optional>
-#include <condition_variable>
+#include <memory>
+#include <chrono>
+#include <utility>
 
 #include <cassert>
 
 namespace concurrencpp::details {
     struct shared_await_context {
         shared_await_context* next = nullptr;
-        coroutine_handle<void> caller_handle;
+        coroutine_handle<void> caller_handle;  // null if a blocked thread waits on this context
+        bool removable = false;                // the awaiter may unlink itself before the result is ready
+    };
+
+    struct shared_blocking_await_context : public shared_await_context {
+        std::atomic_int32_t ready {0};  // the blocked thread parks on it with atomic_wait
+
+        void wait() noexcept {
+            atomic_wait(ready, std::int32_t(0));
+        }
+
+        bool wait_until(std::chrono::steady_clock::time_point deadline) noexcept {
+            while (ready.load(std::memory_order_acquire) == 0) {
+                if (!atomic_wait_until(ready, std::int32_t(0), deadline)) {
+                    return ready.load(std::memory_order_acquire) != 0;
+                }
+            }
+
+            return true;
+        }
+
+        void release() noexcept {
+            ready.store(1, std::memory_order_release);
+            details::atomic_notify_one(&ready);  // the context may be gone already, see atomic_wait.h
+        }
+    };
+
+    /*
+     * Resumes an awaiter of a ready shared_result inside an executor. the result is ready either way, so if the executor
+     * drops the task without running it, the coroutine is resumed inline by whoever destroys it.
+     */
+    class CRCPP_API shared_awaiter_resumer {
+
+       private:
+        coroutine_handle<void> m_caller_handle;
+
+       public:
+        explicit shared_awaiter_resumer(coroutine_handle<void> caller_handle) noexcept : m_caller_handle(caller_handle) {}
+
+        shared_awaiter_resumer(shared_awaiter_resumer&& rhs) noexcept : m_caller_handle(std::exchange(rhs.m_caller_handle, {})) {}
+
+        ~shared_awaiter_resumer() noexcept {
+            if (static_cast<bool>(m_caller_handle)) {
+                m_caller_handle();
+            }
+        }
+
+        void operator()() noexcept {
+            std::exchange(m_caller_handle, {})();
+        }
     };
 }  // namespace concurrencpp::details
 
 namespace concurrencpp::details {
+    /*
+     * Awaiters (coroutines and blocked threads alike) are pushed onto a lock-free intrusive stack, and the producer takes
+     * the whole stack with a single exchange that also marks the state as ready. the only lock is taken by awaiters that
+     * give up waiting (timeouts): unlinking a node from the middle of the stack is serialized with other removals and with
+     * the producer walking the list it took, and the producer takes it only while such an awaiter is still pushed.
+     */
     class CRCPP_API shared_result_state_base {
 
        protected:
-        std::atomic_bool m_ready {false};
-        mutable std::mutex m_lock;
-        shared_await_context* m_awaiters = nullptr;
-        std::optional<std::condition_variable> m_condition;
+        // nullptr - not ready, no awaiters. ready_marker() - ready. anything else - the top of the awaiter stack.
+        std::atomic<shared_await_context*> m_awaiters {nullptr};
+        std::atomic_size_t m_removable_awaiters {0};  // pushed removable awaiters that were neither removed nor taken
+        std::mutex m_remove_lock;
+
+        // if set, awaiting coroutines are resumed inside m_resume_executor, all but the first m_inline_resumptions.
+        std::shared_ptr<executor> m_resume_executor;
+        size_t m_inline_resumptions = 0;
+
+        shared_await_context* ready_marker() const noexcept {
+            // the state itself is never an awaiter, its address can't collide with a pushed node.
+            return reinterpret_cast<shared_await_context*>(const_cast<shared_result_state_base*>(this));
+        }
+
+        bool is_ready() const noexcept {
+            return m_awaiters.load(std::memory_order_acquire) == ready_marker();
+        }
+
+        bool push_awaiter(shared_await_context& awaiter) noexcept;
+        bool push_removable_awaiter(shared_await_context& awaiter) noexcept;
+        bool wait_for_impl(std::chrono::milliseconds ms);
 
-        void await_impl(std::unique_lock<std::mutex>& lock, shared_await_context& awaiter) noexcept;
-        void wait_impl(std::unique_lock<std::mutex>& lock);
-        bool wait_for_impl(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds ms);
+        void resume_inline(shared_await_context* awaiters) noexcept;
+        void resume_fanned_out(shared_await_context* awaiters) noexcept;
 
        public:
+        // must be called before the state is shared with any awaiter.
+        void set_resume_executor(std::shared_ptr<executor> resume_executor, size_t inline_resumptions) noexcept;
+
         void complete_producer();
-        bool await(shared_await_context& awaiter);
+        bool await(shared_await_context& awaiter) noexcept;
+        bool await_removable(shared_await_context& awaiter) noexcept;
+        bool remove_awaiter(shared_await_context& awaiter) noexcept;
         void wait();
     };
 
@@ -46,13 +124,13 @@ namespace concurrencpp::details {
         producer_context<type> m_producer;
 
         void assert_done() const noexcept {
-            assert(m_ready.load(std::memory_order_acquire));
+            assert(is_ready());
             assert(m_producer.status() != result_status::idle);
         }
 
        public:
         result_status status() const noexcept {
-            if (!m_ready.load(std::memory_order_acquire)) {
+            if (!is_ready()) {
                 return result_status::idle;
             }
 
@@ -61,25 +139,17 @@ namespace concurrencpp::details {
 
         template<class duration_unit, class ratio>
         result_status wait_for(std::chrono::duration<duration_unit, ratio> duration) {
-            if (m_ready.load(std::memory_order_acquire)) {
+            if (is_ready()) {
                 return m_producer.status();
             }
 
             const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration) + std::chrono::milliseconds(1);
-
-            std::unique_lock<std::mutex> lock(m_lock);
-            if (m_ready.load(std::memory_order_acquire)) {
-                return m_producer.status();
-            }
-
-            const auto ready = wait_for_impl(lock, ms);
-            if (ready) {
-                assert_done();
-                return m_producer.status();
+            if (!wait_for_impl(ms)) {
+                return result_status::idle;
             }
 
-            lock.unlock();
-            return result_status::idle;
+            assert_done();
+            return m_producer.status();
         }
 
         template<class clock, class duration>
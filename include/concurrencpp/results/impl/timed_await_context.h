@@ -0,0 +1,73 @@
+#ifndef CONCURRENCPP_TIMED_AWAIT_CONTEXT_H
+#define CONCURRENCPP_TIMED_AWAIT_CONTEXT_H
+
+#include "concurrencpp/timers/timer.h"
+#include "concurrencpp/coroutines/coroutine.h"
+#include "concurrencpp/forward_declarations.h"
+
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+
+namespace concurrencpp::details {
+    /*
+     * A timeout that races a producer for the right to resume an awaiting coroutine.
+     * The timer node lives inside the awaitable (and hence inside the coroutine frame) and is linked directly into the
+     * timer_queue. When the deadline is reached, the timer thread calls try_cancel_wait: if it manages to detach the
+     * consumer from the awaited state, the coroutine is resumed inside the timeout executor. otherwise the producer got
+     * there first and the timer does nothing. Either way, the awaiting coroutine disarms the timer before it continues.
+     */
+    class CRCPP_API timed_await_context : public timer_node {
+
+        // waiting - the awaiting coroutine is parked in disarm until the status leaves pending.
+        enum class registration_status : std::int32_t { pending, waiting, registered, skipped };
+
+        // waiting - the awaiting coroutine is parked in disarm until the timer thread is done with the node.
+        enum class timer_status : std::int32_t { running, waiting, done };
+
+        static constexpr size_t k_spin_count = 128;
+
+       private:
+        const std::shared_ptr<timer_queue> m_timer_queue;
+        std::shared_ptr<executor> m_timeout_executor;
+        coroutine_handle<void> m_caller_handle;
+        std::atomic<registration_status> m_registration {registration_status::pending};
+        std::atomic<timer_status> m_timer_status {timer_status::running};
+        bool m_interrupted = false;
+
+        static time_point make_deadline(const std::shared_ptr<timer_queue>& timer_queue, std::chrono::milliseconds timeout);
+
+        void publish_registration(registration_status status) noexcept;
+        void publish_timer_done() noexcept;
+
+       protected:
+        ~timed_await_context() noexcept = default;
+
+        // called by the timer thread. returns true if the awaiting coroutine was detached from the awaited state.
+        virtual bool try_cancel_wait() noexcept = 0;
+
+        void set_caller_handle(coroutine_handle<void> caller_handle) noexcept;
+
+        // must be called right after the consumer was registered in the awaited state, and must be the last thing
+        // await_suspend does. consumer_set tells whether the consumer was registered (and the coroutine may suspend).
+        bool arm(bool consumer_set) noexcept;
+
+        // must be called by await_resume before anything else. throws errors::broken_task if the timer was interrupted.
+        void disarm();
+
+       public:
+        static void verify_params(const std::shared_ptr<timer_queue>& timer_queue, const std::shared_ptr<executor>& timeout_executor);
+
+        timed_await_context(std::shared_ptr<timer_queue> timer_queue,
+                            std::chrono::milliseconds timeout,
+                            std::shared_ptr<executor> timeout_executor);
+
+        timed_await_context(std::shared_ptr<timer_queue> timer_queue, time_point deadline, std::shared_ptr<executor> timeout_executor) noexcept;
+
+        void fire(task_batch& batch) noexcept override;
+        void interrupt() noexcept override;
+    };
+}  // namespace concurrencpp::details
+
+#endif
@@ -73,6 +73,22 @@ namespace concurrencpp {
             throw_if_empty(details::consts::k_empty_lazy_result_run_err_msg);
             return run_impl();
         }
+
+        auto resolve_for(std::shared_ptr<timer_queue> timer_queue,
+                         std::chrono::milliseconds timeout,
+                         std::shared_ptr<executor> timeout_executor) {
+            throw_if_empty(details::consts::k_empty_lazy_result_resolve_for_err_msg);
+            details::timed_await_context::verify_params(timer_queue, timeout_executor);
+            return run_impl().resolve_for(std::move(timer_queue), timeout, std::move(timeout_executor));
+        }
+
+        auto resolve_until(std::shared_ptr<timer_queue> timer_queue,
+                           details::timer_node::time_point deadline,
+                           std::shared_ptr<executor> timeout_executor) {
+            throw_if_empty(details::consts::k_empty_lazy_result_resolve_until_err_msg);
+            details::timed_await_context::verify_params(timer_queue, timeout_executor);
+            return run_impl().resolve_until(std::move(timer_queue), deadline, std::move(timeout_executor));
+        }
     };
 }  // namespace concurrencpp
 
@@ -12,13 +12,10 @@ namespace concurrencpp {
         static_assert(std::is_same_v<type, void> ? (sizeof...(argument_types) == 0) : true,
                       "concurrencpp::make_ready_result<void> - this overload does not accept any argument.");
 
-        details::producer_result_state_ptr<type> promise(new details::result_state<type>());
-        details::consumer_result_state_ptr<type> state_ptr(promise.get());
-
-        promise->set_result(std::forward<argument_types>(arguments)...);
-        promise.reset();  // publish the result;
-
-        return {std::move(state_ptr)};
+        // small values are stored inside the result itself, nothing is allocated.
+        details::producer_context<type> ready;
+        ready.build_result(std::forward<argument_types>(arguments)...);
+        return result<type>(std::move(ready));
     }
 
     template<class type>
@@ -27,13 +24,9 @@ namespace concurrencpp {
             throw std::invalid_argument(details::consts::k_make_exceptional_result_exception_null_error_msg);
         }
 
-        details::producer_result_state_ptr<type> promise(new details::result_state<type>());
-        details::consumer_result_state_ptr<type> state_ptr(promise.get());
-
-        promise->set_exception(exception_ptr);
-        promise.reset();  // publish the result;
-
-        return {std::move(state_ptr)};
+        details::producer_context<type> ready;
+        ready.build_exception(exception_ptr);
+        return result<type>(std::move(ready));
     }
 
     template<class type, class exception_type>
@@ -0,0 +1,132 @@
+#ifndef CONCURRENCPP_PARALLEL_MAP_H
+#define CONCURRENCPP_PARALLEL_MAP_H
+
+#include "concurrencpp/results/result.h"
+#include "concurrencpp/results/generator.h"
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/executors/executor.h"
+#include "concurrencpp/errors.h"
+
+#include <deque>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+namespace concurrencpp::details {
+    template<class type, class callable_type>
+    struct parallel_map_traits {
+        using input_type = std::remove_cvref_t<type>;
+        // a value generator owns the yielded value only until it's resumed, so the value is moved out of it.
+        // referenced values belong to someone else and are copied.
+        using input_reference = std::conditional_t<std::is_reference_v<type>, const input_type&, input_type&&>;
+        using output_type = std::remove_cvref_t<std::invoke_result_t<callable_type&, input_type&&>>;
+    };
+
+    template<class type, class callable_type>
+    std::vector<typename parallel_map_traits<type, callable_type>::output_type> parallel_map_chunk(
+        callable_type& callable,
+        std::vector<typename parallel_map_traits<type, callable_type>::input_type>& chunk) {
+        std::vector<typename parallel_map_traits<type, callable_type>::output_type> outputs;
+        outputs.reserve(chunk.size());
+
+        for (auto& input : chunk) {
+            outputs.emplace_back(callable(std::move(input)));
+        }
+
+        return outputs;
+    }
+
+    template<class executor_type, class type, class callable_type>
+    generator<typename parallel_map_traits<type, callable_type>::output_type> parallel_map_impl(std::shared_ptr<executor_type> executor,
+                                                                                               generator<type> input,
+                                                                                               std::shared_ptr<callable_type> callable,
+                                                                                               size_t window,
+                                                                                               size_t chunk_size) {
+        using traits = parallel_map_traits<type, callable_type>;
+        using chunk_type = std::vector<typename traits::input_type>;
+        using output_chunk_type = std::vector<typename traits::output_type>;
+
+        std::deque<result<output_chunk_type>> in_flight;
+        auto it = input.begin();
+
+        while (true) {
+            while (in_flight.size() < window && it != input.end()) {
+                chunk_type chunk;
+                chunk.reserve(chunk_size);
+
+                for (; chunk.size() < chunk_size && it != input.end(); ++it) {
+                    chunk.emplace_back(static_cast<typename traits::input_reference>(*it));
+                }
+
+                // the tasks own the callable, so a generator that is destroyed early doesn't pull it from under them.
+                in_flight.emplace_back(executor->submit([callable, chunk = std::move(chunk)]() mutable {
+                    return parallel_map_chunk<type>(*callable, chunk);
+                }));
+            }
+
+            if (in_flight.empty()) {
+                co_return;
+            }
+
+            auto outputs = in_flight.front().get();
+            in_flight.pop_front();
+
+            for (auto& output : outputs) {
+                co_yield output;
+            }
+        }
+    }
+}  // namespace concurrencpp::details
+
+namespace concurrencpp {
+    /*
+     * Applies callable to every value of input on executor, and yields the outputs in input order. values are pulled
+     * from input in chunks of chunk_size, and at most window chunks are processed at a time: the input is consumed
+     * only as fast as the outputs are, and is never materialized as a whole. callable may be invoked concurrently.
+     */
+    template<class executor_type, class type, class callable_type>
+    generator<typename details::parallel_map_traits<type, std::decay_t<callable_type>>::output_type> parallel_map(
+        std::shared_ptr<executor_type> executor,
+        generator<type> input,
+        callable_type&& callable,
+        size_t window,
+        size_t chunk_size = 64) {
+        static_assert(std::is_base_of_v<concurrencpp::executor, executor_type>,
+                      "concurrencpp::parallel_map() - given executor does not derive from concurrencpp::executor");
+
+        using decayed_type = std::decay_t<callable_type>;
+        static_assert(std::is_constructible_v<typename details::parallel_map_traits<type, decayed_type>::input_type,
+                                              typename details::parallel_map_traits<type, decayed_type>::input_reference>,
+                      "concurrencpp::parallel_map() - the values of <<input>> can't be moved or copied");
+        static_assert(std::is_invocable_v<decayed_type&, typename details::parallel_map_traits<type, decayed_type>::input_type&&>,
+                      "concurrencpp::parallel_map() - <<callable_type>> is not invokable with the values of <<input>>");
+        static_assert(!std::is_void_v<typename details::parallel_map_traits<type, decayed_type>::output_type>,
+                      "concurrencpp::parallel_map() - <<callable_type>> must not return void");
+
+        if (!static_cast<bool>(executor)) {
+            throw std::invalid_argument(details::consts::k_parallel_map_null_executor_err_msg);
+        }
+
+        if (!static_cast<bool>(input)) {
+            throw errors::empty_generator(details::consts::k_parallel_map_empty_generator_err_msg);
+        }
+
+        if (window == 0) {
+            throw std::invalid_argument(details::consts::k_parallel_map_zero_window_err_msg);
+        }
+
+        if (chunk_size == 0) {
+            throw std::invalid_argument(details::consts::k_parallel_map_zero_chunk_size_err_msg);
+        }
+
+        return details::parallel_map_impl(std::move(executor),
+                                          std::move(input),
+                                          std::make_shared<decayed_type>(std::forward<callable_type>(callable)),
+                                          window,
+                                          chunk_size);
+    }
+}  // namespace concurrencpp
+
+#endif
@@ -6,6 +6,7 @@
 #include "concurrencpp/results/constants.h"
 #include "concurrencpp/results/result_awaitable.h"
 #include "concurrencpp/results/impl/result_state.h"
+#include "concurrencpp/results/impl/result_continuation.h"
 
 #include <type_traits>
 
@@ -22,23 +23,65 @@ namespace concurrencpp {
 
        private:
         details::consumer_result_state_ptr<type> m_state;
+        details::ready_result<type> m_ready;  // results that are created ready keep small values inline, without a state
+
+        bool is_ready_inline() const noexcept {
+            return m_ready.status() != result_status::idle;
+        }
 
         void throw_if_empty(const char* message) const {
-            if (static_cast<bool>(!m_state)) {
+            if (!static_cast<bool>(*this)) {
                 throw errors::empty_result(message);
             }
         }
 
+        // for the operations that need a shared state to synchronize on.
+        void ensure_state() {
+            if constexpr (details::is_inline_ready_result_v<type>) {
+                if (is_ready_inline()) {
+                    m_state = make_ready_state(std::move(m_ready));
+                }
+            }
+        }
+
+        static details::consumer_result_state_ptr<type> make_ready_state(details::producer_context<type>&& ready) {
+            details::producer_result_state_ptr<type> promise(new details::result_state<type>());
+            details::consumer_result_state_ptr<type> state(promise.get());
+            promise->set_ready_result(std::move(ready));
+            return state;
+        }
+
+        template<class callable_type>
+        auto then_impl(std::shared_ptr<executor> executor, callable_type&& callable) {
+            using node_type = details::continuation_node<type, std::decay_t<callable_type>>;
+
+            ensure_state();
+
+            auto node = std::make_unique<node_type>(std::move(m_state), std::move(executor), std::forward<callable_type>(callable));
+            auto output = node->get_result();
+            node.release()->start();
+            return output;
+        }
+
        public:
         result() noexcept = default;
         result(result&& rhs) noexcept = default;
 
         result(details::consumer_result_state_ptr<type> state) noexcept : m_state(std::move(state)) {}
         result(details::result_state<type>* state) noexcept : m_state(state) {}
+        result(details::producer_context<type>&& ready) noexcept(details::is_inline_ready_result_v<type>) {
+            if constexpr (details::is_inline_ready_result_v<type>) {
+                m_ready = std::move(ready);
+            } else {
+                m_state = make_ready_state(std::move(ready));
+            }
+        }
 
         result& operator=(result&& rhs) noexcept {
             if (this != &rhs) {
                 m_state = std::move(rhs.m_state);
+                m_ready.clear();
+                m_ready = std::move(rhs.m_ready);
             }
 
             return *this;
@@ -48,33 +91,54 @@ namespace concurrencpp {
         result& operator=(const result& rhs) = delete;
 
         explicit operator bool() const noexcept {
-            return static_cast<bool>(m_state);
+            return static_cast<bool>(m_state) || is_ready_inline();
         }
 
         result_status status() const {
             throw_if_empty(details::consts::k_result_status_error_msg);
+            if (is_ready_inline()) {
+                return m_ready.status();
+            }
+
             return m_state->status();
         }
 
         void wait() const {
             throw_if_empty(details::consts::k_result_wait_error_msg);
+            if (is_ready_inline()) {
+                return;
+            }
+
             m_state->wait();
         }
 
         template<class duration_type, class ratio_type>
         result_status wait_for(std::chrono::duration<duration_type, ratio_type> duration) const {
             throw_if_empty(details::consts::k_result_wait_for_error_msg);
+            if (is_ready_inline()) {
+                return m_ready.status();
+            }
+
             return m_state->wait_for(duration);
         }
 
         template<class clock_type, class duration_type>
         result_status wait_until(std::chrono::time_point<clock_type, duration_type> timeout_time) const {
             throw_if_empty(details::consts::k_result_wait_until_error_msg);
+            if (is_ready_inline()) {
+                return m_ready.status();
+            }
+
             return m_state->wait_until(timeout_time);
         }
 
         type get() {
             throw_if_empty(details::consts::k_result_get_error_msg);
+            if (is_ready_inline()) {
+                details::ready_result<type> ready(std::move(m_ready));
+                return ready.get();
+            }
+
             m_state->wait();
 
             details::joined_consumer_result_state_ptr<type> state(m_state.release());
@@ -83,12 +147,44 @@ namespace concurrencpp {
 
         auto operator co_await() {
             throw_if_empty(details::consts::k_result_operator_co_await_error_msg);
-            return awaitable<type> {std::move(m_state)};
+            return awaitable<type> {std::move(m_state), std::move(m_ready)};
         }
 
         auto resolve() {
             throw_if_empty(details::consts::k_result_resolve_error_msg);
-            return resolve_awaitable<type> {std::move(m_state)};
+            return resolve_awaitable<type> {std::move(m_state), std::move(m_ready)};
+        }
+
+        auto resolve_for(std::shared_ptr<timer_queue> timer_queue,
+                         std::chrono::milliseconds timeout,
+                         std::shared_ptr<executor> timeout_executor) {
+            throw_if_empty(details::consts::k_result_resolve_for_error_msg);
+            details::timed_await_context::verify_params(timer_queue, timeout_executor);
+            ensure_state();
+            return timed_resolve_awaitable<type> {std::move(m_state), std::move(timer_queue), timeout, std::move(timeout_executor)};
+        }
+
+        auto resolve_until(std::shared_ptr<timer_queue> timer_queue,
+                           details::timer_node::time_point deadline,
+                           std::shared_ptr<executor> timeout_executor) {
+            throw_if_empty(details::consts::k_result_resolve_until_error_msg);
+            details::timed_await_context::verify_params(timer_queue, timeout_executor);
+            ensure_state();
+            return timed_resolve_awaitable<type> {std::move(m_state), std::move(timer_queue), deadline, std::move(timeout_executor)};
+        }
+
+        template<class callable_type, class... callable_types>
+        auto then(std::shared_ptr<executor> executor, callable_type&& callable, callable_types&&... callables) {
+            throw_if_empty(details::consts::k_result_then_error_msg);
+            details::result_continuation::verify_executor(executor);
+            return then_impl(std::move(executor),
+                             details::fuse_continuations(std::forward<callable_type>(callable), std::forward<callable_types>(callables)...));
+        }
+
+        template<class callable_type, class... callable_types>
+        auto then_inline(callable_type&& callable, callable_types&&... callables) {
+            throw_if_empty(details::consts::k_result_then_inline_error_msg);
+            return then_impl({}, details::fuse_continuations(std::forward<callable_type>(callable), std::forward<callable_types>(callables)...));
         }
     };
 }  // namespace concurrencpp
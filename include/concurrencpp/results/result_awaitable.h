@@ -3,15 +3,19 @@
 
 #include "concurrencpp/coroutines/coroutine.h"
 #include "concurrencpp/results/impl/result_state.h"
+#include "concurrencpp/results/impl/timed_await_context.h"
 
 namespace concurrencpp::details {
     template<class type>
     class awaitable_base : public suspend_always {
        protected:
         consumer_result_state_ptr<type> m_state;
+        ready_result<type> m_ready;  // a result that was ready inline has no state, nothing to suspend on
 
        public:
         awaitable_base(consumer_result_state_ptr<type> state) noexcept : m_state(std::move(state)) {}
+        awaitable_base(consumer_result_state_ptr<type> state, ready_result<type>&& ready) noexcept :
+            m_state(std::move(state)), m_ready(std::move(ready)) {}
 
         awaitable_base(const awaitable_base&) = delete;
         awaitable_base(awaitable_base&&) = delete;
@@ -23,7 +27,12 @@ namespace concurrencpp {
     class awaitable : public details::awaitable_base<type> {
 
        public:
-        awaitable(details::consumer_result_state_ptr<type> state) noexcept : details::awaitable_base<type>(std::move(state)) {}
+        awaitable(details::consumer_result_state_ptr<type> state, details::ready_result<type>&& ready) noexcept :
+            details::awaitable_base<type>(std::move(state), std::move(ready)) {}
+
+        bool await_ready() const noexcept {
+            return !static_cast<bool>(this->m_state);
+        }
 
         bool await_suspend(details::coroutine_handle<void> caller_handle) noexcept {
             assert(static_cast<bool>(this->m_state));
@@ -31,6 +40,10 @@ namespace concurrencpp {
         }
 
         type await_resume() {
+            if (!static_cast<bool>(this->m_state)) {
+                return this->m_ready.get();
+            }
+
             details::joined_consumer_result_state_ptr<type> state(this->m_state.release());
             return state->get();
         }
@@ -40,17 +53,63 @@ namespace concurrencpp {
     class resolve_awaitable : public details::awaitable_base<type> {
 
        public:
-        resolve_awaitable(details::consumer_result_state_ptr<type> state) noexcept : details::awaitable_base<type>(std::move(state)) {}
+        resolve_awaitable(details::consumer_result_state_ptr<type> state, details::ready_result<type>&& ready) noexcept :
+            details::awaitable_base<type>(std::move(state), std::move(ready)) {}
 
         resolve_awaitable(resolve_awaitable&&) noexcept = delete;
         resolve_awaitable(const resolve_awaitable&) noexcept = delete;
 
+        bool await_ready() const noexcept {
+            return !static_cast<bool>(this->m_state);
+        }
+
         bool await_suspend(details::coroutine_handle<void> caller_handle) noexcept {
             assert(static_cast<bool>(this->m_state));
             return this->m_state->await(caller_handle);
         }
 
         result<type> await_resume() {
+            if constexpr (details::is_inline_ready_result_v<type>) {
+                if (!static_cast<bool>(this->m_state)) {
+                    return result<type>(std::move(this->m_ready));
+                }
+            }
+
+            return result<type>(std::move(this->m_state));
+        }
+    };
+
+    template<class type>
+    class timed_resolve_awaitable : public details::awaitable_base<type>, private details::timed_await_context {
+
+       private:
+        bool try_cancel_wait() noexcept override {
+            return this->m_state->try_rewind_consumer();
+        }
+
+       public:
+        timed_resolve_awaitable(details::consumer_result_state_ptr<type> state,
+                                std::shared_ptr<timer_queue> timer_queue,
+                                std::chrono::milliseconds timeout,
+                                std::shared_ptr<executor> timeout_executor) :
+            details::awaitable_base<type>(std::move(state)),
+            details::timed_await_context(std::move(timer_queue), timeout, std::move(timeout_executor)) {}
+
+        timed_resolve_awaitable(details::consumer_result_state_ptr<type> state,
+                                std::shared_ptr<timer_queue> timer_queue,
+                                time_point deadline,
+                                std::shared_ptr<executor> timeout_executor) noexcept :
+            details::awaitable_base<type>(std::move(state)),
+            details::timed_await_context(std::move(timer_queue), deadline, std::move(timeout_executor)) {}
+
+        bool await_suspend(details::coroutine_handle<void> caller_handle) noexcept {
+            assert(static_cast<bool>(this->m_state));
+            this->set_caller_handle(caller_handle);
+            return this->arm(this->m_state->await(caller_handle));
+        }
+
+        result<type> await_resume() {
+            this->disarm();
             return result<type>(std::move(this->m_state));
         }
     };
@@ -5,6 +5,8 @@
 #include "concurrencpp/results/shared_result_awaitable.h"
 #include "concurrencpp/results/impl/shared_result_state.h"
 
+#include <stdexcept>
+
 namespace concurrencpp {
     template<class type>
     class shared_result {
@@ -36,6 +38,21 @@ namespace concurrencpp {
             *this = make_shared_result({}, std::move(rhs));
         }
 
+        shared_result(result<type> rhs, std::shared_ptr<executor> resume_executor, size_t inline_resumptions = 0) {
+            if (!static_cast<bool>(resume_executor)) {
+                throw std::invalid_argument(details::consts::k_shared_result_null_resume_executor_error_msg);
+            }
+
+            if (!static_cast<bool>(rhs)) {
+                return;
+            }
+
+            *this = make_shared_result({}, std::move(rhs));
+
+            // no coroutine could have awaited the state yet.
+            m_state->set_resume_executor(std::move(resume_executor), inline_resumptions);
+        }
+
         shared_result(const shared_result& rhs) noexcept = default;
         shared_result(shared_result&& rhs) noexcept = default;
 
@@ -96,6 +113,22 @@ namespace concurrencpp {
             throw_if_empty(details::consts::k_shared_result_resolve_error_msg);
             return shared_resolve_awaitable<type> {m_state};
         }
+
+        auto resolve_for(std::shared_ptr<timer_queue> timer_queue,
+                         std::chrono::milliseconds timeout,
+                         std::shared_ptr<executor> timeout_executor) {
+            throw_if_empty(details::consts::k_shared_result_resolve_for_error_msg);
+            details::timed_await_context::verify_params(timer_queue, timeout_executor);
+            return timed_shared_resolve_awaitable<type> {m_state, std::move(timer_queue), timeout, std::move(timeout_executor)};
+        }
+
+        auto resolve_until(std::shared_ptr<timer_queue> timer_queue,
+                           details::timer_node::time_point deadline,
+                           std::shared_ptr<executor> timeout_executor) {
+            throw_if_empty(details::consts::k_shared_result_resolve_until_error_msg);
+            details::timed_await_context::verify_params(timer_queue, timeout_executor);
+            return timed_shared_resolve_awaitable<type> {m_state, std::move(timer_queue), deadline, std::move(timeout_executor)};
+        }
     };
 }  // namespace concurrencpp
 
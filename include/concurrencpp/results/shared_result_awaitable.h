@@ -2,6 +2,7 @@
 #define CONCURRENCPP_SHARED_RESULT_AWAITABLE_H
 
 #include "concurrencpp/results/impl/shared_result_state.h"
+#include "concurrencpp/results/impl/timed_await_context.h"
 
 namespace concurrencpp::details {
     template<class type>
@@ -59,6 +60,44 @@ namespace concurrencpp {
             return shared_result<type>(std::move(this->m_state));
         }
     };
+
+    template<class type>
+    class timed_shared_resolve_awaitable : public details::shared_awaitable_base<type>, private details::timed_await_context {
+
+       private:
+        details::shared_await_context m_await_ctx;
+
+        bool try_cancel_wait() noexcept override {
+            return this->m_state->remove_awaiter(m_await_ctx);
+        }
+
+       public:
+        timed_shared_resolve_awaitable(const std::shared_ptr<details::shared_result_state<type>>& state,
+                                       std::shared_ptr<timer_queue> timer_queue,
+                                       std::chrono::milliseconds timeout,
+                                       std::shared_ptr<executor> timeout_executor) :
+            details::shared_awaitable_base<type>(state),
+            details::timed_await_context(std::move(timer_queue), timeout, std::move(timeout_executor)) {}
+
+        timed_shared_resolve_awaitable(const std::shared_ptr<details::shared_result_state<type>>& state,
+                                       std::shared_ptr<timer_queue> timer_queue,
+                                       time_point deadline,
+                                       std::shared_ptr<executor> timeout_executor) noexcept :
+            details::shared_awaitable_base<type>(state),
+            details::timed_await_context(std::move(timer_queue), deadline, std::move(timeout_executor)) {}
+
+        bool await_suspend(details::coroutine_handle<void> caller_handle) {
+            assert(static_cast<bool>(this->m_state));
+            this->m_await_ctx.caller_handle = caller_handle;
+            this->set_caller_handle(caller_handle);
+            return this->arm(this->m_state->await_removable(m_await_ctx));
+        }
+
+        shared_result<type> await_resume() {
+            this->disarm();
+            return shared_result<type>(std::move(this->m_state));
+        }
+    };
 }  // namespace concurrencpp
 
 #endif
\ No newline at end of file
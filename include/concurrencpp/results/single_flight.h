@@ -0,0 +1,351 @@
+#ifndef CONCURRENCPP_SINGLE_FLIGHT_H
+#define CONCURRENCPP_SINGLE_FLIGHT_H
+
+#include "concurrencpp/task.h"
+#include "concurrencpp/timers/timer.h"
+#include "concurrencpp/timers/timer_queue.h"
+#include "concurrencpp/results/result.h"
+#include "concurrencpp/results/lazy_result.h"
+#include "concurrencpp/results/promises.h"
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/shared_result.h"
+#include "concurrencpp/results/impl/awaitable_traits.h"
+#include "concurrencpp/threads/cache_line.h"
+#include "concurrencpp/executors/executor.h"
+#include "concurrencpp/forward_declarations.h"
+#include "concurrencpp/errors.h"
+
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+
+namespace concurrencpp::details {
+    template<class key_type, class value_type, class hash_type, class key_equal_type>
+    class single_flight_state : public std::enable_shared_from_this<single_flight_state<key_type, value_type, hash_type, key_equal_type>> {
+
+       public:
+        using time_point = timer_queue::time_point;
+
+       private:
+        struct entry {
+            shared_result<value_type> result;
+            uint64_t flight_id;
+            time_point expires_at;  // time_point::max() until the loader is done
+        };
+
+        struct alignas(CRCPP_CACHE_LINE_ALIGNMENT) shard {
+            std::mutex lock;
+            std::unordered_map<key_type, entry, hash_type, key_equal_type> entries;
+        };
+
+        const std::shared_ptr<executor> m_executor;
+        const std::shared_ptr<timer_queue> m_timer_queue;
+        const std::chrono::milliseconds m_ttl;
+        const size_t m_shard_count;
+        const std::unique_ptr<shard[]> m_shards;
+        const hash_type m_hash;
+        std::atomic<uint64_t> m_flight_id {0};
+
+        shard& shard_of(const key_type& key) noexcept {
+            return m_shards[m_hash(key) % m_shard_count];
+        }
+
+        // called by the loader right before its value is published.
+        void on_loaded(const key_type& key, uint64_t flight_id) noexcept {
+            auto& shard = shard_of(key);
+            std::unique_lock<std::mutex> lock(shard.lock);
+            const auto it = shard.entries.find(key);
+            if (it == shard.entries.end() || it->second.flight_id != flight_id) {
+                return;  // erased or replaced meanwhile
+            }
+
+            if (m_ttl.count() == 0) {
+                shard.entries.erase(it);
+                return;
+            }
+
+            it->second.expires_at = m_timer_queue->now() + m_ttl;
+        }
+
+        // failures are not cached: the next caller starts a new flight.
+        void on_failed(const key_type& key, uint64_t flight_id) noexcept {
+            auto& shard = shard_of(key);
+            std::unique_lock<std::mutex> lock(shard.lock);
+            const auto it = shard.entries.find(key);
+            if (it != shard.entries.end() && it->second.flight_id == flight_id) {
+                shard.entries.erase(it);
+            }
+        }
+
+        bool is_alive(const entry& entry) const noexcept {
+            if (entry.expires_at == time_point::max()) {
+                return true;  // in flight
+            }
+
+            return m_timer_queue->now() < entry.expires_at;
+        }
+
+        /*
+         * The task that is posted to the executor for every new flight. if the executor destroys it without running it,
+         * the flight fails with a broken_task exception.
+         */
+        template<class loader_type>
+        class loader_task {
+
+           private:
+            std::shared_ptr<single_flight_state> m_parent;
+            std::shared_ptr<shared_result_state<value_type>> m_state;
+            key_type m_key;
+            uint64_t m_flight_id;
+            loader_type m_loader;
+
+            static null_result run(std::shared_ptr<single_flight_state> parent,
+                                   std::shared_ptr<shared_result_state<value_type>> state,
+                                   key_type key,
+                                   uint64_t flight_id,
+                                   loader_type loader) {
+                using traits = awaitable_traits<std::decay_t<std::invoke_result_t<loader_type&, const key_type&>>>;
+
+                try {
+                    if constexpr (traits::is_awaitable) {
+                        state->set_result(co_await loader(key));
+                    } else {
+                        state->set_result(loader(key));
+                    }
+
+                    parent->on_loaded(key, flight_id);
+                } catch (...) {
+                    parent->on_failed(key, flight_id);
+                    state->unhandled_exception();
+                }
+
+                state->complete_producer();
+            }
+
+           public:
+            loader_task(std::shared_ptr<single_flight_state> parent,
+                        std::shared_ptr<shared_result_state<value_type>> state,
+                        const key_type& key,
+                        uint64_t flight_id,
+                        loader_type loader) :
+                m_parent(std::move(parent)),
+                m_state(std::move(state)), m_key(key), m_flight_id(flight_id), m_loader(std::move(loader)) {}
+
+            loader_task(loader_task&& rhs) noexcept = default;
+
+            ~loader_task() noexcept {
+                if (!static_cast<bool>(m_state)) {
+                    return;
+                }
+
+                m_parent->on_failed(m_key, m_flight_id);
+
+                try {
+                    throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+                } catch (...) {
+                    m_state->unhandled_exception();
+                }
+
+                m_state->complete_producer();
+            }
+
+            void operator()() {
+                run(std::move(m_parent), std::move(m_state), std::move(m_key), m_flight_id, std::move(m_loader));
+            }
+        };
+
+        // the entry of the flight is already published. if the task can't be made, nothing would ever complete it.
+        template<class loader_type>
+        loader_task<std::decay_t<loader_type>> make_loader_task(const std::shared_ptr<shared_result_state<value_type>>& state,
+                                                                const key_type& key,
+                                                                uint64_t flight_id,
+                                                                loader_type&& loader) {
+            try {
+                return {this->shared_from_this(), state, key, flight_id, std::forward<loader_type>(loader)};
+            } catch (...) {
+                on_failed(key, flight_id);
+                state->unhandled_exception();
+                state->complete_producer();
+                throw;
+            }
+        }
+
+       public:
+        single_flight_state(std::shared_ptr<executor> executor,
+                            std::shared_ptr<timer_queue> timer_queue,
+                            std::chrono::milliseconds ttl,
+                            size_t shard_count) :
+            m_executor(std::move(executor)),
+            m_timer_queue(std::move(timer_queue)), m_ttl(ttl), m_shard_count(shard_count),
+            m_shards(std::make_unique<shard[]>(shard_count)) {}
+
+        template<class loader_type>
+        shared_result<value_type> get(const key_type& key, loader_type&& loader) {
+            auto& shard = shard_of(key);
+            std::shared_ptr<shared_result_state<value_type>> state;
+            uint64_t flight_id;
+
+            {
+                std::unique_lock<std::mutex> lock(shard.lock);
+                const auto it = shard.entries.find(key);
+                if (it != shard.entries.end()) {
+                    if (is_alive(it->second)) {
+                        return it->second.result;
+                    }
+
+                    shard.entries.erase(it);
+                }
+
+                state = std::make_shared<shared_result_state<value_type>>();
+                flight_id = m_flight_id.fetch_add(1, std::memory_order_relaxed);
+                shard.entries.emplace(key, entry {state, flight_id, time_point::max()});
+            }
+
+            // the loader may run inline and take the shard lock, so the task is posted after it's released.
+            auto new_flight = make_loader_task(state, key, flight_id, std::forward<loader_type>(loader));
+
+            try {
+                m_executor->enqueue(std::move(new_flight));
+            } catch (...) {
+                // if enqueue throws, the task is destroyed and the flight fails with a broken_task exception.
+            }
+
+            return {std::move(state)};
+        }
+
+        bool erase(const key_type& key) {
+            auto& shard = shard_of(key);
+            std::unique_lock<std::mutex> lock(shard.lock);
+            return shard.entries.erase(key) != 0;
+        }
+
+        void clear() {
+            for (size_t i = 0; i < m_shard_count; i++) {
+                std::unique_lock<std::mutex> lock(m_shards[i].lock);
+                m_shards[i].entries.clear();
+            }
+        }
+
+        size_t size() {
+            size_t total = 0;
+            for (size_t i = 0; i < m_shard_count; i++) {
+                std::unique_lock<std::mutex> lock(m_shards[i].lock);
+                total += m_shards[i].entries.size();
+            }
+
+            return total;
+        }
+
+        void purge_expired() {
+            for (size_t i = 0; i < m_shard_count; i++) {
+                std::unique_lock<std::mutex> lock(m_shards[i].lock);
+                std::erase_if(m_shards[i].entries, [this](const auto& key_entry) {
+                    return !is_alive(key_entry.second);
+                });
+            }
+        }
+    };
+}  // namespace concurrencpp::details
+
+namespace concurrencpp {
+    /*
+     * A keyed, request-coalescing cache. concurrent callers that ask for the same key share a single shared_result, and the
+     * loader runs once per key on the given executor. with a ttl, values are kept for ttl after they were loaded (measured
+     * on the timer_queue clock), and a periodic timer purges the expired ones. without a ttl, only in-flight loads are shared.
+     * failed loads are never cached. keys are spread over independently locked shards.
+     */
+    template<class key_type, class value_type, class hash_type = std::hash<key_type>, class key_equal_type = std::equal_to<key_type>>
+    class single_flight {
+
+        static_assert(!std::is_void_v<value_type>, "concurrencpp::single_flight - <<value_type>> can't be void.");
+
+       private:
+        using state_type = details::single_flight_state<key_type, value_type, hash_type, key_equal_type>;
+
+        std::shared_ptr<state_type> m_state;
+        timer m_purge_timer;
+
+        static std::shared_ptr<executor> verify_executor(std::shared_ptr<executor> executor) {
+            if (!static_cast<bool>(executor)) {
+                throw std::invalid_argument(details::consts::k_single_flight_null_executor_err_msg);
+            }
+
+            return executor;
+        }
+
+        static size_t verify_shard_count(size_t shard_count) {
+            if (shard_count == 0) {
+                throw std::invalid_argument(details::consts::k_single_flight_invalid_shard_count_err_msg);
+            }
+
+            return shard_count;
+        }
+
+       public:
+        static constexpr size_t default_shard_count = 16;
+
+        single_flight(std::shared_ptr<executor> executor, size_t shard_count = default_shard_count) :
+            m_state(std::make_shared<state_type>(verify_executor(std::move(executor)),
+                                                 nullptr,
+                                                 std::chrono::milliseconds(0),
+                                                 verify_shard_count(shard_count))) {}
+
+        single_flight(std::shared_ptr<executor> executor,
+                      std::shared_ptr<timer_queue> timer_queue,
+                      std::chrono::milliseconds ttl,
+                      size_t shard_count = default_shard_count) {
+            verify_executor(executor);
+            verify_shard_count(shard_count);
+
+            if (!static_cast<bool>(timer_queue)) {
+                throw std::invalid_argument(details::consts::k_single_flight_null_timer_queue_err_msg);
+            }
+
+            if (ttl.count() <= 0) {
+                throw std::invalid_argument(details::consts::k_single_flight_invalid_ttl_err_msg);
+            }
+
+            m_state = std::make_shared<state_type>(executor, timer_queue, ttl, shard_count);
+            m_purge_timer = timer_queue->make_timer(ttl, ttl, std::move(executor), [weak_state = std::weak_ptr<state_type>(m_state)] {
+                if (const auto state = weak_state.lock()) {
+                    state->purge_expired();
+                }
+            });
+        }
+
+        single_flight(const single_flight&) = delete;
+        single_flight(single_flight&&) = delete;
+
+        /*
+         * Returns the shared_result of key. if there is none, or it expired, loader(key) is invoked on the executor.
+         */
+        template<class loader_type>
+        shared_result<value_type> get(const key_type& key, loader_type&& loader) {
+            using loader_result_type = std::decay_t<std::invoke_result_t<std::decay_t<loader_type>&, const key_type&>>;
+            static_assert(std::is_same_v<typename details::awaitable_traits<loader_result_type>::value_type, value_type>,
+                          "concurrencpp::single_flight::get - <<loader_type>> does not produce <<value_type>>.");
+
+            return m_state->get(key, std::forward<loader_type>(loader));
+        }
+
+        bool erase(const key_type& key) {
+            return m_state->erase(key);
+        }
+
+        void clear() {
+            m_state->clear();
+        }
+
+        size_t size() {
+            return m_state->size();
+        }
+    };
+}  // namespace concurrencpp
+
+#endif
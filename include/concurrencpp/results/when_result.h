@@ -44,6 +44,23 @@ namespace concurrencpp::details {
         }
 
        public:
+        // results that are ready inline get a state, so all the results can be synchronized on the same way.
+        template<class... types>
+        static void ensure_states(std::tuple<types...>& tuple) {
+            std::apply(
+                [](auto&... results) {
+                    (results.ensure_state(), ...);
+                },
+                tuple);
+        }
+
+        template<class type>
+        static void ensure_states(std::vector<type>& vector) {
+            for (auto& result : vector) {
+                result.ensure_state();
+            }
+        }
+
         template<typename tuple_type>
         static result_state_base& at(tuple_type& tuple, size_t n) noexcept {
             auto seq = std::make_index_sequence<std::tuple_size<tuple_type>::value>();
@@ -85,8 +102,9 @@ namespace concurrencpp::details {
         class when_any_awaitable {
 
            private:
-            std::shared_ptr<when_any_context> m_promise;
+            when_any_context m_context;  // the awaitable lives in the when_any coroutine frame, and so does the context
             result_types& m_results;
+            size_t m_registered = 0;
 
             template<class type>
             static result_state_base& get_at(std::vector<type>& vector, size_t i) noexcept {
@@ -115,38 +133,48 @@ namespace concurrencpp::details {
                 return false;
             }
 
-            bool await_suspend(coroutine_handle<void> coro_handle) {
-                m_promise = std::make_shared<when_any_context>(coro_handle);
+            bool await_suspend(coroutine_handle<void> coro_handle) noexcept {
+                m_context.set_coro_handle(coro_handle);
 
                 const auto range_length = size(m_results);
                 for (size_t i = 0; i < range_length; i++) {
-                    if (m_promise->any_result_finished()) {
+                    if (m_context.any_result_finished()) {
                         return false;
                     }
 
                     auto& state_ref = get_at(m_results, i);
-                    const auto status = state_ref.when_any(m_promise);
+                    const auto status = state_ref.when_any(m_context);
                     if (status == result_state_base::pc_state::producer_done) {
-                        return m_promise->resume_inline(state_ref);
+                        return m_context.resume_inline(state_ref);
                     }
+
+                    ++m_registered;
                 }
 
-                return m_promise->finish_processing();
+                return m_context.finish_processing();
             }
 
             size_t await_resume() noexcept {
-                const auto completed_result_state = m_promise->completed_result();
+                const auto completed_result_state = m_context.completed_result();
                 auto completed_result_index = std::numeric_limits<size_t>::max();
+                size_t rewound = 0;
 
                 const auto range_length = size(m_results);
                 for (size_t i = 0; i < range_length; i++) {
                     auto& state_ref = get_at(m_results, i);
-                    state_ref.try_rewind_consumer();
+                    if (state_ref.try_rewind_consumer()) {
+                        ++rewound;
+                    }
+
                     if (completed_result_state == &state_ref) {
                         completed_result_index = i;
                     }
                 }
 
+                // every registered result that couldn't be rewound has a producer that calls (or called) try_resume,
+                // the context must outlive all of them.
+                m_context.wait_for_producers(m_registered - rewound);
+
                 assert(completed_result_index != std::numeric_limits<size_t>::max());
                 return completed_result_index;
             }
@@ -179,6 +207,8 @@ namespace concurrencpp::details {
 
     template<class executor_type, class tuple_type>
     lazy_result<tuple_type> when_all_impl(std::shared_ptr<executor_type> resume_executor, tuple_type tuple) {
+        when_result_helper::ensure_states(tuple);
+
         for (size_t i = 0; i < std::tuple_size_v<tuple_type>; i++) {
             auto& state_ref = when_result_helper::at(tuple, i);
             co_await when_result_helper::when_all_awaitable {state_ref};
@@ -241,6 +271,7 @@ namespace concurrencpp {
 namespace concurrencpp::details {
     template<class executor_type, class tuple_type>
     lazy_result<when_any_result<tuple_type>> when_any_impl(std::shared_ptr<executor_type> resume_executor, tuple_type tuple) {
+        when_result_helper::ensure_states(tuple);
         const auto completed_index = co_await when_result_helper::when_any_awaitable<tuple_type> {tuple};
         co_await resume_on(resume_executor);
         co_return when_any_result<tuple_type> {completed_index, std::move(tuple)};
@@ -249,6 +280,7 @@ namespace concurrencpp::details {
     template<class executor_type, class type>
     lazy_result<when_any_result<std::vector<type>>> when_any_impl(std::shared_ptr<executor_type> resume_executor,
                                                                   std::vector<type> vector) {
+        when_result_helper::ensure_states(vector);
         const auto completed_index = co_await when_result_helper::when_any_awaitable {vector};
         co_await resume_on(resume_executor);
         co_return when_any_result<std::vector<type>> {completed_index, std::move(vector)};
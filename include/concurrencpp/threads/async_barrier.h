@@ -0,0 +1,46 @@
+#ifndef CONCURRENCPP_ASYNC_BARRIER_H
+#define CONCURRENCPP_ASYNC_BARRIER_H
+
+#include "concurrencpp/platform_defs.h"
+#include "concurrencpp/threads/async_event.h"
+#include "concurrencpp/forward_declarations.h"
+
+#include <atomic>
+#include <memory>
+#include <functional>
+
+namespace concurrencpp {
+    /*
+     * A reusable barrier for a fixed group of tasks. every phase, each participant arrives once, which is a single atomic
+     * operation. the last participant to arrive runs the completion function and resumes the others.
+     * phases alternate between two events: the event of the next phase is reset before the current one is set, and a
+     * participant can't arrive at the next phase before the current one completes, so no wakeup is lost or spurious.
+     * The barrier must outlive the tasks that wait on it.
+     */
+    class CRCPP_API async_barrier {
+
+       private:
+        std::atomic_size_t m_remaining;
+        std::atomic_size_t m_phase {0};
+        std::atomic_size_t m_dropped {0};
+        size_t m_expected;  // only accessed by the participant that completes a phase
+        const std::function<void()> m_completion;
+        async_manual_reset_event m_phase_events[2];
+
+        bool try_arrive(size_t phase);
+        void complete_phase(size_t phase);
+
+       public:
+        explicit async_barrier(size_t expected, std::function<void()> completion = {});
+
+        async_barrier(const async_barrier&) = delete;
+        async_barrier(async_barrier&&) = delete;
+
+        details::async_event_awaiter arrive_and_wait(std::shared_ptr<executor> resume_executor);
+        void arrive_and_drop();
+
+        size_t phase() const noexcept;
+    };
+}  // namespace concurrencpp
+
+#endif
@@ -8,24 +8,46 @@
 #include "concurrencpp/forward_declarations.h"
 
 namespace concurrencpp::details {
+    class task_batch;
+
+    enum class cv_wakeup {
+        // the lock was acquired by the notifier, the task is resumed inside its resume executor.
+        owns_lock,
+
+        // the lock was handed to the task by its previous owner, inside the previous owner's thread of execution.
+        owns_lock_handed_off,
+
+        // the task was woken up to compete for the lock (async_lock_mode::bounded_barging).
+        compete_for_lock
+    };
+
     class CRCPP_API cv_awaiter {
        private:
         async_condition_variable& m_parent;
         scoped_async_lock& m_lock;
+        const std::shared_ptr<executor>& m_resume_executor;
+        async_lock_awaiter m_lock_awaiter;
         coroutine_handle<void> m_caller_handle;
+        bool m_owns_lock = false;
+        bool m_interrupted = false;
 
        public:
         cv_awaiter* next = nullptr;
 
-        cv_awaiter(async_condition_variable& parent, scoped_async_lock& lock) noexcept;
+        cv_awaiter(async_condition_variable& parent, scoped_async_lock& lock, const std::shared_ptr<executor>& resume_executor) noexcept;
 
         constexpr bool await_ready() const noexcept {
             return false;
         }
 
         void await_suspend(details::coroutine_handle<void> caller_handle);
-        void await_resume() const noexcept {}
-        void resume() noexcept;
+        cv_wakeup await_resume();
+
+        /*
+         * Moves the notified task to its lock, instead of waking it up just to block on the lock again: if the lock is free,
+         * the task acquires it and is added to batch, otherwise the task is queued as a waiter of the lock (wait-morphing).
+         */
+        void notify(task_batch& batch) noexcept;
     };
 }  // namespace concurrencpp::details
 
@@ -0,0 +1,70 @@
+#ifndef CONCURRENCPP_ASYNC_EVENT_H
+#define CONCURRENCPP_ASYNC_EVENT_H
+
+#include "concurrencpp/platform_defs.h"
+#include "concurrencpp/coroutines/coroutine.h"
+#include "concurrencpp/forward_declarations.h"
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+namespace concurrencpp::details {
+    class CRCPP_API async_event_awaiter {
+
+        friend class concurrencpp::async_manual_reset_event;
+
+       private:
+        async_manual_reset_event& m_parent;
+        std::shared_ptr<executor> m_resume_executor;
+        coroutine_handle<void> m_resume_handle;
+        bool m_interrupted = false;
+
+       public:
+        async_event_awaiter* next = nullptr;
+
+       public:
+        async_event_awaiter(async_manual_reset_event& parent, std::shared_ptr<executor> resume_executor) noexcept;
+
+        bool await_ready() const noexcept;
+        bool await_suspend(coroutine_handle<void> handle) noexcept;
+        void await_resume() const;
+    };
+}  // namespace concurrencpp::details
+
+namespace concurrencpp {
+    /*
+     * An event tasks can wait on. once set, all the waiting tasks are resumed inside their resume executors, and new waiters
+     * don't suspend until the event is reset. waiters are kept in a lock-free stack of awaiters that live inside the
+     * suspended coroutines, so waiting doesn't allocate.
+     * The event must outlive the tasks that wait on it.
+     */
+    class CRCPP_API async_manual_reset_event {
+
+        friend class details::async_event_awaiter;
+
+       private:
+        // m_state is either k_not_set, k_set, or a pointer to the most recent awaiter of a stack of waiting awaiters.
+        static constexpr std::uintptr_t k_not_set = 0;
+        static constexpr std::uintptr_t k_set = 1;
+
+        std::atomic_uintptr_t m_state;
+
+        bool enqueue_awaiter(details::async_event_awaiter& awaiter) noexcept;
+
+       public:
+        explicit async_manual_reset_event(bool initially_set = false) noexcept;
+        ~async_manual_reset_event() noexcept;
+
+        async_manual_reset_event(const async_manual_reset_event&) = delete;
+        async_manual_reset_event(async_manual_reset_event&&) = delete;
+
+        details::async_event_awaiter wait(std::shared_ptr<executor> resume_executor);
+
+        bool is_set() const noexcept;
+        void set() noexcept;
+        void reset() noexcept;
+    };
+}  // namespace concurrencpp
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef CONCURRENCPP_ASYNC_LATCH_H
+#define CONCURRENCPP_ASYNC_LATCH_H
+
+#include "concurrencpp/platform_defs.h"
+#include "concurrencpp/threads/async_event.h"
+#include "concurrencpp/forward_declarations.h"
+
+#include <atomic>
+#include <memory>
+
+namespace concurrencpp {
+    /*
+     * A single-use countdown: tasks wait until the counter reaches zero. counting down is a single atomic operation, the
+     * waiting tasks are resumed by whoever counts the latch down to zero.
+     * The latch must outlive the tasks that wait on it.
+     */
+    class CRCPP_API async_latch {
+
+       private:
+        std::atomic_size_t m_counter;
+        async_manual_reset_event m_event;
+
+       public:
+        explicit async_latch(size_t expected) noexcept;
+
+        async_latch(const async_latch&) = delete;
+        async_latch(async_latch&&) = delete;
+
+        void count_down(size_t update = 1);
+        bool try_wait() const noexcept;
+
+        details::async_event_awaiter wait(std::shared_ptr<executor> resume_executor);
+        details::async_event_awaiter arrive_and_wait(std::shared_ptr<executor> resume_executor, size_t update = 1);
+    };
+}  // namespace concurrencpp
+
+#endif
@@ -7,30 +7,57 @@
 #include "concurrencpp/results/lazy_result.h"
 #include "concurrencpp/forward_declarations.h"
 
+#include <atomic>
+#include <limits>
+#include <cstdint>
+
 namespace concurrencpp::details {
+    class cv_awaiter;
+
     class async_lock_awaiter {
 
         friend class concurrencpp::async_lock;
 
        private:
         async_lock& m_parent;
-        std::unique_lock<std::mutex> m_lock;
+        const std::shared_ptr<executor>& m_resume_executor;
+        const size_t m_failed_attempts;  // how many times this task was woken up and lost the lock to a barging task
+        size_t m_arrival;                // the place of the task in the queue, kept when it loses the lock and waits again
         coroutine_handle<void> m_resume_handle;
+        bool m_acquired_inline = false;
+        bool m_handed_off = false;
+        bool m_interrupted = false;
 
        public:
         async_lock_awaiter* next = nullptr;
 
        public:
-        async_lock_awaiter(async_lock& parent, std::unique_lock<std::mutex>& lock) noexcept;
+        async_lock_awaiter(async_lock& parent,
+                           const std::shared_ptr<executor>& resume_executor,
+                           size_t failed_attempts,
+                           size_t arrival = 0) noexcept;
 
         constexpr bool await_ready() const noexcept {
             return false;
         }
 
-        void await_suspend(coroutine_handle<void> handle);
+        bool await_suspend(coroutine_handle<void> handle) noexcept;
 
-        constexpr void await_resume() const noexcept {}
+        // returns true if the lock is owned by the awaiting task, false if the task was woken up to compete for it.
+        bool await_resume() const;
 
+        bool handed_off() const noexcept {
+            return m_handed_off;
+        }
+
+        size_t arrival() const noexcept {
+            return m_arrival;
+        }
+
+        // resumes the awaiting task inline, as the new owner of the lock.
+        void hand_off() noexcept;
+
+        // resumes the awaiting task inside its resume executor, to compete for the (released) lock.
         void retry() noexcept;
     };
 }  // namespace concurrencpp::details
@@ -38,28 +65,80 @@ namespace concurrencpp::details {
 namespace concurrencpp {
     class scoped_async_lock;
 
+    enum class async_lock_mode {
+        // unlock releases the lock and wakes up the task that has been waiting the longest, inside its resume executor.
+        // meanwhile, running tasks may acquire the lock. this is the default mode.
+        barging,
+
+        // unlock hands ownership directly to the task that has been waiting the longest.
+        fifo_handoff,
+
+        // unlock releases the lock and wakes up the task that has been waiting the longest, inside its resume executor.
+        // meanwhile, running tasks may acquire the lock. a task that loses the lock max_barging times is handed it directly.
+        bounded_barging
+    };
+
+    struct async_lock_stats {
+        size_t waits = 0;  // number of times a task was suspended waiting for the lock
+        size_t handoffs = 0;  // number of times ownership was handed directly to a waiting task
+        size_t barging_wakeups = 0;  // number of times a waiting task was woken up to compete for the lock
+        double average_queue_length = 0.0;  // average number of waiting tasks, sampled by every unlock that found any
+    };
+
     class CRCPP_API async_lock {
 
         friend class scoped_async_lock;
+        friend class details::cv_awaiter;
         friend class details::async_lock_awaiter;
 
        private:
-        std::mutex m_awaiter_lock;
+        /*
+         * m_state is either k_unlocked, k_locked_no_waiters, or a pointer to the most recent awaiter of a lock-free
+         * stack of awaiters that arrived while the lock was held. m_awaiters holds older awaiters in FIFO order and is
+         * only accessed by the owner of the lock.
+         */
+        static constexpr std::uintptr_t k_unlocked = 0;
+        static constexpr std::uintptr_t k_locked_no_waiters = 1;
+
+        std::atomic_uintptr_t m_state {k_unlocked};
         details::slist<details::async_lock_awaiter> m_awaiters;
-        bool m_locked = false;
+        size_t m_awaiter_count = 0;  // guarded like m_awaiters
+        size_t m_next_arrival = 1;   // guarded like m_awaiters
+
+        const async_lock_mode m_mode = async_lock_mode::barging;
+        const size_t m_max_barging = std::numeric_limits<size_t>::max();
+
+        // contention statistics, only updated on the slow path.
+        std::atomic_size_t m_waits {0};
+        std::atomic_size_t m_handoffs {0};
+        std::atomic_size_t m_barging_wakeups {0};
+        std::atomic_size_t m_queue_length_sum {0};
 
 #ifdef CRCPP_DEBUG_MODE
         std::atomic_intptr_t m_thread_count_in_critical_section {0};
 #endif
 
         lazy_result<scoped_async_lock> lock_impl(std::shared_ptr<executor> resume_executor, bool with_raii_guard);
+        bool try_lock_impl() noexcept;
+        void enter_critical_section() noexcept;
+        bool enqueue_awaiter(details::async_lock_awaiter& awaiter) noexcept;
+        bool enqueue_awaiter(details::async_lock_awaiter& awaiter, details::coroutine_handle<void> resume_handle) noexcept;
+        void absorb_awaiters(std::uintptr_t awaiter_stack) noexcept;
+        void requeue_awaiter(details::async_lock_awaiter& awaiter) noexcept;
+        void release_contended() noexcept;
 
        public:
+        async_lock() noexcept = default;
+        async_lock(async_lock_mode mode, size_t max_barging = 4) noexcept;
+
         ~async_lock() noexcept;
 
         lazy_result<scoped_async_lock> lock(std::shared_ptr<executor> resume_executor);
-        lazy_result<bool> try_lock();
+        bool try_lock() noexcept;
         void unlock();
+
+        async_lock_mode mode() const noexcept;
+        async_lock_stats stats() const noexcept;
     };
 
     class CRCPP_API scoped_async_lock {
@@ -78,7 +157,7 @@ namespace concurrencpp {
         ~scoped_async_lock() noexcept;
 
         lazy_result<void> lock(std::shared_ptr<executor> resume_executor);
-        lazy_result<bool> try_lock();
+        bool try_lock();
         void unlock();
 
         bool owns_lock() const noexcept;
@@ -0,0 +1,74 @@
+#ifndef CONCURRENCPP_ASYNC_SEMAPHORE_H
+#define CONCURRENCPP_ASYNC_SEMAPHORE_H
+
+#include "concurrencpp/utils/slist.h"
+#include "concurrencpp/platform_defs.h"
+#include "concurrencpp/coroutines/coroutine.h"
+#include "concurrencpp/forward_declarations.h"
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+
+namespace concurrencpp::details {
+    class CRCPP_API async_semaphore_awaiter {
+
+        friend class concurrencpp::async_semaphore;
+
+       private:
+        async_semaphore& m_parent;
+        const size_t m_count;
+        std::shared_ptr<executor> m_resume_executor;
+        coroutine_handle<void> m_resume_handle;
+        bool m_interrupted = false;
+
+       public:
+        async_semaphore_awaiter* next = nullptr;
+
+       public:
+        async_semaphore_awaiter(async_semaphore& parent, size_t count, std::shared_ptr<executor> resume_executor) noexcept;
+
+        bool await_ready() noexcept;
+        bool await_suspend(coroutine_handle<void> handle);
+        void await_resume();
+    };
+}  // namespace concurrencpp::details
+
+namespace concurrencpp {
+    /*
+     * A counting semaphore for tasks. as long as no task waits, acquiring and releasing permits is a single atomic
+     * operation. tasks that can't acquire their permits are queued in FIFO order, and are resumed inside their resume
+     * executors once enough permits are released. all the tasks a release admits are handed to each executor in one batch.
+     * The semaphore must outlive the tasks that wait on it.
+     */
+    class CRCPP_API async_semaphore {
+
+        friend class details::async_semaphore_awaiter;
+
+       private:
+        std::atomic_size_t m_permits;
+        std::atomic_size_t m_waiter_count {0};
+
+        std::mutex m_lock;
+        details::slist<details::async_semaphore_awaiter> m_awaiters;
+
+        bool try_take(size_t count) noexcept;
+        bool try_take_fast(size_t count) noexcept;
+        bool enqueue_awaiter(details::async_semaphore_awaiter& awaiter);
+
+       public:
+        explicit async_semaphore(size_t initial_permits) noexcept;
+        ~async_semaphore() noexcept;
+
+        async_semaphore(const async_semaphore&) = delete;
+        async_semaphore(async_semaphore&&) = delete;
+
+        details::async_semaphore_awaiter acquire(std::shared_ptr<executor> resume_executor, size_t count = 1);
+        bool try_acquire(size_t count = 1) noexcept;
+        void release(size_t count = 1);
+
+        size_t available_permits() const noexcept;
+    };
+}  // namespace concurrencpp
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef CONCURRENCPP_ASYNC_SHARED_MUTEX_H
+#define CONCURRENCPP_ASYNC_SHARED_MUTEX_H
+
+#include "concurrencpp/utils/slist.h"
+#include "concurrencpp/platform_defs.h"
+#include "concurrencpp/threads/cache_line.h"
+#include "concurrencpp/executors/executor.h"
+#include "concurrencpp/results/lazy_result.h"
+#include "concurrencpp/forward_declarations.h"
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+
+namespace concurrencpp::details {
+    class async_shared_mutex_awaiter {
+
+        friend class concurrencpp::async_shared_mutex;
+
+       private:
+        async_shared_mutex& m_parent;
+        const std::shared_ptr<executor>& m_resume_executor;
+        const bool m_exclusive;
+        coroutine_handle<void> m_resume_handle;
+        bool m_interrupted = false;
+
+       public:
+        async_shared_mutex_awaiter* next = nullptr;
+
+       public:
+        async_shared_mutex_awaiter(async_shared_mutex& parent, const std::shared_ptr<executor>& resume_executor, bool exclusive) noexcept;
+
+        constexpr bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(coroutine_handle<void> handle);
+        void await_resume() const;
+
+        // resumes the awaiting task inside its resume executor, as an owner of the mutex.
+        void resume() noexcept;
+    };
+}  // namespace concurrencpp::details
+
+namespace concurrencpp {
+    class scoped_async_shared_lock;
+    class scoped_async_exclusive_lock;
+
+    /*
+     * A reader-writer lock for tasks. readers announce themselves on one of several cache-line-sized counters, so readers
+     * running on different threads don't contend on the same cache line. once a writer is waiting, new readers wait behind
+     * it (writer preference). when a writer releases the mutex, all the readers that are waiting are admitted before the
+     * next writer, so readers are not starved either.
+     */
+    class CRCPP_API async_shared_mutex {
+
+        friend class scoped_async_shared_lock;
+        friend class scoped_async_exclusive_lock;
+        friend class details::async_shared_mutex_awaiter;
+
+       private:
+        struct alignas(CRCPP_CACHE_LINE_ALIGNMENT) padded_counter {
+            // readers might release the mutex in a different thread than the one that acquired it, so a single counter
+            // can be negative. only the sum of all the counters is meaningful.
+            std::atomic_intptr_t value {0};
+        };
+
+        const size_t m_reader_stripe_count;
+        const std::unique_ptr<padded_counter[]> m_reader_stripes;
+
+        // true while a writer owns the mutex, waits for readers to leave, or waits for another writer.
+        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic_bool m_writer_pending {false};
+
+        std::mutex m_lock;
+        bool m_writer_owns = false;
+        details::async_shared_mutex_awaiter* m_draining_writer = nullptr;
+        details::slist<details::async_shared_mutex_awaiter> m_waiting_writers;
+        details::slist<details::async_shared_mutex_awaiter> m_waiting_readers;
+
+        padded_counter& current_stripe() noexcept;
+        intptr_t reader_count() const noexcept;
+
+        bool try_lock_shared_fast() noexcept;
+        bool enqueue_awaiter(details::async_shared_mutex_awaiter& awaiter);
+        details::async_shared_mutex_awaiter* try_grant_draining_writer() noexcept;
+        void admit_waiting_readers(details::slist<details::async_shared_mutex_awaiter>& admitted) noexcept;
+
+        static void resume_all(details::slist<details::async_shared_mutex_awaiter>& awaiters) noexcept;
+
+        lazy_result<scoped_async_shared_lock> lock_shared_impl(std::shared_ptr<executor> resume_executor);
+        lazy_result<scoped_async_exclusive_lock> lock_impl(std::shared_ptr<executor> resume_executor);
+
+       public:
+        async_shared_mutex();
+        ~async_shared_mutex() noexcept;
+
+        async_shared_mutex(const async_shared_mutex&) = delete;
+        async_shared_mutex(async_shared_mutex&&) = delete;
+
+        lazy_result<scoped_async_exclusive_lock> lock(std::shared_ptr<executor> resume_executor);
+        bool try_lock();
+        void unlock();
+
+        lazy_result<scoped_async_shared_lock> lock_shared(std::shared_ptr<executor> resume_executor);
+        bool try_lock_shared();
+        void unlock_shared();
+    };
+
+    class CRCPP_API scoped_async_shared_lock {
+
+       private:
+        async_shared_mutex* m_mutex = nullptr;
+
+       public:
+        scoped_async_shared_lock() noexcept = default;
+        scoped_async_shared_lock(scoped_async_shared_lock&& rhs) noexcept;
+        scoped_async_shared_lock(async_shared_mutex& mutex, std::adopt_lock_t) noexcept;
+
+        ~scoped_async_shared_lock() noexcept;
+
+        void unlock();
+
+        bool owns_lock() const noexcept;
+        explicit operator bool() const noexcept;
+
+        void swap(scoped_async_shared_lock& rhs) noexcept;
+        async_shared_mutex* release() noexcept;
+        async_shared_mutex* mutex() const noexcept;
+    };
+
+    class CRCPP_API scoped_async_exclusive_lock {
+
+       private:
+        async_shared_mutex* m_mutex = nullptr;
+
+       public:
+        scoped_async_exclusive_lock() noexcept = default;
+        scoped_async_exclusive_lock(scoped_async_exclusive_lock&& rhs) noexcept;
+        scoped_async_exclusive_lock(async_shared_mutex& mutex, std::adopt_lock_t) noexcept;
+
+        ~scoped_async_exclusive_lock() noexcept;
+
+        void unlock();
+
+        bool owns_lock() const noexcept;
+        explicit operator bool() const noexcept;
+
+        void swap(scoped_async_exclusive_lock& rhs) noexcept;
+        async_shared_mutex* release() noexcept;
+        async_shared_mutex* mutex() const noexcept;
+    };
+}  // namespace concurrencpp
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef CONCURRENCPP_ATOMIC_WAIT_H
+#define CONCURRENCPP_ATOMIC_WAIT_H
+
+#include "concurrencpp/platform_defs.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace concurrencpp::details {
+    /*
+     * A timed std::atomic<T>::wait for 32 bit atomics, which the standard doesn't provide. on linux it is a
+     * FUTEX_WAIT_BITSET with an absolute deadline, on windows it is WaitOnAddress. on other platforms the waiting thread
+     * blocks on a condition variable taken from a small table keyed by the waited address.
+     * a thread that waits with atomic_wait / atomic_wait_until must be woken up with atomic_notify_one / atomic_notify_all,
+     * which are not interchangeable with std::atomic<T>::notify_one / notify_all.
+     * notifying an address whose atomic was already destroyed is harmless, it can only cause a spurious wakeup.
+     */
+    CRCPP_API void atomic_wait(const void* address, std::int32_t old_value) noexcept;
+    CRCPP_API bool atomic_wait_until(const void* address, std::int32_t old_value, std::chrono::steady_clock::time_point deadline) noexcept;
+    CRCPP_API void atomic_notify_one(const void* address) noexcept;
+    CRCPP_API void atomic_notify_all(const void* address) noexcept;
+
+    // blocks until atomic no longer holds old_value.
+    template<class type>
+    void atomic_wait(const std::atomic<type>& atomic, type old_value) noexcept {
+        static_assert(sizeof(std::atomic<type>) == sizeof(std::int32_t) && std::atomic<type>::is_always_lock_free,
+                      "concurrencpp::details::atomic_wait - <<type>> must be a lock-free, 32 bit type.");
+
+        while (atomic.load(std::memory_order_acquire) == old_value) {
+            atomic_wait(static_cast<const void*>(&atomic), static_cast<std::int32_t>(old_value));
+        }
+    }
+
+    /*
+     * Blocks while atomic holds old_value, until woken up or until deadline. spurious wakeups are possible.
+     * returns false if deadline was reached.
+     */
+    template<class type>
+    bool atomic_wait_until(const std::atomic<type>& atomic, type old_value, std::chrono::steady_clock::time_point deadline) noexcept {
+        static_assert(sizeof(std::atomic<type>) == sizeof(std::int32_t) && std::atomic<type>::is_always_lock_free,
+                      "concurrencpp::details::atomic_wait_until - <<type>> must be a lock-free, 32 bit type.");
+
+        return atomic_wait_until(static_cast<const void*>(&atomic), static_cast<std::int32_t>(old_value), deadline);
+    }
+}  // namespace concurrencpp::details
+
+#endif
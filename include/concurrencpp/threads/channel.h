@@ -0,0 +1,416 @@
+#ifndef CONCURRENCPP_CHANNEL_H
+#define CONCURRENCPP_CHANNEL_H
+
+#include "concurrencpp/utils/slist.h"
+#include "concurrencpp/platform_defs.h"
+#include "concurrencpp/threads/constants.h"
+#include "concurrencpp/threads/cache_line.h"
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/lazy_result.h"
+#include "concurrencpp/coroutines/coroutine.h"
+#include "concurrencpp/forward_declarations.h"
+#include "concurrencpp/errors.h"
+
+#include <new>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <optional>
+#include <algorithm>
+
+namespace concurrencpp::details {
+    class task_batch;
+
+    /*
+     * A bounded lock-free MPMC ring (Dmitry Vyukov's design): every cell carries a sequence number that tells producers
+     * and consumers whether the cell is free for the current lap, so each operation is a single CAS on the shared position.
+     * a cell that is free for position pos carries 2 * pos, and a cell that holds the value of position pos carries
+     * 2 * pos + 1. with the plain pos / pos + 1 encoding, a full cell and a free cell look the same when the capacity is 1.
+     */
+    template<class type>
+    class channel_ring {
+
+        struct cell {
+            std::atomic_size_t sequence;
+            alignas(type) std::byte storage[sizeof(type)];
+        };
+
+       private:
+        const size_t m_capacity;
+        const std::unique_ptr<cell[]> m_cells;
+        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic_size_t m_enqueue_pos {0};
+        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic_size_t m_dequeue_pos {0};
+
+       public:
+        explicit channel_ring(size_t capacity) : m_capacity(capacity), m_cells(std::make_unique<cell[]>(capacity)) {
+            for (size_t i = 0; i < capacity; i++) {
+                m_cells[i].sequence.store(2 * i, std::memory_order_relaxed);
+            }
+        }
+
+        ~channel_ring() noexcept {
+            while (try_pop().has_value()) {
+            }
+        }
+
+        // moves value into the ring only if there is room for it.
+        bool try_push(type& value) noexcept {
+            auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+
+            while (true) {
+                auto& cell = m_cells[pos % m_capacity];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(2 * pos);
+
+                if (diff == 0) {
+                    if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        new (cell.storage) type(std::move(value));
+                        cell.sequence.store(2 * pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;  // full
+                } else {
+                    pos = m_enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        std::optional<type> try_pop() noexcept {
+            auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+
+            while (true) {
+                auto& cell = m_cells[pos % m_capacity];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(2 * pos + 1);
+
+                if (diff == 0) {
+                    if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        auto& value = *std::launder(reinterpret_cast<type*>(cell.storage));
+                        std::optional<type> result(std::move(value));
+                        value.~type();
+                        cell.sequence.store(2 * (pos + m_capacity), std::memory_order_release);
+                        return result;
+                    }
+                } else if (diff < 0) {
+                    return {};  // empty
+                } else {
+                    pos = m_dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        size_t capacity() const noexcept {
+            return m_capacity;
+        }
+    };
+
+    class CRCPP_API channel_awaiter_base {
+
+        friend class channel_base;
+
+       protected:
+        std::shared_ptr<executor> m_resume_executor;
+        coroutine_handle<void> m_resume_handle;
+        bool m_interrupted = false;
+
+        explicit channel_awaiter_base(std::shared_ptr<executor> resume_executor) noexcept;
+        ~channel_awaiter_base() noexcept = default;
+
+       public:
+        channel_awaiter_base* next = nullptr;
+
+        // completes the operation of the awaiter (pushes or pops a value) without waiting, if possible.
+        virtual bool try_complete() noexcept = 0;
+    };
+
+    /*
+     * The type-independent part of a channel: the producers and consumers that wait for room or for values.
+     * whoever pushes or pops a value completes the operations of the waiters it unblocks, and resumes them in one batch.
+     */
+    class CRCPP_API channel_base {
+
+       private:
+        alignas(CRCPP_CACHE_LINE_ALIGNMENT) std::atomic_size_t m_waiting_consumers {0};
+        std::atomic_size_t m_waiting_producers {0};
+        std::atomic_bool m_closed {false};
+
+        std::mutex m_lock;
+        slist<channel_awaiter_base> m_consumers;
+        slist<channel_awaiter_base> m_producers;
+
+        bool enqueue_awaiter(channel_awaiter_base& awaiter, slist<channel_awaiter_base>& awaiters, std::atomic_size_t& counter);
+        void dispatch() noexcept;
+
+        static void add_to_batch(task_batch& batch, channel_awaiter_base& awaiter, slist<channel_awaiter_base>& failed) noexcept;
+        static void interrupt_all(slist<channel_awaiter_base>& awaiters) noexcept;
+
+       protected:
+        bool enqueue_consumer(channel_awaiter_base& awaiter);
+        bool enqueue_producer(channel_awaiter_base& awaiter);
+
+        void on_pushed() noexcept;
+        void on_popped() noexcept;
+
+       public:
+        channel_base() noexcept = default;
+        ~channel_base() noexcept;
+
+        channel_base(const channel_base&) = delete;
+        channel_base(channel_base&&) = delete;
+
+        void close() noexcept;
+        bool closed() const noexcept;
+    };
+
+    template<class type>
+    class channel_push_awaiter final : public channel_awaiter_base {
+
+        friend class concurrencpp::channel<type>;
+
+       private:
+        channel<type>& m_parent;
+        type m_value;
+        bool m_pushed = false;
+
+       public:
+        channel_push_awaiter(channel<type>& parent, std::shared_ptr<executor> resume_executor, type value) noexcept :
+            channel_awaiter_base(std::move(resume_executor)), m_parent(parent), m_value(std::move(value)) {}
+
+        bool await_ready() noexcept {
+            return m_parent.closed() || m_parent.try_push(std::move(m_value), m_pushed);
+        }
+
+        bool await_suspend(coroutine_handle<void> handle) {
+            m_resume_handle = handle;
+            return m_parent.enqueue_producer(*this);
+        }
+
+        bool await_resume() const {
+            /*
+             * a producer is only resumed with a pushed value once the value is already in the ring, and it might have been
+             * consumed by now. it can't be taken back like a popped value is re-offered, so if the resume executor
+             * rejected this task, it still reports the push (resuming inline) instead of throwing broken_task.
+             */
+            if (m_interrupted && !m_pushed) {
+                throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+            }
+
+            return m_pushed;
+        }
+
+        bool try_complete() noexcept override {
+            m_pushed = m_parent.m_ring.try_push(m_value);
+            return m_pushed;
+        }
+    };
+
+    template<class type>
+    class channel_pop_awaiter final : public channel_awaiter_base {
+
+        friend class concurrencpp::channel<type>;
+
+       private:
+        channel<type>& m_parent;
+        std::optional<type> m_value;
+
+       public:
+        channel_pop_awaiter(channel<type>& parent, std::shared_ptr<executor> resume_executor) noexcept :
+            channel_awaiter_base(std::move(resume_executor)), m_parent(parent) {}
+
+        bool await_ready() noexcept {
+            m_value = m_parent.try_pop();
+            return m_value.has_value() || m_parent.closed();
+        }
+
+        bool await_suspend(coroutine_handle<void> handle) {
+            m_resume_handle = handle;
+            return m_parent.enqueue_consumer(*this);
+        }
+
+        std::optional<type> await_resume() {
+            if (m_interrupted) {
+                // the value was popped for this task, but the task can't use it. give it back to the next consumer.
+                if (m_value.has_value()) {
+                    m_parent.reoffer(*m_value);
+                }
+
+                throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+            }
+
+            if (!m_value.has_value()) {
+                m_value = m_parent.try_pop();  // woken up by close(), values that were pushed before it are still delivered
+            }
+
+            return std::move(m_value);
+        }
+
+        bool try_complete() noexcept override {
+            m_value = m_parent.pop_value();
+            return m_value.has_value();
+        }
+    };
+}  // namespace concurrencpp::details
+
+namespace concurrencpp {
+    /*
+     * A bounded multi-producer, multi-consumer channel. values are stored in a lock-free ring, so as long as there is room
+     * (or values) pushing (or popping) doesn't take any lock. producers that find the channel full and consumers that find
+     * it empty are suspended, and are resumed inside their resume executors once their operation is completed on their
+     * behalf. The channel must outlive the tasks that wait on it.
+     */
+    template<class type>
+    class channel : public details::channel_base {
+
+        static_assert(std::is_nothrow_move_constructible_v<type>,
+                      "concurrencpp::channel<type> - <<type>> must be nothrow move constructible.");
+
+        friend class details::channel_push_awaiter<type>;
+        friend class details::channel_pop_awaiter<type>;
+
+       private:
+        details::channel_ring<type> m_ring;
+
+        // values that interrupted consumers gave back. they were popped before anything that is still in the ring,
+        // so they are served first. the ring might be full, so they can't simply be pushed back into it.
+        std::mutex m_returned_lock;
+        std::deque<type> m_returned;
+        std::atomic_size_t m_returned_count {0};
+
+        static size_t verify_capacity(size_t capacity) {
+            if (capacity == 0) {
+                throw std::invalid_argument(details::consts::k_channel_invalid_capacity_err_msg);
+            }
+
+            return capacity;
+        }
+
+        bool try_push(type&& value, bool& pushed) noexcept {
+            pushed = m_ring.try_push(value);
+            if (pushed) {
+                on_pushed();
+            }
+
+            return pushed;
+        }
+
+        void reoffer(type& value) {
+            {
+                std::unique_lock<std::mutex> lock(m_returned_lock);
+                m_returned.emplace_back(std::move(value));
+                m_returned_count.fetch_add(1, std::memory_order_release);
+            }
+
+            on_pushed();
+        }
+
+        std::optional<type> pop_value() noexcept {
+            if (m_returned_count.load(std::memory_order_acquire) != 0) {
+                std::unique_lock<std::mutex> lock(m_returned_lock);
+                if (!m_returned.empty()) {
+                    std::optional<type> value(std::move(m_returned.front()));
+                    m_returned.pop_front();
+                    m_returned_count.fetch_sub(1, std::memory_order_relaxed);
+                    return value;
+                }
+            }
+
+            return m_ring.try_pop();
+        }
+
+        lazy_result<std::vector<type>> pop_many_impl(std::shared_ptr<executor> resume_executor, size_t max_count) {
+            std::vector<type> values;
+
+            auto first = co_await pop(std::move(resume_executor));
+            if (!first.has_value()) {
+                co_return values;  // closed and drained
+            }
+
+            values.emplace_back(std::move(*first));
+            try_pop_many(values, max_count - 1);
+            co_return values;
+        }
+
+       public:
+        explicit channel(size_t capacity) : m_ring(verify_capacity(capacity)) {}
+
+        details::channel_push_awaiter<type> push(std::shared_ptr<executor> resume_executor, type value) {
+            if (!static_cast<bool>(resume_executor)) {
+                throw std::invalid_argument(details::consts::k_channel_push_null_resume_executor_err_msg);
+            }
+
+            return {*this, std::move(resume_executor), std::move(value)};
+        }
+
+        details::channel_pop_awaiter<type> pop(std::shared_ptr<executor> resume_executor) {
+            if (!static_cast<bool>(resume_executor)) {
+                throw std::invalid_argument(details::consts::k_channel_pop_null_resume_executor_err_msg);
+            }
+
+            return {*this, std::move(resume_executor)};
+        }
+
+        lazy_result<std::vector<type>> pop_many(std::shared_ptr<executor> resume_executor, size_t max_count) {
+            if (!static_cast<bool>(resume_executor)) {
+                throw std::invalid_argument(details::consts::k_channel_pop_many_null_resume_executor_err_msg);
+            }
+
+            if (max_count == 0) {
+                throw std::invalid_argument(details::consts::k_channel_pop_many_invalid_max_count_err_msg);
+            }
+
+            return pop_many_impl(std::move(resume_executor), max_count);
+        }
+
+        // value is moved from only if it was pushed.
+        bool try_push(type&& value) noexcept {
+            auto pushed = false;
+            return !closed() && try_push(std::move(value), pushed);
+        }
+
+        bool try_push(const type& value) {
+            type copy(value);
+            return try_push(std::move(copy));
+        }
+
+        std::optional<type> try_pop() noexcept {
+            auto value = pop_value();
+            if (value.has_value()) {
+                on_popped();
+            }
+
+            return value;
+        }
+
+        size_t try_pop_many(std::vector<type>& values, size_t max_count) {
+            // make room upfront, a popped value must not be lost to a failed allocation.
+            const auto available = capacity() + m_returned_count.load(std::memory_order_relaxed);
+            values.reserve(values.size() + (std::min)(max_count, available));
+
+            size_t count = 0;
+            for (; count < max_count && values.size() < values.capacity(); count++) {
+                auto value = pop_value();
+                if (!value.has_value()) {
+                    break;
+                }
+
+                values.emplace_back(std::move(*value));
+            }
+
+            if (count != 0) {
+                on_popped();
+            }
+
+            return count;
+        }
+
+        size_t capacity() const noexcept {
+            return m_ring.capacity();
+        }
+    };
+}  // namespace concurrencpp
+
+#endif
@@ -26,6 +26,52 @@ namespace concurrencpp::details::consts {
     inline const char* k_async_condition_variable_await_lock_unlocked_err_msg =
         "async_condition_variable::await() - lock is unlocked.";
 
+    inline const char* k_async_shared_mutex_lock_null_resume_executor_err_msg =
+        "async_shared_mutex::lock() - given resume executor is null.";
+
+    inline const char* k_async_shared_mutex_lock_shared_null_resume_executor_err_msg =
+        "async_shared_mutex::lock_shared() - given resume executor is null.";
+
+    inline const char* k_async_shared_mutex_unlock_invalid_lock_err_msg =
+        "async_shared_mutex::unlock() - trying to unlock an unowned mutex.";
+
+    inline const char* k_scoped_async_shared_lock_unlock_invalid_lock_err_msg =
+        "scoped_async_shared_lock::unlock() - trying to unlock an unowned mutex.";
+
+    inline const char* k_scoped_async_exclusive_lock_unlock_invalid_lock_err_msg =
+        "scoped_async_exclusive_lock::unlock() - trying to unlock an unowned mutex.";
+    inline const char* k_async_semaphore_acquire_null_resume_executor_err_msg =
+        "async_semaphore::acquire() - given resume executor is null.";
+
+    inline const char* k_async_manual_reset_event_wait_null_resume_executor_err_msg =
+        "async_manual_reset_event::wait() - given resume executor is null.";
+
+    inline const char* k_async_latch_wait_null_resume_executor_err_msg = "async_latch::wait() - given resume executor is null.";
+
+    inline const char* k_async_latch_arrive_and_wait_null_resume_executor_err_msg =
+        "async_latch::arrive_and_wait() - given resume executor is null.";
+
+    inline const char* k_async_latch_count_down_invalid_update_err_msg =
+        "async_latch::count_down() - update is greater than the internal counter.";
+
+    inline const char* k_async_barrier_invalid_expected_err_msg = "async_barrier::async_barrier() - expected is 0.";
+
+    inline const char* k_async_barrier_arrive_and_wait_null_resume_executor_err_msg =
+        "async_barrier::arrive_and_wait() - given resume executor is null.";
+
+    inline const char* k_async_barrier_arrive_no_participants_err_msg =
+        "async_barrier::arrive() - all the participants of the current phase have already arrived.";
+
+    inline const char* k_channel_invalid_capacity_err_msg = "channel::channel() - capacity is 0.";
+
+    inline const char* k_channel_push_null_resume_executor_err_msg = "channel::push() - given resume executor is null.";
+
+    inline const char* k_channel_pop_null_resume_executor_err_msg = "channel::pop() - given resume executor is null.";
+
+    inline const char* k_channel_pop_many_null_resume_executor_err_msg = "channel::pop_many() - given resume executor is null.";
+
+    inline const char* k_channel_pop_many_invalid_max_count_err_msg = "channel::pop_many() - max_count is 0.";
+
 }  // namespace concurrencpp::details::consts
 
 #endif
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef CONCURRENCPP_TIMER_CONSTS_H
 #define CONCURRENCPP_TIMER_CONSTS_H
 
+#include <chrono>
+
 namespace concurrencpp::details::consts {
     inline const char* k_timer_empty_get_due_time_err_msg = "timer::get_due_time() - timer is empty.";
     inline const char* k_timer_empty_get_frequency_err_msg = "timer::get_frequency() - timer is empty.";
@@ -12,7 +14,31 @@ namespace concurrencpp::details::consts {
     inline const char* k_timer_queue_make_oneshot_timer_executor_null_err_msg =
         "timer_queue::make_one_shot_timer() - executor is null.";
     inline const char* k_timer_queue_make_delay_object_executor_null_err_msg = "timer_queue::make_delay_object() - executor is null.";
+    inline const char* k_timer_queue_sleep_for_executor_null_err_msg = "timer_queue::sleep_for() - executor is null.";
+    inline const char* k_timer_queue_sleep_until_executor_null_err_msg = "timer_queue::sleep_until() - executor is null.";
     inline const char* k_timer_queue_shutdown_err_msg = "timer_queue has been shut down.";
+    inline const char* k_timer_queue_advance_to_not_virtual_err_msg = "timer_queue::advance_to() - timer_queue does not use virtual time.";
+    inline const char* k_timer_queue_advance_by_not_virtual_err_msg = "timer_queue::advance_by() - timer_queue does not use virtual time.";
+    inline const char* k_timer_queue_next_deadline_not_virtual_err_msg =
+        "timer_queue::next_deadline() - timer_queue does not use virtual time.";
+    inline const char* k_timer_queue_advance_reentrancy_err_msg =
+        "timer_queue - virtual time can't be advanced from inside a timer that is being fired.";
+
+    inline const char* k_rate_limiter_null_timer_queue_err_msg = "rate_limiter::rate_limiter() - timer_queue is null.";
+    inline const char* k_rate_limiter_invalid_rate_err_msg = "rate_limiter::rate_limiter() - permits_per_second is out of range.";
+    inline const char* k_rate_limiter_invalid_burst_err_msg = "rate_limiter::rate_limiter() - max_burst is 0.";
+    inline const char* k_rate_limiter_acquire_null_executor_err_msg = "rate_limiter::acquire() - resume executor is null.";
+    inline const char* k_rate_limiter_acquire_invalid_count_err_msg = "rate_limiter::acquire() - count is bigger than max_burst.";
+
+    inline const char* k_retry_null_executor_err_msg = "concurrencpp::retry() - executor is null.";
+    inline const char* k_retry_null_timer_queue_err_msg = "concurrencpp::retry() - timer_queue is null.";
+    inline const char* k_retry_invalid_max_attempts_err_msg = "concurrencpp::retry() - retry_policy::max_attempts is 0.";
+    inline const char* k_retry_invalid_delay_err_msg = "concurrencpp::retry() - retry_policy delays can't be negative.";
+    inline const char* k_retry_invalid_multiplier_err_msg = "concurrencpp::retry() - retry_policy::multiplier is smaller than 1.";
+    inline const char* k_retry_invalid_jitter_err_msg = "concurrencpp::retry() - retry_policy::jitter is not in the range [0, 1].";
+
+    // waiting coroutines are woken up at most once per this interval, and receive all the permits accumulated meanwhile.
+    constexpr std::chrono::milliseconds k_rate_limiter_min_wake_interval {1};
 }  // namespace concurrencpp::details::consts
 
 #endif
@@ -0,0 +1,99 @@
+#ifndef CONCURRENCPP_RATE_LIMITER_H
+#define CONCURRENCPP_RATE_LIMITER_H
+
+#include "concurrencpp/timers/timer.h"
+#include "concurrencpp/platform_defs.h"
+#include "concurrencpp/coroutines/coroutine.h"
+#include "concurrencpp/forward_declarations.h"
+
+#include <mutex>
+#include <memory>
+#include <chrono>
+
+namespace concurrencpp::details {
+    /*
+     * A coroutine waiting for permits. waiters are queued in FIFO order, and only the first one is linked into the
+     * timer_queue: when it fires, it hands the accumulated permits to as many waiters as it can, then the new first waiter
+     * is linked in its place. this way, no matter how many coroutines wait, the timer_queue holds a single node.
+     */
+    class CRCPP_API rate_limiter_awaiter final : public timer_node {
+
+        friend class concurrencpp::rate_limiter;
+
+       private:
+        rate_limiter& m_parent;
+        const size_t m_count;
+        std::shared_ptr<concurrencpp::executor> m_resume_executor;
+        coroutine_handle<void> m_caller_handle;
+        rate_limiter_awaiter* m_next_waiter = nullptr;
+        bool m_interrupted = false;
+
+        void resume(task_batch& batch) noexcept;
+
+       public:
+        rate_limiter_awaiter(rate_limiter& parent, size_t count, std::shared_ptr<concurrencpp::executor> resume_executor) noexcept;
+
+        constexpr bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(coroutine_handle<void> caller_handle) noexcept;
+        void await_resume() const;
+
+        void fire(task_batch& batch) noexcept override;
+        void interrupt() noexcept override;
+    };
+}  // namespace concurrencpp::details
+
+namespace concurrencpp {
+    /*
+     * A token bucket: permits are refilled at a constant rate, up to max_burst permits.
+     * Coroutines that await permits are parked on the timer_queue, they don't spin or block.
+     * The rate_limiter must outlive the coroutines that wait on it.
+     */
+    class CRCPP_API rate_limiter {
+
+        friend class details::rate_limiter_awaiter;
+
+       public:
+        using clock_type = details::timer_node::clock_type;
+        using time_point = details::timer_node::time_point;
+
+       private:
+        const std::shared_ptr<timer_queue> m_timer_queue;
+        const time_point::duration m_permit_period;
+        const size_t m_max_burst;
+
+        std::mutex m_lock;
+        size_t m_permits;
+        time_point m_last_refill;
+        details::rate_limiter_awaiter* m_head = nullptr;
+        details::rate_limiter_awaiter* m_tail = nullptr;
+
+        static time_point::duration make_permit_period(size_t permits_per_second);
+
+        void refill(time_point now) noexcept;
+        bool try_take(size_t count, time_point now) noexcept;
+        bool arm_head(time_point now) noexcept;
+
+        bool enqueue_waiter(details::rate_limiter_awaiter& waiter) noexcept;
+        void on_head_fired(details::rate_limiter_awaiter& head, details::task_batch& batch) noexcept;
+        void on_head_interrupted() noexcept;
+
+        static void interrupt_all(details::rate_limiter_awaiter* waiters) noexcept;
+
+       public:
+        rate_limiter(std::shared_ptr<timer_queue> timer_queue, size_t permits_per_second, size_t max_burst);
+
+        rate_limiter(const rate_limiter&) = delete;
+        rate_limiter(rate_limiter&&) = delete;
+
+        details::rate_limiter_awaiter acquire(std::shared_ptr<executor> resume_executor, size_t count = 1);
+        bool try_acquire(size_t count = 1);
+
+        size_t available_permits();
+        size_t max_burst() const noexcept;
+    };
+}  // namespace concurrencpp
+
+#endif
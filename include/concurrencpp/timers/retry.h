@@ -0,0 +1,97 @@
+#ifndef CONCURRENCPP_RETRY_H
+#define CONCURRENCPP_RETRY_H
+
+#include "concurrencpp/timers/timer_queue.h"
+#include "concurrencpp/results/result.h"
+#include "concurrencpp/results/lazy_result.h"
+#include "concurrencpp/results/impl/awaitable_traits.h"
+#include "concurrencpp/forward_declarations.h"
+#include "concurrencpp/platform_defs.h"
+
+#include <memory>
+#include <chrono>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+namespace concurrencpp {
+    struct retry_policy {
+        size_t max_attempts = 5;  // including the first attempt
+        std::chrono::milliseconds initial_delay {100};
+        std::chrono::milliseconds max_delay {10'000};
+        double multiplier = 2.0;
+        double jitter = 1.0;  // 0 - no jitter, 1 - the delay is picked uniformly from (0, backoff]
+    };
+}  // namespace concurrencpp
+
+namespace concurrencpp::details {
+    CRCPP_API void validate_retry_policy(const retry_policy& policy);
+    CRCPP_API std::chrono::milliseconds retry_backoff_delay(const retry_policy& policy, size_t attempt);
+
+    template<class callable_type>
+    lazy_result<typename callable_awaitable_traits<callable_type>::value_type> retry_impl(retry_policy policy,
+                                                                                     std::shared_ptr<executor> executor,
+                                                                                     std::shared_ptr<timer_queue> timer_queue,
+                                                                                     callable_type callable) {
+        using traits = callable_awaitable_traits<callable_type>;
+        using value_type = typename traits::value_type;
+
+        for (size_t attempt = 1;; ++attempt) {
+            try {
+                if constexpr (traits::is_awaitable) {
+                    if constexpr (std::is_same_v<value_type, void>) {
+                        co_await std::invoke(callable);
+                        co_return;
+                    } else {
+                        co_return co_await std::invoke(callable);
+                    }
+                } else {
+                    if constexpr (std::is_same_v<value_type, void>) {
+                        std::invoke(callable);
+                        co_return;
+                    } else {
+                        co_return std::invoke(callable);
+                    }
+                }
+            } catch (...) {
+                if (attempt >= policy.max_attempts) {
+                    throw;
+                }
+            }
+
+            co_await timer_queue->sleep_for(retry_backoff_delay(policy, attempt), executor);
+        }
+    }
+}  // namespace concurrencpp::details
+
+namespace concurrencpp {
+    /*
+     * Invokes callable until it succeeds or policy.max_attempts attempts have failed, in which case the last exception is
+     * rethrown. between attempts, the coroutine sleeps on timer_queue for a jittered, exponentially growing delay and is
+     * resumed by executor. if callable returns a result or a lazy_result, it is awaited and its exception counts as a failure.
+     * the first attempt runs when the returned lazy_result is awaited or run.
+     */
+    template<class callable_type>
+    lazy_result<typename details::callable_awaitable_traits<std::decay_t<callable_type>>::value_type> retry(
+        const retry_policy& policy,
+        std::shared_ptr<executor> executor,
+        std::shared_ptr<timer_queue> timer_queue,
+        callable_type&& callable) {
+        if (!static_cast<bool>(executor)) {
+            throw std::invalid_argument(details::consts::k_retry_null_executor_err_msg);
+        }
+
+        if (!static_cast<bool>(timer_queue)) {
+            throw std::invalid_argument(details::consts::k_retry_null_timer_queue_err_msg);
+        }
+
+        details::validate_retry_policy(policy);
+
+        return details::retry_impl<std::decay_t<callable_type>>(policy,
+                                                                std::move(executor),
+                                                                std::move(timer_queue),
+                                                                std::forward<callable_type>(callable));
+    }
+}  // namespace concurrencpp
+
+#endif
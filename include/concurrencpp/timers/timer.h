@@ -9,7 +9,43 @@
 #include <chrono>
 
 namespace concurrencpp::details {
-    class CRCPP_API timer_state_base : public std::enable_shared_from_this<timer_state_base> {
+    class task_batch;
+
+    /*
+     * An intrusive, one-shot timer. unlike timer_state_base, a timer_node is not reference counted nor allocated by the
+     * timer_queue: it lives inside its owner (usually an awaitable that lives in a coroutine frame) and is linked directly
+     * into the timer_queue. the owner must keep the node alive until it's fired, interrupted or removed from the queue.
+     */
+    class CRCPP_API timer_node {
+
+       public:
+        using clock_type = std::chrono::high_resolution_clock;
+        using time_point = std::chrono::time_point<clock_type>;
+
+        static constexpr size_t k_not_queued = static_cast<size_t>(-1);
+
+       protected:
+        ~timer_node() noexcept = default;
+
+       public:
+        time_point deadline;  // may only be changed while the node is not linked to a timer_queue.
+        size_t queue_index = k_not_queued;  // guarded by the lock of the timer_queue this node is linked to.
+        timer_node* next = nullptr;
+
+        timer_node(time_point deadline) noexcept : deadline(deadline) {}
+
+        timer_node(const timer_node&) = delete;
+        timer_node(timer_node&&) = delete;
+
+        // called by the timer_queue thread once the deadline has been reached. tasks added to batch are submitted
+        // together with the tasks of every other timer that expired at the same time.
+        virtual void fire(task_batch& batch) noexcept = 0;
+
+        // called when the timer_queue is shut down before the deadline has been reached.
+        virtual void interrupt() noexcept = 0;
+    };
+
+    class CRCPP_API timer_state_base {
 
        public:
         using clock_type = std::chrono::high_resolution_clock;
@@ -25,8 +61,8 @@ namespace concurrencpp::details {
         std::atomic_bool m_cancelled;
         const bool m_is_oneshot;
 
-        static time_point make_deadline(milliseconds diff) noexcept {
-            return clock_type::now() + diff;
+        static time_point make_deadline(time_point now, milliseconds diff) noexcept {
+            return now + diff;
         }
 
        public:
@@ -34,13 +70,16 @@ namespace concurrencpp::details {
                          size_t frequency,
                          std::shared_ptr<concurrencpp::executor> executor,
                          std::weak_ptr<concurrencpp::timer_queue> timer_queue,
-                         bool is_oneshot) noexcept;
+                         bool is_oneshot,
+                         time_point now) noexcept;
 
         virtual ~timer_state_base() noexcept = default;
 
         virtual void execute() = 0;
 
-        void fire();
+        // called by the timer_queue when the timer is fired, before execute is scheduled. now is the current time of the
+        // timer_queue, which might be virtual.
+        void update_deadline(time_point now) noexcept;
 
         bool expired(const time_point now) const noexcept {
             return m_deadline <= now;
@@ -62,7 +101,7 @@ namespace concurrencpp::details {
             return m_is_oneshot;
         }
 
-        std::shared_ptr<executor> get_executor() const noexcept {
+        const std::shared_ptr<executor>& get_executor() const noexcept {
             return m_executor;
         }
 
@@ -96,8 +135,9 @@ namespace concurrencpp::details {
                     std::shared_ptr<concurrencpp::executor> executor,
                     std::weak_ptr<concurrencpp::timer_queue> timer_queue,
                     bool is_oneshot,
+                    time_point now,
                     given_callable_type&& callable) :
-            timer_state_base(due_time, frequency, std::move(executor), std::move(timer_queue), is_oneshot),
+            timer_state_base(due_time, frequency, std::move(executor), std::move(timer_queue), is_oneshot, now),
             m_callable(std::forward<given_callable_type>(callable)) {}
 
         void execute() override {
@@ -3,8 +3,10 @@
 
 #include "timer.h"
 #include "constants.h"
+#include "concurrencpp/task.h"
 #include "concurrencpp/errors.h"
 #include "concurrencpp/utils/bind.h"
+#include "concurrencpp/utils/slist.h"
 #include "concurrencpp/threads/thread.h"
 #include "concurrencpp/results/lazy_result.h"
 
@@ -18,9 +20,67 @@
 
 namespace concurrencpp::details {
     enum class timer_request { add, remove };
-}
+
+    class timed_await_context;
+    class timer_queue_internal;
+
+    // a binary min-heap of intrusive timer nodes, ordered by deadline. each node remembers its position, so nodes can be
+    // removed in logarithmic time.
+    class CRCPP_API timer_node_heap {
+
+       private:
+        std::vector<timer_node*> m_nodes;
+
+        void place(timer_node* node, size_t index) noexcept;
+        void sift_up(size_t index) noexcept;
+        void sift_down(size_t index) noexcept;
+
+       public:
+        bool empty() const noexcept {
+            return m_nodes.empty();
+        }
+
+        timer_node* top() const noexcept {
+            assert(!m_nodes.empty());
+            return m_nodes.front();
+        }
+
+        void push(timer_node& node);
+        bool remove(timer_node& node) noexcept;
+        void pop_expired(timer_node::time_point now, slist<timer_node>& expired) noexcept;
+        void pop_all(slist<timer_node>& nodes) noexcept;
+    };
+
+    class CRCPP_API sleep_awaitable final : public timer_node {
+
+       private:
+        timer_queue& m_parent_queue;
+        std::shared_ptr<concurrencpp::executor> m_executor;
+        coroutine_handle<void> m_caller_handle;
+        std::exception_ptr m_exception;
+        bool m_interrupted = false;
+
+       public:
+        sleep_awaitable(timer_queue& parent_queue, time_point deadline, std::shared_ptr<concurrencpp::executor> executor) noexcept;
+
+        constexpr bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(coroutine_handle<void> caller_handle) noexcept;
+        void await_resume() const;
+
+        void fire(task_batch& batch) noexcept override;
+
+        // resumes the sleeping coroutine inline, on the thread that called timer_queue::shutdown.
+        void interrupt() noexcept override;
+    };
+}  // namespace concurrencpp::details
 
 namespace concurrencpp {
+    // selects a timer_queue whose clock is virtual: time does not pass by itself, it's moved by timer_queue::advance_to.
+    struct virtual_time_tag {};
+
     class CRCPP_API timer_queue : public std::enable_shared_from_this<timer_queue> {
 
        public:
@@ -30,24 +90,41 @@ namespace concurrencpp {
         using request_queue = std::vector<std::pair<timer_ptr, details::timer_request>>;
 
         friend class concurrencpp::timer;
+        friend class details::sleep_awaitable;
+        friend class details::timed_await_context;
+        friend class concurrencpp::rate_limiter;
 
        private:
         std::atomic_bool m_atomic_abort;
         std::mutex m_lock;
         request_queue m_request_queue;
+        details::timer_node_heap m_timer_nodes;
+        bool m_nearest_deadline_changed;
         details::thread m_worker;
         std::condition_variable m_condition;
         bool m_abort;
         bool m_idle;
         const std::chrono::milliseconds m_max_waiting_time;
 
+        // virtual time. timers of a virtual timer_queue are processed by the thread which advances time, not by a worker.
+        const bool m_virtual_time;
+        std::atomic<time_point> m_virtual_now;
+        std::mutex m_advance_lock;
+        std::atomic<std::uintptr_t> m_advancing_thread_id;
+        std::unique_ptr<details::timer_queue_internal> m_virtual_timers;
+
         details::thread ensure_worker_thread(std::unique_lock<std::mutex>& lock);
 
+        time_point next_deadline_impl();
+
         void add_internal_timer(std::unique_lock<std::mutex>& lock, timer_ptr new_timer);
         void remove_internal_timer(timer_ptr existing_timer);
 
         void add_timer(std::unique_lock<std::mutex>& lock, timer_ptr new_timer);
 
+        void add_timer_node(details::timer_node& node);
+        bool remove_timer_node(details::timer_node& node) noexcept;
+
         lazy_result<void> make_delay_object_impl(std::chrono::milliseconds due_time,
                                                  std::shared_ptr<concurrencpp::timer_queue> self,
                                                  std::shared_ptr<concurrencpp::executor> executor);
@@ -67,6 +144,7 @@ namespace concurrencpp {
                                                                                     std::move(executor),
                                                                                     weak_from_this(),
                                                                                     is_oneshot,
+                                                                                    now(),
                                                                                     std::forward<callable_type>(callable));
             {
                 std::unique_lock<std::mutex> lock(m_lock);
@@ -80,6 +158,7 @@ namespace concurrencpp {
 
        public:
         timer_queue(std::chrono::milliseconds max_waiting_time);
+        timer_queue(virtual_time_tag, time_point start_time = {});
         ~timer_queue() noexcept;
 
         void shutdown();
@@ -120,7 +199,18 @@ namespace concurrencpp {
 
         lazy_result<void> make_delay_object(std::chrono::milliseconds due_time, std::shared_ptr<concurrencpp::executor> executor);
 
+        details::sleep_awaitable sleep_for(std::chrono::milliseconds due_time, std::shared_ptr<concurrencpp::executor> executor);
+        details::sleep_awaitable sleep_until(time_point deadline, std::shared_ptr<concurrencpp::executor> executor);
+
         std::chrono::milliseconds max_worker_idle_time() const noexcept;
+
+        bool uses_virtual_time() const noexcept;
+        time_point now() const noexcept;
+
+        // virtual time only. these must not be called from inside a timer (or a task) they fire.
+        size_t advance_to(time_point new_now);
+        size_t advance_by(std::chrono::milliseconds duration);
+        time_point next_deadline();
     };
 }  // namespace concurrencpp
 
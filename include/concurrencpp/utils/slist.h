@@ -45,6 +45,35 @@ namespace concurrencpp::details {
             m_tail = &node;
         }
 
+        void push_front(node_type& node) noexcept {
+            assert_state();
+
+            if (m_head == nullptr) {
+                m_head = m_tail = &node;
+                return;
+            }
+
+            node.next = m_head;
+            m_head = &node;
+        }
+
+        void insert_after(node_type& position, node_type& node) noexcept {
+            assert_state();
+            assert(m_head != nullptr);
+
+            node.next = position.next;
+            position.next = &node;
+
+            if (m_tail == &position) {
+                m_tail = &node;
+            }
+        }
+
+        node_type* front() const noexcept {
+            assert_state();
+            return m_head;
+        }
+
         node_type* pop_front() noexcept {
             assert_state();
             const auto node = m_head;
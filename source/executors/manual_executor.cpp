@@ -1,11 +1,34 @@
 #include "concurrencpp/executors/constants.h"
 #include "concurrencpp/executors/manual_executor.h"
+#include "concurrencpp/timers/timer_queue.h"
+
+#include <stdexcept>
 
 using concurrencpp::manual_executor;
 
+namespace concurrencpp::details {
+    namespace {
+        std::shared_ptr<timer_queue> verify_virtual_timer_queue(std::shared_ptr<timer_queue> timer_queue) {
+            if (!static_cast<bool>(timer_queue)) {
+                throw std::invalid_argument(consts::k_manual_executor_null_timer_queue_err_msg);
+            }
+
+            if (!timer_queue->uses_virtual_time()) {
+                throw std::invalid_argument(consts::k_manual_executor_real_time_timer_queue_err_msg);
+            }
+
+            return timer_queue;
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
 manual_executor::manual_executor() :
-    derivable_executor<concurrencpp::manual_executor>(details::consts::k_manual_executor_name), m_abort(false), m_atomic_abort(false) {
-}
+    derivable_executor<concurrencpp::manual_executor>(details::consts::k_manual_executor_name), m_abort(false), m_atomic_abort(false),
+    m_virtual_time(false) {}
+
+manual_executor::manual_executor(std::shared_ptr<timer_queue> virtual_timer_queue) :
+    derivable_executor<concurrencpp::manual_executor>(details::consts::k_manual_executor_name), m_abort(false), m_atomic_abort(false),
+    m_virtual_timer_queue(details::verify_virtual_timer_queue(std::move(virtual_timer_queue))), m_virtual_time(true) {}
 
 void manual_executor::enqueue(concurrencpp::task task) {
     std::unique_lock<decltype(m_lock)> lock(m_lock);
@@ -127,6 +150,89 @@ size_t manual_executor::loop_until_impl(size_t max_count, std::chrono::time_poin
     return executed;
 }
 
+manual_executor::virtual_time_point manual_executor::virtual_now() const {
+    assert(m_virtual_time);
+
+    const auto timer_queue = m_virtual_timer_queue.lock();
+    if (!static_cast<bool>(timer_queue)) {
+        return {};  // the timer_queue is gone, nothing will ever be due again.
+    }
+
+    return timer_queue->now();
+}
+
+bool manual_executor::loop_once_until(virtual_time_tag, virtual_time_point timeout_time) {
+    return loop_until(1, virtual_time_tag {}, timeout_time) == 1;
+}
+
+size_t manual_executor::loop_until(size_t max_count, virtual_time_tag, virtual_time_point timeout_time) {
+    if (!m_virtual_time) {
+        throw std::logic_error(details::consts::k_manual_executor_not_virtual_err_msg);
+    }
+
+    return loop_until_virtual_impl(max_count, timeout_time);
+}
+
+size_t manual_executor::loop_until_virtual_impl(size_t max_count, virtual_time_point deadline) {
+    if (max_count == 0) {
+        return 0;
+    }
+
+    size_t executed = 0;
+
+    /*
+     * tasks are executed without letting time pass. only when the executor is idle, the virtual clock is moved to the
+     * next timer deadline and the due timers are fired (which usually enqueue new tasks to *this). nothing here blocks.
+     */
+    while (executed != max_count) {
+        std::unique_lock<decltype(m_lock)> lock(m_lock);
+        if (m_abort) {
+            break;
+        }
+
+        if (m_tasks.empty()) {
+            lock.unlock();
+
+            const auto timer_queue = m_virtual_timer_queue.lock();
+            if (!static_cast<bool>(timer_queue)) {
+                break;
+            }
+
+            const auto next_deadline = timer_queue->next_deadline();
+            if (next_deadline > deadline || next_deadline == virtual_time_point::max()) {
+                // no timer is due before an unbounded deadline: there's nothing to fire and no point in time to move to.
+                if (deadline == virtual_time_point::max()) {
+                    break;
+                }
+
+                timer_queue->advance_to(deadline);
+
+                if (empty()) {
+                    break;
+                }
+
+                continue;  // the timer_queue might have been advanced up to deadline by some other thread
+            }
+
+            timer_queue->advance_to(next_deadline);
+            continue;
+        }
+
+        auto task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        lock.unlock();
+
+        task();
+        ++executed;
+    }
+
+    if (shutdown_requested()) {
+        details::throw_runtime_shutdown_exception(name);
+    }
+
+    return executed;
+}
+
 void manual_executor::wait_for_tasks_impl(size_t count) {
     if (count == 0) {
         if (shutdown_requested()) {
@@ -167,6 +273,10 @@ bool manual_executor::loop_once() {
 }
 
 bool manual_executor::loop_once_for(std::chrono::milliseconds max_waiting_time) {
+    if (m_virtual_time) {
+        return loop_until_virtual_impl(1, virtual_now() + max_waiting_time);
+    }
+
     if (max_waiting_time == std::chrono::milliseconds(0)) {
         return loop_impl(1) != 0;
     }
@@ -183,6 +293,10 @@ size_t manual_executor::loop_for(size_t max_count, std::chrono::milliseconds max
         return 0;
     }
 
+    if (m_virtual_time) {
+        return loop_until_virtual_impl(max_count, virtual_now() + max_waiting_time);
+    }
+
     if (max_waiting_time == std::chrono::milliseconds(0)) {
         return loop_impl(max_count);
     }
@@ -0,0 +1,135 @@
+#include "concurrencpp/executors/executor.h"
+#include "concurrencpp/executors/task_batch.h"
+#include "concurrencpp/results/impl/consumer_context.h"
+
+#include <span>
+#include <utility>
+#include <algorithm>
+
+#include <cassert>
+
+using concurrencpp::task;
+using concurrencpp::details::task_batch;
+using concurrencpp::details::await_via_functor;
+
+namespace concurrencpp::details {
+    namespace {
+        // buffers that grew bigger than this aren't kept by the per-thread cache once their batch is destroyed.
+        constexpr size_t k_max_cached_tasks = 1'024;
+    }  // namespace
+}  // namespace concurrencpp::details
+
+std::vector<task_batch::executor_batch>* task_batch::thread_cached_batches() noexcept {
+    /*
+     * the buffers of the last batch that was destroyed on this thread. a batch that is created while another one is
+     * alive on the same thread (e.g. a coroutine resumed inline by a batch releases a semaphore) finds the cache empty
+     * and allocates its own buffers. batches destroyed after the thread's cache (e.g. by static destructors) skip it.
+     */
+    static thread_local bool cache_destroyed = false;
+    if (cache_destroyed) {
+        return nullptr;
+    }
+
+    struct batch_cache {
+        std::vector<executor_batch> batches;
+
+        ~batch_cache() noexcept {
+            cache_destroyed = true;
+        }
+    };
+
+    static thread_local batch_cache cache;
+    return &cache.batches;
+}
+
+task_batch::task_batch() noexcept {
+    if (const auto cached_batches = thread_cached_batches(); cached_batches != nullptr) {
+        m_batches = std::exchange(*cached_batches, {});
+    }
+}
+
+task_batch::~task_batch() noexcept {
+    // a batch that wasn't submitted (an exception was thrown) drops its tasks and keeps its buffers to itself.
+    if (!empty()) {
+        return;
+    }
+
+    const auto cached_batches = thread_cached_batches();
+    if (cached_batches == nullptr || !cached_batches->empty() || m_batches.empty()) {
+        return;
+    }
+
+    for (auto& batch : m_batches) {
+        if (batch.tasks.capacity() > k_max_cached_tasks) {
+            decltype(batch.tasks) tasks;
+            std::swap(batch.tasks, tasks);
+        }
+    }
+
+    *cached_batches = std::move(m_batches);
+}
+
+std::vector<task>& task_batch::reserve_task(const std::shared_ptr<concurrencpp::executor>& executor) {
+    assert(static_cast<bool>(executor));
+
+    // the number of distinct executors tasks are posted to is usually tiny
+    auto batch = m_batches.begin();
+    const auto active_end = m_batches.begin() + m_active_batches;
+    while (batch != active_end && batch->executor != executor) {
+        ++batch;
+    }
+
+    if (batch == active_end) {
+        if (m_active_batches == m_batches.size()) {
+            m_batches.emplace_back();
+        }
+
+        batch = m_batches.begin() + m_active_batches;
+    }
+
+    auto& tasks = batch->tasks;
+    if (tasks.size() == tasks.capacity()) {
+        tasks.reserve(std::max<size_t>(tasks.capacity() * 2, 8));
+    }
+
+    if (batch->executor == nullptr) {
+        batch->executor = executor;
+        ++m_active_batches;
+    }
+
+    return tasks;
+}
+
+void task_batch::add(const std::shared_ptr<concurrencpp::executor>& executor, task task) {
+    reserve_task(executor).emplace_back(std::move(task));
+}
+
+void task_batch::add(const std::shared_ptr<concurrencpp::executor>& executor,
+                     coroutine_handle<void> caller_handle,
+                     bool* interrupted) {
+    // the functor is built only once there's room for it, so a failure can't resume the coroutine.
+    reserve_task(executor).emplace_back(await_via_functor {caller_handle, interrupted});
+}
+
+void task_batch::submit() noexcept {
+    for (size_t i = 0; i < m_active_batches; i++) {
+        auto& batch = m_batches[i];
+
+        try {
+            batch.executor->enqueue(std::span<task> {batch.tasks});
+        } catch (...) {
+            // the executor was shut down, the tasks it didn't consume are dropped like any task posted to it.
+        }
+
+        batch.tasks.clear();
+        batch.executor.reset();
+    }
+
+    m_active_batches = 0;
+}
+
+void task_batch::reset_memory() noexcept {
+    assert(m_active_batches == 0);
+    decltype(m_batches) batches;
+    std::swap(m_batches, batches);
+}
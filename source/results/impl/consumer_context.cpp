@@ -1,11 +1,14 @@
 #include "concurrencpp/results/impl/consumer_context.h"
+#include "concurrencpp/results/impl/result_continuation.h"
 
 #include "concurrencpp/executors/executor.h"
+#include "concurrencpp/threads/atomic_wait.h"
 
 using concurrencpp::details::when_any_context;
 using concurrencpp::details::consumer_context;
 using concurrencpp::details::await_via_functor;
 using concurrencpp::details::result_state_base;
+using concurrencpp::details::coroutine_handle;
 
 namespace concurrencpp::details {
     namespace {
@@ -64,9 +67,12 @@ void await_via_functor::operator()() noexcept {
 const result_state_base* when_any_context::k_processing = reinterpret_cast<result_state_base*>(-1);
 const result_state_base* when_any_context::k_done_processing = nullptr;
 
-when_any_context::when_any_context(coroutine_handle<void> coro_handle) noexcept : m_status(k_processing), m_coro_handle(coro_handle) {
+when_any_context::when_any_context() noexcept : m_status(k_processing), m_finished_producers(0) {}
+
+void when_any_context::set_coro_handle(coroutine_handle<void> coro_handle) noexcept {
     assert(static_cast<bool>(coro_handle));
     assert(!coro_handle.done());
+    m_coro_handle = coro_handle;  // published to the producers by the CAS that registers this context
 }
 
 bool when_any_context::any_result_finished() const noexcept {
@@ -84,7 +90,19 @@ bool when_any_context::finish_processing() noexcept {
     return res;  // if k_processing -> k_done_processing, then no result finished before the CAS, suspend.
 }
 
-void when_any_context::try_resume(result_state_base& completed_result) noexcept {
+coroutine_handle<void> when_any_context::try_resume(result_state_base& completed_result) noexcept {
+    const auto coro_handle = try_resume_impl(completed_result);
+
+    // the last access of a producer to this context, the when_any frame may be destroyed right after it (waking up an
+    // address that is gone is harmless, see atomic_wait.h).
+    if ((m_finished_producers.fetch_add(1, std::memory_order_acq_rel) & k_consumer_waiting) != 0) {
+        details::atomic_notify_one(&m_finished_producers);
+    }
+
+    return coro_handle;
+}
+
+coroutine_handle<void> when_any_context::try_resume_impl(result_state_base& completed_result) noexcept {
     /*
      * tries to turn m_status into the completed_result ptr
      * if m_status == k_processing, we just leave the pointer and bail out, the processor thread will pick
@@ -97,26 +115,25 @@ void when_any_context::try_resume(result_state_base& completed_result) noexcept
     while (true) {
         auto status = m_status.load(std::memory_order_acquire);
         if (status != k_processing && status != k_done_processing) {
-            return;  // another task finished before us, bail out
+            return {};  // another task finished before us, bail out
         }
 
         if (status == k_done_processing) {
             const auto swapped = m_status.compare_exchange_strong(status, &completed_result, std::memory_order_acq_rel);
 
             if (!swapped) {
-                return;  // another task finished before us, bail out
+                return {};  // another task finished before us, bail out
             }
 
             // k_done_processing -> result_state_base ptr, we are the first to finish and CAS the status
-            m_coro_handle();
-            return;
+            return m_coro_handle;
         }
 
         assert(status == k_processing);
         const auto res = m_status.compare_exchange_strong(status, &completed_result, std::memory_order_acq_rel);
 
         if (res) {  // k_processing -> completed result_state_base*
-            return;
+            return {};
         }
 
         // either another result raced us, either m_status is now k_done_processing, retry and act accordingly
@@ -142,6 +159,30 @@ const result_state_base* when_any_context::completed_result() const noexcept {
     return m_status.load(std::memory_order_acquire);
 }
 
+void when_any_context::wait_for_producers(size_t producer_count) noexcept {
+    /*
+     * every producer counted here has already published its result and is inside try_resume: it is at most a load, two
+     * CASs and the final fetch_add away from being done with this context, and never blocks or suspends on the way.
+     * the spin covers that, a preempted producer is waited for by parking on the counter. the producer that finds
+     * k_consumer_waiting set wakes the consumer up. this is the price of keeping the context in the when_any frame
+     * instead of allocating it.
+     */
+    const auto expected = static_cast<std::int32_t>(producer_count);
+    assert(expected < k_consumer_waiting);
+
+    for (size_t i = 0; i < k_spin_count; i++) {
+        if (m_finished_producers.load(std::memory_order_acquire) == expected) {
+            return;
+        }
+    }
+
+    auto finished = m_finished_producers.fetch_or(k_consumer_waiting, std::memory_order_acq_rel) | k_consumer_waiting;
+    while (finished != (expected | k_consumer_waiting)) {
+        atomic_wait(m_finished_producers, finished);
+        finished = m_finished_producers.load(std::memory_order_acquire);
+    }
+}
+
 /*
  * consumer_context
  */
@@ -160,13 +201,13 @@ void consumer_context::destroy() noexcept {
             return details::destroy(m_storage.caller_handle);
         }
 
-        case consumer_status::wait_for: {
-            return details::destroy(m_storage.wait_for_ctx);
-        }
-
         case consumer_status::when_any: {
             return details::destroy(m_storage.when_any_ctx);
         }
+
+        case consumer_status::continuation: {
+            return details::destroy(m_storage.continuation);
+        }
     }
 
     assert(false);
@@ -183,42 +224,44 @@ void consumer_context::set_await_handle(coroutine_handle<void> caller_handle) no
     details::build(m_storage.caller_handle, caller_handle);
 }
 
-void consumer_context::set_wait_for_context(const std::shared_ptr<std::binary_semaphore>& wait_ctx) noexcept {
+void consumer_context::set_when_any_context(when_any_context& when_any_ctx) noexcept {
     assert(m_status == consumer_status::idle);
-    m_status = consumer_status::wait_for;
-    details::build(m_storage.wait_for_ctx, wait_ctx);
+    m_status = consumer_status::when_any;
+    details::build(m_storage.when_any_ctx, &when_any_ctx);
 }
 
-void consumer_context::set_when_any_context(const std::shared_ptr<when_any_context>& when_any_ctx) noexcept {
+void consumer_context::set_continuation(result_continuation& continuation) noexcept {
     assert(m_status == consumer_status::idle);
-    m_status = consumer_status::when_any;
-    details::build(m_storage.when_any_ctx, when_any_ctx);
+    m_status = consumer_status::continuation;
+    details::build(m_storage.continuation, &continuation);
 }
 
-void consumer_context::resume_consumer(result_state_base& self) const {
+coroutine_handle<void> consumer_context::resume_consumer(result_state_base& self) const noexcept {
     switch (m_status) {
         case consumer_status::idle: {
-            return;
+            return {};
         }
 
         case consumer_status::await: {
             auto caller_handle = m_storage.caller_handle;
             assert(static_cast<bool>(caller_handle));
             assert(!caller_handle.done());
-            return caller_handle();
-        }
-
-        case consumer_status::wait_for: {
-            const auto wait_ctx = m_storage.wait_for_ctx;
-            assert(static_cast<bool>(wait_ctx));
-            return wait_ctx->release();
+            return caller_handle;
         }
 
         case consumer_status::when_any: {
             const auto when_any_ctx = m_storage.when_any_ctx;
             return when_any_ctx->try_resume(self);
         }
+
+        case consumer_status::continuation: {
+            // the continuation may delete the result state (and this object with it) before schedule returns.
+            const auto continuation = m_storage.continuation;
+            continuation->schedule();
+            return {};
+        }
     }
 
     assert(false);
+    return {};
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/impl/result_continuation.h"
+#include "concurrencpp/executors/executor.h"
+
+using concurrencpp::details::continuation_task;
+using concurrencpp::details::result_continuation;
+
+namespace concurrencpp::details {
+    class continuation_task {
+
+       private:
+        result_continuation* m_continuation;
+
+       public:
+        continuation_task(result_continuation* continuation) noexcept : m_continuation(continuation) {}
+
+        continuation_task(continuation_task&& rhs) noexcept : m_continuation(std::exchange(rhs.m_continuation, nullptr)) {}
+
+        ~continuation_task() noexcept {
+            if (m_continuation != nullptr) {
+                m_continuation->interrupt();
+            }
+        }
+
+        void operator()() noexcept {
+            std::exchange(m_continuation, nullptr)->execute();
+        }
+    };
+}  // namespace concurrencpp::details
+
+result_continuation::result_continuation(std::shared_ptr<concurrencpp::executor> executor) noexcept : m_executor(std::move(executor)) {}
+
+void result_continuation::schedule() noexcept {
+    if (!static_cast<bool>(m_executor)) {
+        return execute();
+    }
+
+    try {
+        // the continuation may be deleted by the time enqueue returns, so the executor is moved out of it, not copied.
+        const auto executor = std::move(m_executor);
+        executor->enqueue(continuation_task {this});
+    } catch (...) {
+        // if enqueue throws, the task is destroyed and the output result gets a broken_task exception.
+    }
+}
+
+void result_continuation::verify_executor(const std::shared_ptr<concurrencpp::executor>& executor) {
+    if (!static_cast<bool>(executor)) {
+        throw std::invalid_argument(consts::k_result_then_null_executor_error_msg);
+    }
+}
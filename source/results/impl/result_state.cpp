@@ -35,6 +35,40 @@ void result_state_base::wait() {
     assert_done();
 }
 
+bool result_state_base::wait_until_impl(std::chrono::steady_clock::time_point deadline) {
+    auto expected_idle_state = pc_state::idle;
+    const auto idle_0 = m_pc_state.compare_exchange_strong(expected_idle_state,
+                                                           pc_state::consumer_waiting_for,
+                                                           std::memory_order_acq_rel,
+                                                           std::memory_order_acquire);
+
+    if (!idle_0) {
+        assert_done();
+        return true;
+    }
+
+    // the waiting thread parks on m_pc_state itself, nothing is allocated and nothing outlives this call.
+    while (atomic_wait_until(m_pc_state, pc_state::consumer_waiting_for, deadline)) {
+        if (m_pc_state.load(std::memory_order_acquire) == pc_state::producer_done) {
+            return true;
+        }
+    }
+
+    // timed out. if the producer finished meanwhile, the rewind fails and the result is ready.
+    auto expected_waiting_state = pc_state::consumer_waiting_for;
+    const auto idle_1 = m_pc_state.compare_exchange_strong(expected_waiting_state,
+                                                           pc_state::idle,
+                                                           std::memory_order_acq_rel,
+                                                           std::memory_order_acquire);
+
+    if (!idle_1) {
+        assert_done();
+        return true;
+    }
+
+    return false;
+}
+
 bool result_state_base::await(coroutine_handle<void> caller_handle) noexcept {
     const auto state = m_pc_state.load(std::memory_order_acquire);
     if (state == pc_state::producer_done) {
@@ -56,7 +90,7 @@ bool result_state_base::await(coroutine_handle<void> caller_handle) noexcept {
     return idle;  // if idle = true, suspend
 }
 
-result_state_base::pc_state result_state_base::when_any(const std::shared_ptr<when_any_context>& when_any_state) noexcept {
+result_state_base::pc_state result_state_base::when_any(when_any_context& when_any_state) noexcept {
     const auto state = m_pc_state.load(std::memory_order_acquire);
     if (state == pc_state::producer_done) {
         return state;
@@ -74,13 +108,35 @@ result_state_base::pc_state result_state_base::when_any(const std::shared_ptr<wh
         assert_done();
     }
 
-    return state;
+    // if the CAS failed, the producer finished before the context was registered and will never touch it.
+    return idle ? pc_state::consumer_set : pc_state::producer_done;
+}
+
+bool result_state_base::then(result_continuation& continuation) noexcept {
+    const auto state = m_pc_state.load(std::memory_order_acquire);
+    if (state == pc_state::producer_done) {
+        return false;
+    }
+
+    m_consumer.set_continuation(continuation);
+
+    auto expected_state = pc_state::idle;
+    const auto idle = m_pc_state.compare_exchange_strong(expected_state,
+                                                         pc_state::consumer_set,
+                                                         std::memory_order_acq_rel,
+                                                         std::memory_order_acquire);
+
+    if (!idle) {
+        assert_done();
+    }
+
+    return idle;
 }
 
-void result_state_base::try_rewind_consumer() noexcept {
+bool result_state_base::try_rewind_consumer() noexcept {
     const auto pc_state = m_pc_state.load(std::memory_order_acquire);
     if (pc_state != pc_state::consumer_set) {
-        return;
+        return false;
     }
 
     auto expected_consumer_state = pc_state::consumer_set;
@@ -91,8 +147,9 @@ void result_state_base::try_rewind_consumer() noexcept {
 
     if (!consumer) {
         assert_done();
-        return;
+        return false;
     }
 
     m_consumer.clear();
+    return true;
 }
@@ -0,0 +1,101 @@
+#include "concurrencpp/results/impl/result_state_allocator.h"
+
+#include <array>
+#include <new>
+
+using concurrencpp::details::result_state_allocator;
+
+namespace concurrencpp::details {
+    namespace {
+        constexpr size_t k_size_class_granularity = 64;
+        constexpr size_t k_size_class_count = 8;  // blocks of up to 512 bytes are recycled
+        constexpr size_t k_max_cached_blocks = 64;  // per size class, per thread
+
+        size_t size_class_of(size_t size) noexcept {
+            return (size - 1) / k_size_class_granularity;
+        }
+
+        size_t block_size_of(size_t size_class) noexcept {
+            return (size_class + 1) * k_size_class_granularity;
+        }
+
+        struct free_block {
+            free_block* next;
+        };
+
+        class thread_cache {
+
+           private:
+            std::array<free_block*, k_size_class_count> m_heads {};
+            std::array<size_t, k_size_class_count> m_counts {};
+
+           public:
+            ~thread_cache() noexcept;
+
+            void* pop(size_t size_class) noexcept {
+                const auto block = m_heads[size_class];
+                if (block == nullptr) {
+                    return nullptr;
+                }
+
+                m_heads[size_class] = block->next;
+                --m_counts[size_class];
+                return block;
+            }
+
+            bool push(void* pointer, size_t size_class) noexcept {
+                if (m_counts[size_class] == k_max_cached_blocks) {
+                    return false;
+                }
+
+                m_heads[size_class] = new (pointer) free_block {m_heads[size_class]};
+                ++m_counts[size_class];
+                return true;
+            }
+        };
+
+        // states might be freed by other thread_local destructors after the cache is gone.
+        thread_local bool t_cache_destroyed = false;
+        thread_local thread_cache t_cache;
+
+        thread_cache::~thread_cache() noexcept {
+            t_cache_destroyed = true;
+
+            for (size_t i = 0; i < k_size_class_count; i++) {
+                while (m_heads[i] != nullptr) {
+                    const auto block = m_heads[i];
+                    m_heads[i] = block->next;
+                    ::operator delete(block, block_size_of(i));
+                }
+            }
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
+void* result_state_allocator::allocate(size_t size) {
+    const auto size_class = size_class_of(size);
+    if (size_class >= k_size_class_count) {
+        return ::operator new(size);
+    }
+
+    if (!t_cache_destroyed) {
+        if (const auto block = t_cache.pop(size_class)) {
+            return block;
+        }
+    }
+
+    return ::operator new(block_size_of(size_class));
+}
+
+void result_state_allocator::deallocate(void* pointer, size_t size) noexcept {
+    const auto size_class = size_class_of(size);
+    if (size_class >= k_size_class_count) {
+        return ::operator delete(pointer, size);
+    }
+
+    if (!t_cache_destroyed && t_cache.push(pointer, size_class)) {
+        return;
+    }
+
+    ::operator delete(pointer, block_size_of(size_class));
+}
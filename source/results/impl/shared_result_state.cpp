@@ -1,91 +1,187 @@
 #include "concurrencpp/results/impl/shared_result_state.h"
+#include "concurrencpp/executors/executor.h"
+#include "concurrencpp/executors/task_batch.h"
 
+using concurrencpp::details::task_batch;
 using concurrencpp::details::shared_result_state_base;
 
-void shared_result_state_base::await_impl(std::unique_lock<std::mutex>& lock, shared_await_context& awaiter) noexcept {
-    assert(lock.owns_lock());
+bool shared_result_state_base::push_awaiter(shared_await_context& awaiter) noexcept {
+    auto head = m_awaiters.load(std::memory_order_acquire);
 
-    if (m_awaiters == nullptr) {
-        m_awaiters = &awaiter;
-        return;
-    }
+    do {
+        if (head == ready_marker()) {
+            return false;
+        }
 
-    awaiter.next = m_awaiters;
-    m_awaiters = &awaiter;
+        awaiter.next = head;
+    } while (!m_awaiters.compare_exchange_weak(head, &awaiter, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    return true;
 }
 
-void shared_result_state_base::wait_impl(std::unique_lock<std::mutex>& lock) {
-    assert(lock.owns_lock());
+bool shared_result_state_base::push_removable_awaiter(shared_await_context& awaiter) noexcept {
+    // counted before the push, so the producer that takes the awaiter sees it.
+    awaiter.removable = true;
+    m_removable_awaiters.fetch_add(1, std::memory_order_relaxed);
 
-    if (!m_condition.has_value()) {
-        m_condition.emplace();
+    if (push_awaiter(awaiter)) {
+        return true;
     }
 
-    m_condition.value().wait(lock, [this] {
-        return m_ready.load(std::memory_order_relaxed);
-    });
+    m_removable_awaiters.fetch_sub(1, std::memory_order_relaxed);
+    return false;
 }
 
-bool shared_result_state_base::wait_for_impl(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds ms) {
-    assert(lock.owns_lock());
+bool shared_result_state_base::wait_for_impl(std::chrono::milliseconds ms) {
+    const auto deadline = std::chrono::steady_clock::now() + ms;
+    shared_blocking_await_context awaiter;
 
-    if (!m_condition.has_value()) {
-        m_condition.emplace();
+    // the context lives on this stack frame, it must be unlinked before returning on timeout.
+    if (!push_removable_awaiter(awaiter)) {
+        return true;
     }
 
-    return m_condition.value().wait_for(lock, ms, [this] {
-        return m_ready.load(std::memory_order_relaxed);
-    });
-}
+    if (awaiter.wait_until(deadline)) {
+        return true;
+    }
 
-void shared_result_state_base::complete_producer() {
-    shared_await_context* awaiters;
+    if (remove_awaiter(awaiter)) {
+        return false;
+    }
+
+    // the producer has already taken the awaiter list and is about to release the awaiter.
+    awaiter.wait();
+    return true;
+}
 
-    {
-        std::unique_lock<std::mutex> lock(m_lock);
-        awaiters = std::exchange(m_awaiters, nullptr);
-        m_ready.store(true, std::memory_order_release);
+void shared_result_state_base::resume_inline(shared_await_context* awaiters) noexcept {
+    while (awaiters != nullptr) {
+        const auto next = awaiters->next;
 
-        if (m_condition.has_value()) {
-            m_condition.value().notify_all();
+        if (static_cast<bool>(awaiters->caller_handle)) {
+            awaiters->caller_handle();
+        } else {
+            static_cast<shared_blocking_await_context*>(awaiters)->release();
         }
+
+        awaiters = next;
     }
+}
+
+void shared_result_state_base::resume_fanned_out(shared_await_context* awaiters) noexcept {
+    shared_await_context* inline_awaiters = nullptr;
+    size_t inline_count = 0;
+    task_batch batch;
 
     while (awaiters != nullptr) {
         const auto next = awaiters->next;
-        awaiters->caller_handle();
+
+        if (!static_cast<bool>(awaiters->caller_handle)) {
+            static_cast<shared_blocking_await_context*>(awaiters)->release();
+        } else if (inline_count < m_inline_resumptions) {
+            // the list was taken by the producer, nobody else touches it anymore.
+            awaiters->next = inline_awaiters;
+            inline_awaiters = awaiters;
+            ++inline_count;
+        } else {
+            try {
+                batch.add(m_resume_executor, shared_awaiter_resumer {awaiters->caller_handle});
+            } catch (...) {
+                // the resumer was destroyed without being added, and resumed the coroutine inline.
+            }
+        }
+
         awaiters = next;
     }
+
+    // the executor gets the whole batch in one call, and can spread it between its workers while this thread resumes
+    // the rest inline. tasks that the executor doesn't consume resume their coroutines inline when destroyed.
+    batch.submit();
+
+    resume_inline(inline_awaiters);
 }
 
-bool shared_result_state_base::await(shared_await_context& awaiter) {
-    if (m_ready.load(std::memory_order_acquire)) {
-        return false;
+void shared_result_state_base::set_resume_executor(std::shared_ptr<executor> resume_executor, size_t inline_resumptions) noexcept {
+    m_resume_executor = std::move(resume_executor);
+    m_inline_resumptions = inline_resumptions;
+}
+
+void shared_result_state_base::complete_producer() {
+    auto awaiters = m_awaiters.exchange(ready_marker(), std::memory_order_acq_rel);
+
+    if (m_removable_awaiters.load(std::memory_order_acquire) != 0) {
+        // an awaiter that timed out might be unlinking itself from the list that was just taken, let it finish.
+        // the removable awaiters that are still in the list are taken now, nobody can remove them anymore.
+        std::unique_lock<std::mutex> lock(m_remove_lock);
+
+        size_t taken = 0;
+        for (auto awaiter = awaiters; awaiter != nullptr; awaiter = awaiter->next) {
+            taken += awaiter->removable ? 1 : 0;
+        }
+
+        m_removable_awaiters.fetch_sub(taken, std::memory_order_relaxed);
     }
 
-    {
-        std::unique_lock<std::mutex> lock(m_lock);
-        if (m_ready.load(std::memory_order_acquire)) {
-            return false;
+    // the resume executor was set before any awaiter was pushed, and pushes are acquired by the exchange above.
+    if (awaiters != nullptr && static_cast<bool>(m_resume_executor)) {
+        return resume_fanned_out(awaiters);
+    }
+
+    resume_inline(awaiters);
+}
+
+bool shared_result_state_base::await(shared_await_context& awaiter) noexcept {
+    return push_awaiter(awaiter);
+}
+
+bool shared_result_state_base::await_removable(shared_await_context& awaiter) noexcept {
+    return push_removable_awaiter(awaiter);
+}
+
+bool shared_result_state_base::remove_awaiter(shared_await_context& awaiter) noexcept {
+    assert(awaiter.removable);
+
+    // pushes only ever replace the top of the stack, so everything below it is stable while the lock is held.
+    std::unique_lock<std::mutex> lock(m_remove_lock);
+    auto head = m_awaiters.load(std::memory_order_acquire);
+
+    while (true) {
+        if (head == ready_marker()) {
+            return false;  // complete_producer has already taken the awaiter list.
+        }
+
+        if (head != &awaiter) {
+            break;
         }
 
-        await_impl(lock, awaiter);
+        if (m_awaiters.compare_exchange_weak(head, awaiter.next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            m_removable_awaiters.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
     }
 
-    return true;
+    for (auto node = head; node != nullptr; node = node->next) {
+        if (node->next == &awaiter) {
+            node->next = awaiter.next;
+
+            // the producer that sees the count drop doesn't need the lock, the list is already consistent.
+            m_removable_awaiters.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void shared_result_state_base::wait() {
-    if (m_ready.load(std::memory_order_acquire)) {
+    if (is_ready()) {
         return;
     }
 
-    {
-        std::unique_lock<std::mutex> lock(m_lock);
-        if (m_ready.load(std::memory_order_acquire)) {
-            return;
-        }
-
-        wait_impl(lock);
+    shared_blocking_await_context awaiter;
+    if (!push_awaiter(awaiter)) {
+        return;
     }
+
+    awaiter.wait();
 }
@@ -0,0 +1,150 @@
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/impl/timed_await_context.h"
+#include "concurrencpp/timers/timer_queue.h"
+#include "concurrencpp/executors/executor.h"
+#include "concurrencpp/executors/task_batch.h"
+#include "concurrencpp/threads/atomic_wait.h"
+
+using concurrencpp::details::timed_await_context;
+
+timed_await_context::time_point timed_await_context::make_deadline(const std::shared_ptr<timer_queue>& timer_queue,
+                                                                   std::chrono::milliseconds timeout) {
+    assert(static_cast<bool>(timer_queue));
+    return timer_queue->now() + timeout;
+}
+
+void timed_await_context::verify_params(const std::shared_ptr<concurrencpp::timer_queue>& timer_queue,
+                                        const std::shared_ptr<concurrencpp::executor>& timeout_executor) {
+    if (!static_cast<bool>(timer_queue)) {
+        throw std::invalid_argument(consts::k_resolve_timeout_null_timer_queue_error_msg);
+    }
+
+    if (!static_cast<bool>(timeout_executor)) {
+        throw std::invalid_argument(consts::k_resolve_timeout_null_executor_error_msg);
+    }
+}
+
+timed_await_context::timed_await_context(std::shared_ptr<concurrencpp::timer_queue> timer_queue,
+                                         std::chrono::milliseconds timeout,
+                                         std::shared_ptr<concurrencpp::executor> timeout_executor) :
+    timer_node(make_deadline(timer_queue, timeout)),
+    m_timer_queue(std::move(timer_queue)), m_timeout_executor(std::move(timeout_executor)) {
+    assert(static_cast<bool>(m_timeout_executor));
+}
+
+timed_await_context::timed_await_context(std::shared_ptr<concurrencpp::timer_queue> timer_queue,
+                                         time_point deadline,
+                                         std::shared_ptr<concurrencpp::executor> timeout_executor) noexcept :
+    timer_node(deadline),
+    m_timer_queue(std::move(timer_queue)), m_timeout_executor(std::move(timeout_executor)) {
+    assert(static_cast<bool>(m_timer_queue));
+    assert(static_cast<bool>(m_timeout_executor));
+}
+
+void timed_await_context::publish_registration(registration_status status) noexcept {
+    // the awaiting coroutine may continue (and destroy *this) as soon as the status changes, see atomic_wait.h
+    if (m_registration.exchange(status, std::memory_order_acq_rel) == registration_status::waiting) {
+        details::atomic_notify_one(&m_registration);
+    }
+}
+
+void timed_await_context::publish_timer_done() noexcept {
+    if (m_timer_status.exchange(timer_status::done, std::memory_order_acq_rel) == timer_status::waiting) {
+        details::atomic_notify_one(&m_timer_status);
+    }
+}
+
+void timed_await_context::set_caller_handle(coroutine_handle<void> caller_handle) noexcept {
+    assert(static_cast<bool>(caller_handle));
+    assert(!caller_handle.done());
+    m_caller_handle = caller_handle;
+}
+
+bool timed_await_context::arm(bool consumer_set) noexcept {
+    /*
+     * once the consumer is set, the producer might resume the coroutine at any moment, even before the timer is
+     * registered. the resumed coroutine waits on m_registration in disarm, so *this stays alive until we're done here.
+     */
+    if (!consumer_set) {
+        m_registration.store(registration_status::skipped, std::memory_order_relaxed);
+        return false;  // the producer is done, don't suspend, nobody waits for the registration
+    }
+
+    try {
+        m_timer_queue->add_timer_node(*this);
+    } catch (...) {
+        // the timer_queue was shut down. if we manage to detach the consumer, resume immediately with an interrupt
+        const auto detached = try_cancel_wait();
+        m_interrupted = detached;
+        publish_registration(registration_status::skipped);
+        return !detached;
+    }
+
+    publish_registration(registration_status::registered);
+    return true;
+}
+
+void timed_await_context::disarm() {
+    /*
+     * both waits below are for a thread that is already past the point of no return and never suspends before it
+     * publishes: arm() is a single add_timer_node call away from publishing m_registration, and a fired node is a single
+     * try_cancel_wait call away from publishing m_timer_status. a short spin covers the common case, after that the
+     * thread parks on the status until the other side publishes it. this lets the context live in the coroutine frame
+     * instead of being allocated.
+     */
+    auto registration = m_registration.load(std::memory_order_acquire);
+    for (size_t i = 0; i < k_spin_count && registration == registration_status::pending; i++) {
+        registration = m_registration.load(std::memory_order_acquire);
+    }
+
+    if (registration == registration_status::pending &&
+        m_registration.compare_exchange_strong(registration, registration_status::waiting, std::memory_order_acq_rel)) {
+        atomic_wait(m_registration, registration_status::waiting);
+        registration = m_registration.load(std::memory_order_acquire);
+    }
+
+    if (registration == registration_status::registered && !m_timer_queue->remove_timer_node(*this)) {
+        // the timer thread has already picked the node up, wait until it's done touching it.
+        auto status = m_timer_status.load(std::memory_order_acquire);
+        for (size_t i = 0; i < k_spin_count && status == timer_status::running; i++) {
+            status = m_timer_status.load(std::memory_order_acquire);
+        }
+
+        if (status == timer_status::running &&
+            m_timer_status.compare_exchange_strong(status, timer_status::waiting, std::memory_order_acq_rel)) {
+            atomic_wait(m_timer_status, timer_status::waiting);
+        }
+    }
+
+    if (m_interrupted) {
+        throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+    }
+}
+
+void timed_await_context::fire(task_batch& batch) noexcept {
+    if (!try_cancel_wait()) {
+        // the producer won the race, it has resumed (or is about to resume) the coroutine.
+        publish_timer_done();
+        return;
+    }
+
+    // we own the coroutine now, nobody else will resume it before the batch is submitted.
+    m_timer_status.store(timer_status::done, std::memory_order_release);
+
+    try {
+        batch.add(m_timeout_executor, await_via_functor {m_caller_handle, &m_interrupted});
+    } catch (...) {
+        // if an exception is thrown, await_via_functor d.tor will set an interrupt and resume the coro
+    }
+}
+
+void timed_await_context::interrupt() noexcept {
+    if (!try_cancel_wait()) {
+        publish_timer_done();
+        return;
+    }
+
+    m_interrupted = true;
+    m_timer_status.store(timer_status::done, std::memory_order_release);
+    m_caller_handle();
+}
@@ -0,0 +1,94 @@
+#include "concurrencpp/threads/async_barrier.h"
+#include "concurrencpp/threads/constants.h"
+
+#include <exception>
+#include <stdexcept>
+#include <system_error>
+
+using concurrencpp::async_barrier;
+
+async_barrier::async_barrier(size_t expected, std::function<void()> completion) :
+    m_remaining(expected), m_expected(expected), m_completion(std::move(completion)) {
+    if (expected == 0) {
+        throw std::invalid_argument(details::consts::k_async_barrier_invalid_expected_err_msg);
+    }
+}
+
+namespace concurrencpp::details {
+    namespace {
+        [[noreturn]] void throw_no_participants() {
+            throw std::system_error(static_cast<int>(std::errc::operation_not_permitted),
+                                    std::system_category(),
+                                    consts::k_async_barrier_arrive_no_participants_err_msg);
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
+bool async_barrier::try_arrive(size_t phase) {
+    auto remaining = m_remaining.load(std::memory_order_relaxed);
+    do {
+        if (remaining == 0) {
+            return false;
+        }
+    } while (!m_remaining.compare_exchange_weak(remaining, remaining - 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    if (remaining == 1) {
+        complete_phase(phase);
+    }
+
+    return true;
+}
+
+void async_barrier::complete_phase(size_t phase) {
+    // nobody arrives at the next phase before its event is reset: all the participants are still waiting on this one.
+    m_phase_events[(phase + 1) % 2].reset();
+
+    std::exception_ptr completion_error;
+    if (m_completion) {
+        try {
+            m_completion();
+        } catch (...) {
+            completion_error = std::current_exception();
+        }
+    }
+
+    m_expected -= m_dropped.exchange(0, std::memory_order_acquire);
+    m_remaining.store(m_expected, std::memory_order_release);
+    m_phase.store(phase + 1, std::memory_order_release);
+    m_phase_events[phase % 2].set();
+
+    // the phase completes anyway, so the other participants are not left waiting. only the arriving caller sees the error.
+    if (static_cast<bool>(completion_error)) {
+        std::rethrow_exception(completion_error);
+    }
+}
+
+concurrencpp::details::async_event_awaiter async_barrier::arrive_and_wait(std::shared_ptr<executor> resume_executor) {
+    if (!static_cast<bool>(resume_executor)) {
+        throw std::invalid_argument(details::consts::k_async_barrier_arrive_and_wait_null_resume_executor_err_msg);
+    }
+
+    // the phase can't advance before this participant arrives, so it's safe to read it first.
+    const auto phase = m_phase.load(std::memory_order_acquire);
+    auto awaiter = m_phase_events[phase % 2].wait(std::move(resume_executor));
+    if (!try_arrive(phase)) {
+        details::throw_no_participants();
+    }
+
+    return awaiter;
+}
+
+void async_barrier::arrive_and_drop() {
+    const auto phase = m_phase.load(std::memory_order_acquire);
+    m_dropped.fetch_add(1, std::memory_order_release);
+
+    // an exception thrown by the completion function is not rolled back: the phase has consumed the drop already.
+    if (!try_arrive(phase)) {
+        m_dropped.fetch_sub(1, std::memory_order_relaxed);
+        details::throw_no_participants();
+    }
+}
+
+size_t async_barrier::phase() const noexcept {
+    return m_phase.load(std::memory_order_acquire);
+}
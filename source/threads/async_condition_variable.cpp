@@ -1,33 +1,93 @@
 #include "concurrencpp/results/resume_on.h"
+#include "concurrencpp/results/constants.h"
 #include "concurrencpp/threads/constants.h"
+#include "concurrencpp/executors/task_batch.h"
 #include "concurrencpp/threads/async_condition_variable.h"
+#include "concurrencpp/errors.h"
 
 using concurrencpp::executor;
 using concurrencpp::lazy_result;
 using concurrencpp::scoped_async_lock;
 using concurrencpp::async_condition_variable;
 
+using concurrencpp::details::cv_wakeup;
 using concurrencpp::details::cv_awaiter;
 
 /*
     cv_awaiter
 */
 
-cv_awaiter::cv_awaiter(async_condition_variable& parent, scoped_async_lock& lock) noexcept : m_parent(parent), m_lock(lock) {}
+cv_awaiter::cv_awaiter(async_condition_variable& parent, scoped_async_lock& lock, const std::shared_ptr<executor>& resume_executor) noexcept :
+    m_parent(parent), m_lock(lock), m_resume_executor(resume_executor), m_lock_awaiter(*lock.mutex(), resume_executor, 0) {}
 
 void cv_awaiter::await_suspend(details::coroutine_handle<void> caller_handle) {
     m_caller_handle = caller_handle;
 
-    std::unique_lock<std::mutex> lock(m_parent.m_lock);
-    m_lock.unlock();
+    // m_lock stops owning the lock without releasing it yet.
+    auto& mutex = *m_lock.mutex();
+    scoped_async_lock unowned(mutex, std::defer_lock);
+    m_lock.release();
+    m_lock.swap(unowned);
 
-    m_parent.m_awaiters.push_back(*this);
+    {
+        std::unique_lock<std::mutex> lock(m_parent.m_lock);
+        m_parent.m_awaiters.push_back(*this);
+    }
+
+    // the lock is released only after the task is enqueued, so no notification is lost. a notification might have moved
+    // the task to the lock's waiters already, in which case unlock resumes it: *this must not be accessed from here on.
+    mutex.unlock();
+}
+
+cv_wakeup cv_awaiter::await_resume() {
+    auto& mutex = *m_lock.mutex();
+
+    if (m_owns_lock) {
+        mutex.enter_critical_section();
+
+        if (m_interrupted) {
+            mutex.unlock();
+            throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+        }
+
+        return cv_wakeup::owns_lock;
+    }
+
+    auto owns_lock = false;
+
+    try {
+        owns_lock = m_lock_awaiter.await_resume();
+    } catch (...) {
+        // woken up to compete for the lock, but the resume executor has been shut down. pass the wakeup on.
+        if (mutex.try_lock()) {
+            mutex.unlock();
+        }
+
+        throw;
+    }
+
+    if (!owns_lock) {
+        return cv_wakeup::compete_for_lock;
+    }
+
+    mutex.enter_critical_section();
+    return cv_wakeup::owns_lock_handed_off;
 }
 
-void cv_awaiter::resume() noexcept {
-    assert(static_cast<bool>(m_caller_handle));
-    assert(!m_caller_handle.done());
-    m_caller_handle();
+void cv_awaiter::notify(task_batch& batch) noexcept {
+    auto& mutex = *m_lock.mutex();
+    if (mutex.enqueue_awaiter(m_lock_awaiter, m_caller_handle)) {
+        return;  // the task was moved to the waiters of the lock, and might be running already.
+    }
+
+    m_owns_lock = true;
+
+    try {
+        batch.add(m_resume_executor, m_caller_handle, &m_interrupted);
+    } catch (...) {
+        m_interrupted = true;
+        m_caller_handle();
+    }
 }
 
 /*
@@ -52,10 +112,26 @@ void async_condition_variable::verify_await_params(const std::shared_ptr<executo
 }
 
 lazy_result<void> async_condition_variable::await_impl(std::shared_ptr<executor> resume_executor, scoped_async_lock& lock) {
-    co_await details::cv_awaiter(*this, lock);
+    const auto wakeup = co_await details::cv_awaiter(*this, lock, resume_executor);
     assert(!lock.owns_lock());
-    co_await resume_on(resume_executor);  // TODO: optimize this when get_current_executor is available
-    co_await lock.lock(resume_executor);
+
+    if (wakeup == cv_wakeup::compete_for_lock) {
+        co_await lock.lock(resume_executor);
+        co_return;
+    }
+
+    auto& mutex = *lock.mutex();
+    if (wakeup == cv_wakeup::owns_lock_handed_off) {
+        try {
+            co_await resume_on(resume_executor);
+        } catch (...) {
+            mutex.unlock();
+            throw;
+        }
+    }
+
+    scoped_async_lock owned(mutex, std::adopt_lock);
+    lock.swap(owned);
 }
 
 lazy_result<void> async_condition_variable::await(std::shared_ptr<executor> resume_executor, scoped_async_lock& lock) {
@@ -68,9 +144,13 @@ void async_condition_variable::notify_one() {
     const auto awaiter = m_awaiters.pop_front();
     lock.unlock();
 
-    if (awaiter != nullptr) {
-        awaiter->resume();
+    if (awaiter == nullptr) {
+        return;
     }
+
+    details::task_batch batch;
+    awaiter->notify(batch);
+    batch.submit();
 }
 
 void async_condition_variable::notify_all() {
@@ -78,12 +158,17 @@ void async_condition_variable::notify_all() {
     auto awaiters = std::move(m_awaiters);
     lock.unlock();
 
+    // tasks that acquire their lock are handed to their resume executors in one batch, the rest wait on their lock.
+    details::task_batch batch;
+
     while (true) {
         const auto awaiter = awaiters.pop_front();
         if (awaiter == nullptr) {
-            return;  // no more awaiters
+            break;  // no more awaiters
         }
 
-        awaiter->resume();
+        awaiter->notify(batch);
     }
+
+    batch.submit();
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "concurrencpp/threads/async_event.h"
+#include "concurrencpp/threads/constants.h"
+#include "concurrencpp/executors/task_batch.h"
+
+#include "concurrencpp/errors.h"
+#include "concurrencpp/results/constants.h"
+
+#include <cassert>
+
+using concurrencpp::async_manual_reset_event;
+using concurrencpp::details::async_event_awaiter;
+
+/*
+ * async_event_awaiter
+ */
+
+async_event_awaiter::async_event_awaiter(async_manual_reset_event& parent, std::shared_ptr<executor> resume_executor) noexcept :
+    m_parent(parent), m_resume_executor(std::move(resume_executor)) {}
+
+bool async_event_awaiter::await_ready() const noexcept {
+    return m_parent.is_set();
+}
+
+bool async_event_awaiter::await_suspend(coroutine_handle<void> handle) noexcept {
+    m_resume_handle = handle;
+    return m_parent.enqueue_awaiter(*this);
+}
+
+void async_event_awaiter::await_resume() const {
+    if (m_interrupted) {
+        throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+    }
+}
+
+/*
+ * async_manual_reset_event
+ */
+
+async_manual_reset_event::async_manual_reset_event(bool initially_set) noexcept : m_state(initially_set ? k_set : k_not_set) {}
+
+async_manual_reset_event::~async_manual_reset_event() noexcept {
+#ifdef CRCPP_DEBUG_MODE
+    const auto state = m_state.load(std::memory_order_acquire);
+    assert((state == k_set || state == k_not_set) && "async_manual_reset_event is deleted while tasks are waiting on it.");
+#endif
+}
+
+bool async_manual_reset_event::enqueue_awaiter(details::async_event_awaiter& awaiter) noexcept {
+    auto state = m_state.load(std::memory_order_acquire);
+
+    do {
+        if (state == k_set) {
+            return false;  // set in the meantime, don't suspend
+        }
+
+        awaiter.next = reinterpret_cast<details::async_event_awaiter*>(state);
+    } while (!m_state.compare_exchange_weak(state,
+                                            reinterpret_cast<std::uintptr_t>(&awaiter),
+                                            std::memory_order_release,
+                                            std::memory_order_acquire));
+
+    return true;
+}
+
+concurrencpp::details::async_event_awaiter async_manual_reset_event::wait(std::shared_ptr<executor> resume_executor) {
+    if (!static_cast<bool>(resume_executor)) {
+        throw std::invalid_argument(details::consts::k_async_manual_reset_event_wait_null_resume_executor_err_msg);
+    }
+
+    return {*this, std::move(resume_executor)};
+}
+
+bool async_manual_reset_event::is_set() const noexcept {
+    return m_state.load(std::memory_order_acquire) == k_set;
+}
+
+void async_manual_reset_event::set() noexcept {
+    const auto state = m_state.exchange(k_set, std::memory_order_acq_rel);
+    if (state == k_set || state == k_not_set) {
+        return;
+    }
+
+    // the stack holds the most recent awaiter first, resume the awaiters in the order they arrived.
+    details::async_event_awaiter* awaiters = nullptr;
+    auto awaiter = reinterpret_cast<details::async_event_awaiter*>(state);
+    while (awaiter != nullptr) {
+        const auto next = awaiter->next;
+        awaiter->next = awaiters;
+        awaiters = awaiter;
+        awaiter = next;
+    }
+
+    details::task_batch batch;
+
+    while (awaiters != nullptr) {
+        const auto current = std::exchange(awaiters, awaiters->next);
+
+        try {
+            batch.add(current->m_resume_executor, current->m_resume_handle, &current->m_interrupted);
+        } catch (...) {
+            current->m_interrupted = true;
+            current->m_resume_handle();
+        }
+    }
+
+    batch.submit();
+}
+
+void async_manual_reset_event::reset() noexcept {
+    auto expected = k_set;
+    m_state.compare_exchange_strong(expected, k_not_set, std::memory_order_relaxed, std::memory_order_relaxed);
+}
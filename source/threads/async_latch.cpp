@@ -0,0 +1,47 @@
+#include "concurrencpp/threads/async_latch.h"
+#include "concurrencpp/threads/constants.h"
+
+#include <stdexcept>
+
+using concurrencpp::async_latch;
+
+async_latch::async_latch(size_t expected) noexcept : m_counter(expected), m_event(expected == 0) {}
+
+void async_latch::count_down(size_t update) {
+    if (update == 0) {
+        return;
+    }
+
+    // the counter is validated before it's updated, so an invalid update never shows up to other tasks.
+    auto counter = m_counter.load(std::memory_order_relaxed);
+    do {
+        if (counter < update) {
+            throw std::invalid_argument(details::consts::k_async_latch_count_down_invalid_update_err_msg);
+        }
+    } while (!m_counter.compare_exchange_weak(counter, counter - update, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    if (counter == update) {
+        m_event.set();
+    }
+}
+
+bool async_latch::try_wait() const noexcept {
+    return m_event.is_set();
+}
+
+concurrencpp::details::async_event_awaiter async_latch::wait(std::shared_ptr<executor> resume_executor) {
+    if (!static_cast<bool>(resume_executor)) {
+        throw std::invalid_argument(details::consts::k_async_latch_wait_null_resume_executor_err_msg);
+    }
+
+    return m_event.wait(std::move(resume_executor));
+}
+
+concurrencpp::details::async_event_awaiter async_latch::arrive_and_wait(std::shared_ptr<executor> resume_executor, size_t update) {
+    if (!static_cast<bool>(resume_executor)) {
+        throw std::invalid_argument(details::consts::k_async_latch_arrive_and_wait_null_resume_executor_err_msg);
+    }
+
+    count_down(update);
+    return m_event.wait(std::move(resume_executor));
+}
@@ -1,7 +1,10 @@
 #include "concurrencpp/results/resume_on.h"
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/impl/consumer_context.h"
 #include "concurrencpp/threads/constants.h"
 #include "concurrencpp/threads/async_lock.h"
 #include "concurrencpp/executors/executor.h"
+#include "concurrencpp/errors.h"
 
 using concurrencpp::async_lock;
 using concurrencpp::scoped_async_lock;
@@ -11,75 +14,228 @@ using concurrencpp::details::async_lock_awaiter;
     async_lock_awaiter
 */
 
-async_lock_awaiter::async_lock_awaiter(async_lock& parent, std::unique_lock<std::mutex>& lock) noexcept :
-    m_parent(parent), m_lock(std::move(lock)) {}
+async_lock_awaiter::async_lock_awaiter(async_lock& parent,
+                                       const std::shared_ptr<executor>& resume_executor,
+                                       size_t failed_attempts,
+                                       size_t arrival) noexcept :
+    m_parent(parent),
+    m_resume_executor(resume_executor), m_failed_attempts(failed_attempts), m_arrival(arrival) {}
 
-void async_lock_awaiter::await_suspend(coroutine_handle<void> handle) {
+bool async_lock_awaiter::await_suspend(coroutine_handle<void> handle) noexcept {
     assert(static_cast<bool>(handle));
     assert(!handle.done());
     assert(!static_cast<bool>(m_resume_handle));
-    assert(m_lock.owns_lock());
 
     m_resume_handle = handle;
-    m_parent.m_awaiters.push_back(*this);
+    return m_parent.enqueue_awaiter(*this);
+}
+
+bool async_lock_awaiter::await_resume() const {
+    if (m_interrupted) {
+        throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+    }
 
-    auto lock = std::move(m_lock);  // will unlock underlying lock
+    return m_acquired_inline || m_handed_off;
 }
 
-void async_lock_awaiter::retry() noexcept {
+void async_lock_awaiter::hand_off() noexcept {
+    m_handed_off = true;
     m_resume_handle.resume();
 }
 
+void async_lock_awaiter::retry() noexcept {
+    // the task (and *this with it) might be destroyed before post returns, keep the executor alive.
+    const auto executor = m_resume_executor;
+
+    try {
+        executor->post(await_via_functor {m_resume_handle, &m_interrupted});
+    } catch (...) {
+        // if an exception is thrown, await_via_functor d.tor will set an interrupt and resume the coro
+    }
+}
+
 /*
     async_lock
 */
 
+async_lock::async_lock(async_lock_mode mode, size_t max_barging) noexcept :
+    m_mode(mode), m_max_barging(mode == async_lock_mode::fifo_handoff ? 0 :
+                                (mode == async_lock_mode::barging ? std::numeric_limits<size_t>::max() : max_barging)) {}
+
 async_lock::~async_lock() noexcept {
 #ifdef CRCPP_DEBUG_MODE
-    std::unique_lock<std::mutex> lock(m_awaiter_lock);
-    assert(!m_locked && "async_lock is dstroyed while it's locked.");
+    assert(m_state.load(std::memory_order_acquire) == k_unlocked && "async_lock is dstroyed while it's locked.");
 #endif
 }
 
-concurrencpp::lazy_result<scoped_async_lock> async_lock::lock_impl(std::shared_ptr<executor> resume_executor, bool with_raii_guard) {
-    auto resume_synchronously = true;  // indicates if the locking coroutine managed to lock the lock on first attempt
+bool async_lock::enqueue_awaiter(details::async_lock_awaiter& awaiter) noexcept {
+    auto state = m_state.load(std::memory_order_acquire);
 
     while (true) {
-        std::unique_lock<std::mutex> lock(m_awaiter_lock);
-        if (!m_locked) {
-            m_locked = true;
-            lock.unlock();
+        if (state == k_unlocked) {
+            // the lock was released in the meantime, acquire it without suspending
+            if (m_state.compare_exchange_weak(state, k_locked_no_waiters, std::memory_order_acquire, std::memory_order_acquire)) {
+                awaiter.m_acquired_inline = true;
+                return false;
+            }
+
+            continue;
+        }
+
+        awaiter.next = (state == k_locked_no_waiters) ? nullptr : reinterpret_cast<details::async_lock_awaiter*>(state);
+        if (m_state.compare_exchange_weak(state,
+                                          reinterpret_cast<std::uintptr_t>(&awaiter),
+                                          std::memory_order_release,
+                                          std::memory_order_acquire)) {
+            m_waits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+bool async_lock::enqueue_awaiter(details::async_lock_awaiter& awaiter, details::coroutine_handle<void> resume_handle) noexcept {
+    // used to move a task that is already suspended (e.g. on a condition variable) directly to the waiters of *this.
+    assert(!static_cast<bool>(awaiter.m_resume_handle));
+    awaiter.m_resume_handle = resume_handle;
+    return enqueue_awaiter(awaiter);
+}
+
+void async_lock::absorb_awaiters(std::uintptr_t awaiter_stack) noexcept {
+    assert(awaiter_stack != k_unlocked);
+    if (awaiter_stack == k_locked_no_waiters) {
+        return;
+    }
+
+    // the stack holds the newest awaiter first. awaiters that already lost the lock to a barging task get their old
+    // place in the queue back, new ones go to its back, in arrival order.
+    details::slist<details::async_lock_awaiter> new_awaiters;
+    auto awaiter = reinterpret_cast<details::async_lock_awaiter*>(awaiter_stack);
+    while (awaiter != nullptr) {
+        const auto next = std::exchange(awaiter->next, nullptr);
+        ++m_awaiter_count;
+
+        if (awaiter->m_failed_attempts != 0) {
+            requeue_awaiter(*awaiter);
+        } else {
+            new_awaiters.push_front(*awaiter);
+        }
+
+        awaiter = next;
+    }
+
+    while (true) {
+        const auto new_awaiter = new_awaiters.pop_front();
+        if (new_awaiter == nullptr) {
             break;
         }
 
-        co_await async_lock_awaiter(*this, lock);
+        new_awaiter->next = nullptr;
+        new_awaiter->m_arrival = m_next_arrival++;
+        m_awaiters.push_back(*new_awaiter);
+    }
+}
+
+void async_lock::requeue_awaiter(details::async_lock_awaiter& awaiter) noexcept {
+    // the queue is ordered by arrival. awaiters that lost the lock are older than most of it, the walk is short.
+    const auto head = m_awaiters.front();
+    if (head == nullptr || awaiter.m_arrival < head->m_arrival) {
+        m_awaiters.push_front(awaiter);
+        return;
+    }
+
+    auto position = head;
+    while (position->next != nullptr && position->next->m_arrival < awaiter.m_arrival) {
+        position = position->next;
+    }
+
+    m_awaiters.insert_after(*position, awaiter);
+}
+
+void async_lock::release_contended() noexcept {
+    while (true) {
+        absorb_awaiters(m_state.exchange(k_locked_no_waiters, std::memory_order_acquire));
+        if (!m_awaiters.empty()) {
+            break;
+        }
+
+        auto expected = k_locked_no_waiters;
+        if (m_state.compare_exchange_strong(expected, k_unlocked, std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    m_queue_length_sum.fetch_add(m_awaiter_count, std::memory_order_relaxed);
+
+    const auto awaiter = m_awaiters.pop_front();
+    assert(awaiter != nullptr);
+    awaiter->next = nullptr;
+    --m_awaiter_count;
+
+    if (m_mode == async_lock_mode::fifo_handoff || awaiter->m_failed_attempts >= m_max_barging) {
+        // the lock stays locked: ownership is handed to the awaiter that has been waiting the longest.
+        m_handoffs.fetch_add(1, std::memory_order_relaxed);
+        awaiter->hand_off();
+        return;
+    }
+
+    // release the lock, so running tasks can use it while the awaiter is rescheduled. the remaining awaiters are taken
+    // care of by whoever acquires the lock next.
+    m_barging_wakeups.fetch_add(1, std::memory_order_relaxed);
+
+    while (true) {
+        auto expected = k_locked_no_waiters;
+        if (m_state.compare_exchange_strong(expected, k_unlocked, std::memory_order_release, std::memory_order_relaxed)) {
+            break;
+        }
 
-        resume_synchronously =
-            false;  // if we haven't managed to lock the lock on first attempt, we need to resume using resume_executor
+        absorb_awaiters(m_state.exchange(k_locked_no_waiters, std::memory_order_acquire));
     }
 
-    if (!resume_synchronously) {
+    awaiter->retry();
+}
+
+concurrencpp::lazy_result<scoped_async_lock> async_lock::lock_impl(std::shared_ptr<executor> resume_executor, bool with_raii_guard) {
+    auto needs_resume_on = false;
+    size_t arrival = 0;
+
+    // uncontended case: a single CAS, no suspension.
+    for (size_t failed_attempts = 0; !try_lock_impl(); ++failed_attempts) {
+        details::async_lock_awaiter awaiter(*this, resume_executor, failed_attempts, arrival);
+        auto owns_lock = false;
+
         try {
-            co_await resume_on(resume_executor);
+            owns_lock = co_await awaiter;
         } catch (...) {
-            std::unique_lock<std::mutex> lock(m_awaiter_lock);
-            assert(m_locked);
-            m_locked = false;
-            const auto awaiter = m_awaiters.pop_front();
-            lock.unlock();
-
-            if (awaiter != nullptr) {
-                awaiter->retry();
+            // woken up to compete for the lock, but resume_executor has been shut down. other tasks might be waiting
+            // behind this one, so the wakeup is passed on.
+            if (try_lock()) {
+                unlock();
             }
 
             throw;
         }
+
+        if (owns_lock) {
+            // a handed-off lock is received inside the thread of execution of the previous owner.
+            needs_resume_on = awaiter.handed_off();
+            break;
+        }
+
+        // woken up inside resume_executor in a barging mode, but another task got the lock first. the task waits again
+        // in the place it had.
+        arrival = awaiter.arrival();
     }
 
-#ifdef CRCPP_DEBUG_MODE
-    const auto current_count = m_thread_count_in_critical_section.fetch_add(1, std::memory_order_relaxed);
-    assert(current_count == 0);
-#endif
+    enter_critical_section();
+
+    if (needs_resume_on) {
+        try {
+            co_await resume_on(resume_executor);
+        } catch (...) {
+            unlock();
+            throw;
+        }
+    }
 
     if (with_raii_guard) {
         co_return scoped_async_lock(*this, std::adopt_lock);
@@ -96,50 +252,68 @@ concurrencpp::lazy_result<scoped_async_lock> async_lock::lock(std::shared_ptr<ex
     return lock_impl(std::move(resume_executor), true);
 }
 
-concurrencpp::lazy_result<bool> async_lock::try_lock() {
-    auto res = false;
+bool async_lock::try_lock_impl() noexcept {
+    auto expected = k_unlocked;
+    return m_state.compare_exchange_strong(expected, k_locked_no_waiters, std::memory_order_acquire, std::memory_order_relaxed);
+}
 
-    std::unique_lock<std::mutex> lock(m_awaiter_lock);
-    if (!m_locked) {
-        m_locked = true;
-        lock.unlock();
-        res = true;
-    } else {
-        lock.unlock();
+bool async_lock::try_lock() noexcept {
+    const auto res = try_lock_impl();
+    if (res) {
+        enter_critical_section();
     }
 
+    return res;
+}
+
+void async_lock::enter_critical_section() noexcept {
 #ifdef CRCPP_DEBUG_MODE
-    if (res) {
-        const auto current_count = m_thread_count_in_critical_section.fetch_add(1, std::memory_order_relaxed);
-        assert(current_count == 0);
-    }
+    const auto current_count = m_thread_count_in_critical_section.fetch_add(1, std::memory_order_relaxed);
+    assert(current_count == 0);
 #endif
-
-    co_return res;
 }
 
 void async_lock::unlock() {
-    std::unique_lock<std::mutex> lock(m_awaiter_lock);
-    if (!m_locked) {  // trying to unlocked non-owned mutex
-        lock.unlock();
+    const auto state = m_state.load(std::memory_order_acquire);
+    if (state == k_unlocked) {  // trying to unlocked non-owned mutex
         throw std::system_error(static_cast<int>(std::errc::operation_not_permitted),
                                 std::system_category(),
                                 details::consts::k_async_lock_unlock_invalid_lock_err_msg);
     }
 
-    m_locked = false;
-
 #ifdef CRCPP_DEBUG_MODE
     const auto current_count = m_thread_count_in_critical_section.fetch_sub(1, std::memory_order_relaxed);
     assert(current_count == 1);
 #endif
 
-    const auto awaiter = m_awaiters.pop_front();
-    lock.unlock();
+    // uncontended case: a single CAS releases the lock.
+    if (state == k_locked_no_waiters && m_awaiters.empty()) {
+        auto expected = k_locked_no_waiters;
+        if (m_state.compare_exchange_strong(expected, k_unlocked, std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    release_contended();
+}
 
-    if (awaiter != nullptr) {
-        awaiter->retry();
+concurrencpp::async_lock_mode async_lock::mode() const noexcept {
+    return m_mode;
+}
+
+concurrencpp::async_lock_stats async_lock::stats() const noexcept {
+    async_lock_stats stats;
+    stats.waits = m_waits.load(std::memory_order_relaxed);
+    stats.handoffs = m_handoffs.load(std::memory_order_relaxed);
+    stats.barging_wakeups = m_barging_wakeups.load(std::memory_order_relaxed);
+
+    const auto contended_unlocks = stats.handoffs + stats.barging_wakeups;
+    if (contended_unlocks != 0) {
+        stats.average_queue_length =
+            static_cast<double>(m_queue_length_sum.load(std::memory_order_relaxed)) / static_cast<double>(contended_unlocks);
     }
+
+    return stats;
 }
 
 /*
@@ -178,7 +352,7 @@ concurrencpp::lazy_result<void> scoped_async_lock::lock(std::shared_ptr<executor
     }
 }
 
-concurrencpp::lazy_result<bool> scoped_async_lock::try_lock() {
+bool scoped_async_lock::try_lock() {
     if (m_lock == nullptr) {
         throw std::system_error(static_cast<int>(std::errc::operation_not_permitted),
                                 std::system_category(),
@@ -188,10 +362,10 @@ concurrencpp::lazy_result<bool> scoped_async_lock::try_lock() {
                                 std::system_category(),
                                 concurrencpp::details::consts::k_scoped_async_lock_try_lock_deadlock_err_msg);
     } else {
-        m_owns = co_await m_lock->try_lock();
+        m_owns = m_lock->try_lock();
     }
 
-    co_return m_owns;
+    return m_owns;
 }
 
 void scoped_async_lock::unlock() {
@@ -0,0 +1,151 @@
+#include "concurrencpp/threads/async_semaphore.h"
+#include "concurrencpp/threads/constants.h"
+#include "concurrencpp/executors/task_batch.h"
+
+#include "concurrencpp/errors.h"
+#include "concurrencpp/results/constants.h"
+
+#include <cassert>
+
+using concurrencpp::async_semaphore;
+using concurrencpp::details::async_semaphore_awaiter;
+
+/*
+ * async_semaphore_awaiter
+ */
+
+async_semaphore_awaiter::async_semaphore_awaiter(async_semaphore& parent,
+                                                 size_t count,
+                                                 std::shared_ptr<executor> resume_executor) noexcept :
+    m_parent(parent),
+    m_count(count), m_resume_executor(std::move(resume_executor)) {}
+
+bool async_semaphore_awaiter::await_ready() noexcept {
+    return m_parent.try_take_fast(m_count);
+}
+
+bool async_semaphore_awaiter::await_suspend(coroutine_handle<void> handle) {
+    m_resume_handle = handle;
+    return m_parent.enqueue_awaiter(*this);
+}
+
+void async_semaphore_awaiter::await_resume() {
+    if (m_interrupted) {
+        // the permits were granted, but the task can't use them. give them to someone else.
+        m_parent.release(m_count);
+        throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+    }
+}
+
+/*
+ * async_semaphore
+ */
+
+async_semaphore::async_semaphore(size_t initial_permits) noexcept : m_permits(initial_permits) {}
+
+async_semaphore::~async_semaphore() noexcept {
+#ifdef CRCPP_DEBUG_MODE
+    std::unique_lock<std::mutex> lock(m_lock);
+    assert(m_awaiters.empty() && "async_semaphore is deleted while tasks are waiting on it.");
+#endif
+}
+
+bool async_semaphore::try_take(size_t count) noexcept {
+    auto permits = m_permits.load(std::memory_order_relaxed);
+    do {
+        if (permits < count) {
+            return false;
+        }
+    } while (!m_permits.compare_exchange_weak(permits, permits - count, std::memory_order_acquire, std::memory_order_relaxed));
+
+    return true;
+}
+
+bool async_semaphore::try_take_fast(size_t count) noexcept {
+    // waiters are served in FIFO order, newcomers can't cut in line.
+    if (m_waiter_count.load(std::memory_order_relaxed) != 0) {
+        return false;
+    }
+
+    return try_take(count);
+}
+
+bool async_semaphore::enqueue_awaiter(details::async_semaphore_awaiter& awaiter) {
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    /*
+     * announce the waiter before checking the permits one last time: release() adds the permits before looking for
+     * waiters, so either we see the released permits here, or release() sees us and dispatches the permits to us.
+     */
+    m_waiter_count.fetch_add(1, std::memory_order_seq_cst);
+
+    // try_take loads m_permits relaxed. without the fence, that load may be ordered before the increment above, and
+    // both this waiter and release() could miss each other. release() has no fence of its own: it relies on its
+    // seq_cst fetch_add of m_permits being ordered before its seq_cst load of m_waiter_count.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_awaiters.empty() && try_take(awaiter.m_count)) {
+        m_waiter_count.fetch_sub(1, std::memory_order_relaxed);
+        return false;  // don't suspend
+    }
+
+    m_awaiters.push_back(awaiter);
+    return true;
+}
+
+concurrencpp::details::async_semaphore_awaiter async_semaphore::acquire(std::shared_ptr<executor> resume_executor, size_t count) {
+    if (!static_cast<bool>(resume_executor)) {
+        throw std::invalid_argument(details::consts::k_async_semaphore_acquire_null_resume_executor_err_msg);
+    }
+
+    return {*this, count, std::move(resume_executor)};
+}
+
+bool async_semaphore::try_acquire(size_t count) noexcept {
+    return try_take_fast(count);
+}
+
+void async_semaphore::release(size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    m_permits.fetch_add(count, std::memory_order_seq_cst);
+    if (m_waiter_count.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+
+    details::task_batch batch;
+
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+
+        // admit as many waiters as the permits allow, in FIFO order. a waiter that asks for more permits than there
+        // are blocks the ones behind it, otherwise big requests could be starved by small ones.
+        while (!m_awaiters.empty()) {
+            auto& awaiter = *m_awaiters.front();
+            if (!try_take(awaiter.m_count)) {
+                break;
+            }
+
+            m_awaiters.pop_front();
+            m_waiter_count.fetch_sub(1, std::memory_order_relaxed);
+
+            try {
+                batch.add(awaiter.m_resume_executor, awaiter.m_resume_handle, &awaiter.m_interrupted);
+            } catch (...) {
+                // could not allocate room for the awaiter, give its permits back and keep it at the front.
+                m_permits.fetch_add(awaiter.m_count, std::memory_order_relaxed);
+                m_waiter_count.fetch_add(1, std::memory_order_relaxed);
+                m_awaiters.push_front(awaiter);
+                break;
+            }
+        }
+    }
+
+    batch.submit();
+}
+
+size_t async_semaphore::available_permits() const noexcept {
+    return m_permits.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,393 @@
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/impl/consumer_context.h"
+#include "concurrencpp/threads/thread.h"
+#include "concurrencpp/threads/constants.h"
+#include "concurrencpp/threads/async_shared_mutex.h"
+#include "concurrencpp/executors/executor.h"
+#include "concurrencpp/errors.h"
+
+#include <system_error>
+
+using concurrencpp::async_shared_mutex;
+using concurrencpp::scoped_async_shared_lock;
+using concurrencpp::scoped_async_exclusive_lock;
+using concurrencpp::details::async_shared_mutex_awaiter;
+
+/*
+    async_shared_mutex_awaiter
+*/
+
+async_shared_mutex_awaiter::async_shared_mutex_awaiter(async_shared_mutex& parent,
+                                                       const std::shared_ptr<executor>& resume_executor,
+                                                       bool exclusive) noexcept :
+    m_parent(parent),
+    m_resume_executor(resume_executor), m_exclusive(exclusive) {}
+
+bool async_shared_mutex_awaiter::await_suspend(coroutine_handle<void> handle) {
+    assert(static_cast<bool>(handle));
+    assert(!handle.done());
+
+    m_resume_handle = handle;
+    return m_parent.enqueue_awaiter(*this);
+}
+
+void async_shared_mutex_awaiter::await_resume() const {
+    if (m_interrupted) {
+        throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+    }
+}
+
+void async_shared_mutex_awaiter::resume() noexcept {
+    // the task (and *this with it) might be destroyed before post returns, keep the executor alive.
+    const auto executor = m_resume_executor;
+
+    try {
+        executor->post(await_via_functor {m_resume_handle, &m_interrupted});
+    } catch (...) {
+        // if an exception is thrown, await_via_functor d.tor will set an interrupt and resume the coro
+    }
+}
+
+/*
+    async_shared_mutex
+*/
+
+async_shared_mutex::async_shared_mutex() :
+    m_reader_stripe_count(details::thread::hardware_concurrency()),
+    m_reader_stripes(std::make_unique<padded_counter[]>(m_reader_stripe_count)) {}
+
+async_shared_mutex::~async_shared_mutex() noexcept {
+#ifdef CRCPP_DEBUG_MODE
+    std::unique_lock<std::mutex> lock(m_lock);
+    assert(!m_writer_owns && "async_shared_mutex is destroyed while it's locked.");
+    assert(reader_count() == 0 && "async_shared_mutex is destroyed while it's locked.");
+#endif
+}
+
+async_shared_mutex::padded_counter& async_shared_mutex::current_stripe() noexcept {
+    return m_reader_stripes[details::thread::get_current_virtual_id() % m_reader_stripe_count];
+}
+
+intptr_t async_shared_mutex::reader_count() const noexcept {
+    intptr_t count = 0;
+    for (size_t i = 0; i < m_reader_stripe_count; i++) {
+        count += m_reader_stripes[i].value.load(std::memory_order_seq_cst);
+    }
+
+    return count;
+}
+
+bool async_shared_mutex::try_lock_shared_fast() noexcept {
+    /*
+     * the reader announces itself before checking for writers, while a writer announces itself before counting readers.
+     * both sides use sequentially consistent operations, so at least one of them sees the other.
+     */
+    auto& stripe = current_stripe();
+    stripe.value.fetch_add(1, std::memory_order_seq_cst);
+    if (!m_writer_pending.load(std::memory_order_seq_cst)) {
+        return true;
+    }
+
+    stripe.value.fetch_sub(1, std::memory_order_seq_cst);
+    return false;
+}
+
+concurrencpp::details::async_shared_mutex_awaiter* async_shared_mutex::try_grant_draining_writer() noexcept {
+    if (m_draining_writer == nullptr || reader_count() != 0) {
+        return nullptr;
+    }
+
+    m_writer_owns = true;
+    return std::exchange(m_draining_writer, nullptr);
+}
+
+void async_shared_mutex::admit_waiting_readers(details::slist<details::async_shared_mutex_awaiter>& admitted) noexcept {
+    intptr_t count = 0;
+    while (true) {
+        const auto reader = m_waiting_readers.pop_front();
+        if (reader == nullptr) {
+            break;
+        }
+
+        reader->next = nullptr;
+        admitted.push_back(*reader);
+        ++count;
+    }
+
+    if (count != 0) {
+        current_stripe().value.fetch_add(count, std::memory_order_seq_cst);
+    }
+}
+
+void async_shared_mutex::resume_all(details::slist<details::async_shared_mutex_awaiter>& awaiters) noexcept {
+    while (true) {
+        const auto awaiter = awaiters.pop_front();
+        if (awaiter == nullptr) {
+            break;
+        }
+
+        awaiter->resume();
+    }
+}
+
+bool async_shared_mutex::enqueue_awaiter(details::async_shared_mutex_awaiter& awaiter) {
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    if (awaiter.m_exclusive) {
+        if (m_writer_pending.load(std::memory_order_relaxed)) {
+            m_waiting_writers.push_back(awaiter);
+            return true;
+        }
+
+        m_writer_pending.store(true, std::memory_order_seq_cst);
+        if (reader_count() == 0) {
+            m_writer_owns = true;
+            return false;
+        }
+
+        // new readers wait from now on, the writer waits for the current ones to leave.
+        m_draining_writer = &awaiter;
+        return true;
+    }
+
+    // the reader might have been counted by a draining writer before it backed off.
+    const auto writer = try_grant_draining_writer();
+
+    if (!m_writer_pending.load(std::memory_order_relaxed)) {
+        // the writer left in the meantime. writers only announce themselves under m_lock, so this can't race.
+        current_stripe().value.fetch_add(1, std::memory_order_seq_cst);
+        return false;
+    }
+
+    m_waiting_readers.push_back(awaiter);
+    lock.unlock();
+
+    if (writer != nullptr) {
+        writer->resume();
+    }
+
+    return true;
+}
+
+concurrencpp::lazy_result<scoped_async_exclusive_lock> async_shared_mutex::lock_impl(std::shared_ptr<executor> resume_executor) {
+    details::async_shared_mutex_awaiter awaiter(*this, resume_executor, true);
+
+    try {
+        co_await awaiter;
+    } catch (...) {
+        // the mutex was handed to us, but resume_executor has been shut down.
+        unlock();
+        throw;
+    }
+
+    co_return scoped_async_exclusive_lock(*this, std::adopt_lock);
+}
+
+concurrencpp::lazy_result<scoped_async_shared_lock> async_shared_mutex::lock_shared_impl(std::shared_ptr<executor> resume_executor) {
+    if (!try_lock_shared_fast()) {
+        details::async_shared_mutex_awaiter awaiter(*this, resume_executor, false);
+
+        try {
+            co_await awaiter;
+        } catch (...) {
+            // the mutex was handed to us, but resume_executor has been shut down.
+            unlock_shared();
+            throw;
+        }
+    }
+
+    co_return scoped_async_shared_lock(*this, std::adopt_lock);
+}
+
+concurrencpp::lazy_result<scoped_async_exclusive_lock> async_shared_mutex::lock(std::shared_ptr<executor> resume_executor) {
+    if (!static_cast<bool>(resume_executor)) {
+        throw std::invalid_argument(details::consts::k_async_shared_mutex_lock_null_resume_executor_err_msg);
+    }
+
+    return lock_impl(std::move(resume_executor));
+}
+
+bool async_shared_mutex::try_lock() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (m_writer_pending.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    m_writer_pending.store(true, std::memory_order_seq_cst);
+    if (reader_count() == 0) {
+        m_writer_owns = true;
+        return true;
+    }
+
+    // readers are inside, withdraw. readers that backed off because of us are blocked on m_lock, they can't be queued yet.
+    m_writer_pending.store(false, std::memory_order_seq_cst);
+    assert(m_waiting_readers.empty());
+    return false;
+}
+
+void async_shared_mutex::unlock() {
+    details::slist<details::async_shared_mutex_awaiter> admitted_readers;
+    details::async_shared_mutex_awaiter* next_writer = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        if (!m_writer_owns) {
+            lock.unlock();
+            throw std::system_error(static_cast<int>(std::errc::operation_not_permitted),
+                                    std::system_category(),
+                                    details::consts::k_async_shared_mutex_unlock_invalid_lock_err_msg);
+        }
+
+        m_writer_owns = false;
+
+        // readers that waited for this writer are let in before the next writer, so neither side starves.
+        admit_waiting_readers(admitted_readers);
+
+        const auto writer = m_waiting_writers.pop_front();
+        if (writer == nullptr) {
+            m_writer_pending.store(false, std::memory_order_seq_cst);
+        } else if (admitted_readers.empty()) {
+            writer->next = nullptr;
+            m_writer_owns = true;
+            next_writer = writer;
+        } else {
+            writer->next = nullptr;
+            m_draining_writer = writer;
+        }
+    }
+
+    resume_all(admitted_readers);
+
+    if (next_writer != nullptr) {
+        next_writer->resume();
+    }
+}
+
+concurrencpp::lazy_result<scoped_async_shared_lock> async_shared_mutex::lock_shared(std::shared_ptr<executor> resume_executor) {
+    if (!static_cast<bool>(resume_executor)) {
+        throw std::invalid_argument(details::consts::k_async_shared_mutex_lock_shared_null_resume_executor_err_msg);
+    }
+
+    return lock_shared_impl(std::move(resume_executor));
+}
+
+bool async_shared_mutex::try_lock_shared() {
+    if (try_lock_shared_fast()) {
+        return true;
+    }
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    const auto writer = try_grant_draining_writer();
+    lock.unlock();
+
+    if (writer != nullptr) {
+        writer->resume();
+    }
+
+    return false;
+}
+
+void async_shared_mutex::unlock_shared() {
+    current_stripe().value.fetch_sub(1, std::memory_order_seq_cst);
+    if (!m_writer_pending.load(std::memory_order_seq_cst)) {
+        return;
+    }
+
+    // a writer might be waiting for the last reader to leave
+    std::unique_lock<std::mutex> lock(m_lock);
+    const auto writer = try_grant_draining_writer();
+    lock.unlock();
+
+    if (writer != nullptr) {
+        writer->resume();
+    }
+}
+
+/*
+ *  scoped_async_shared_lock
+ */
+
+scoped_async_shared_lock::scoped_async_shared_lock(scoped_async_shared_lock&& rhs) noexcept : m_mutex(std::exchange(rhs.m_mutex, nullptr)) {}
+
+scoped_async_shared_lock::scoped_async_shared_lock(async_shared_mutex& mutex, std::adopt_lock_t) noexcept : m_mutex(&mutex) {}
+
+scoped_async_shared_lock::~scoped_async_shared_lock() noexcept {
+    if (m_mutex != nullptr) {
+        m_mutex->unlock_shared();
+    }
+}
+
+void scoped_async_shared_lock::unlock() {
+    if (m_mutex == nullptr) {
+        throw std::system_error(static_cast<int>(std::errc::operation_not_permitted),
+                                std::system_category(),
+                                details::consts::k_scoped_async_shared_lock_unlock_invalid_lock_err_msg);
+    }
+
+    std::exchange(m_mutex, nullptr)->unlock_shared();
+}
+
+bool scoped_async_shared_lock::owns_lock() const noexcept {
+    return m_mutex != nullptr;
+}
+
+scoped_async_shared_lock::operator bool() const noexcept {
+    return owns_lock();
+}
+
+void scoped_async_shared_lock::swap(scoped_async_shared_lock& rhs) noexcept {
+    std::swap(m_mutex, rhs.m_mutex);
+}
+
+async_shared_mutex* scoped_async_shared_lock::release() noexcept {
+    return std::exchange(m_mutex, nullptr);
+}
+
+async_shared_mutex* scoped_async_shared_lock::mutex() const noexcept {
+    return m_mutex;
+}
+
+/*
+ *  scoped_async_exclusive_lock
+ */
+
+scoped_async_exclusive_lock::scoped_async_exclusive_lock(scoped_async_exclusive_lock&& rhs) noexcept :
+    m_mutex(std::exchange(rhs.m_mutex, nullptr)) {}
+
+scoped_async_exclusive_lock::scoped_async_exclusive_lock(async_shared_mutex& mutex, std::adopt_lock_t) noexcept : m_mutex(&mutex) {}
+
+scoped_async_exclusive_lock::~scoped_async_exclusive_lock() noexcept {
+    if (m_mutex != nullptr) {
+        m_mutex->unlock();
+    }
+}
+
+void scoped_async_exclusive_lock::unlock() {
+    if (m_mutex == nullptr) {
+        throw std::system_error(static_cast<int>(std::errc::operation_not_permitted),
+                                std::system_category(),
+                                details::consts::k_scoped_async_exclusive_lock_unlock_invalid_lock_err_msg);
+    }
+
+    std::exchange(m_mutex, nullptr)->unlock();
+}
+
+bool scoped_async_exclusive_lock::owns_lock() const noexcept {
+    return m_mutex != nullptr;
+}
+
+scoped_async_exclusive_lock::operator bool() const noexcept {
+    return owns_lock();
+}
+
+void scoped_async_exclusive_lock::swap(scoped_async_exclusive_lock& rhs) noexcept {
+    std::swap(m_mutex, rhs.m_mutex);
+}
+
+async_shared_mutex* scoped_async_exclusive_lock::release() noexcept {
+    return std::exchange(m_mutex, nullptr);
+}
+
+async_shared_mutex* scoped_async_exclusive_lock::mutex() const noexcept {
+    return m_mutex;
+}
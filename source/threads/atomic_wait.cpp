@@ -0,0 +1,159 @@
+#include "concurrencpp/threads/atomic_wait.h"
+
+#include <limits>
+
+#if defined(__linux__)
+
+#    include <ctime>
+#    include <cerrno>
+#    include <unistd.h>
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+
+namespace concurrencpp::details {
+    namespace {
+        long futex(const void* address, int operation, std::int32_t value, const ::timespec* timeout) noexcept {
+            return ::syscall(SYS_futex, address, operation, value, timeout, nullptr, FUTEX_BITSET_MATCH_ANY);
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
+void concurrencpp::details::atomic_wait(const void* address, std::int32_t old_value) noexcept {
+    futex(address, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, old_value, nullptr);
+}
+
+bool concurrencpp::details::atomic_wait_until(const void* address,
+                                              std::int32_t old_value,
+                                              std::chrono::steady_clock::time_point deadline) noexcept {
+    // steady_clock is CLOCK_MONOTONIC, which FUTEX_WAIT_BITSET measures absolute deadlines against.
+    const auto since_epoch = deadline.time_since_epoch();
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - seconds);
+
+    ::timespec timeout {};
+    timeout.tv_sec = static_cast<decltype(timeout.tv_sec)>(seconds.count());
+    timeout.tv_nsec = static_cast<decltype(timeout.tv_nsec)>(nanoseconds.count());
+
+    const auto res = futex(address, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, old_value, &timeout);
+    return !(res == -1 && errno == ETIMEDOUT);
+}
+
+void concurrencpp::details::atomic_notify_one(const void* address) noexcept {
+    futex(address, FUTEX_WAKE_BITSET | FUTEX_PRIVATE_FLAG, 1, nullptr);
+}
+
+void concurrencpp::details::atomic_notify_all(const void* address) noexcept {
+    futex(address, FUTEX_WAKE_BITSET | FUTEX_PRIVATE_FLAG, std::numeric_limits<std::int32_t>::max(), nullptr);
+}
+
+#elif defined(CRCPP_WIN_OS)
+
+#    include <Windows.h>
+
+#    pragma comment(lib, "Synchronization.lib")
+
+void concurrencpp::details::atomic_wait(const void* address, std::int32_t old_value) noexcept {
+    ::WaitOnAddress(const_cast<void*>(address), &old_value, sizeof(old_value), INFINITE);
+}
+
+bool concurrencpp::details::atomic_wait_until(const void* address,
+                                              std::int32_t old_value,
+                                              std::chrono::steady_clock::time_point deadline) noexcept {
+    const auto now = std::chrono::steady_clock::now();
+    if (deadline <= now) {
+        return false;
+    }
+
+    // round up, so the deadline is never cut short.
+    const auto ms = std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+    const auto timeout = (ms >= static_cast<long long>(INFINITE)) ? INFINITE - 1 : static_cast<DWORD>(ms);
+
+    if (::WaitOnAddress(const_cast<void*>(address), &old_value, sizeof(old_value), timeout) != FALSE) {
+        return true;
+    }
+
+    return ::GetLastError() != ERROR_TIMEOUT;
+}
+
+void concurrencpp::details::atomic_notify_one(const void* address) noexcept {
+    ::WakeByAddressSingle(const_cast<void*>(address));
+}
+
+void concurrencpp::details::atomic_notify_all(const void* address) noexcept {
+    ::WakeByAddressAll(const_cast<void*>(address));
+}
+
+#else
+
+#    include <mutex>
+#    include <condition_variable>
+
+namespace concurrencpp::details {
+    namespace {
+        /*
+         * platforms without a timed address wait get a parking lot: waiters block on a condition variable picked by
+         * hashing the waited address. a bucket is shared by unrelated addresses, so notifications always wake every
+         * waiter of the bucket, and each waiter re-checks its own atomic.
+         */
+        struct wait_bucket {
+            std::mutex lock;
+            std::condition_variable condition;
+        };
+
+        wait_bucket& wait_bucket_of(const void* address) noexcept {
+            constexpr size_t k_bucket_count = 64;
+            static wait_bucket buckets[k_bucket_count];
+
+            const auto hash = reinterpret_cast<std::uintptr_t>(address) >> 2;
+            return buckets[hash % k_bucket_count];
+        }
+
+        void notify_bucket(const void* address) noexcept {
+            auto& bucket = wait_bucket_of(address);
+
+            // the waiter checks the atomic under the bucket lock, passing through it orders the caller's store before
+            // that check, so a waiter that is about to block can't miss this notification.
+            {
+                std::unique_lock<std::mutex> lock(bucket.lock);
+            }
+
+            bucket.condition.notify_all();
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
+void concurrencpp::details::atomic_wait(const void* address, std::int32_t old_value) noexcept {
+    const auto& atomic = *static_cast<const std::atomic<std::int32_t>*>(address);
+    auto& bucket = wait_bucket_of(address);
+
+    std::unique_lock<std::mutex> lock(bucket.lock);
+    while (atomic.load(std::memory_order_acquire) == old_value) {
+        bucket.condition.wait(lock);
+    }
+}
+
+bool concurrencpp::details::atomic_wait_until(const void* address,
+                                              std::int32_t old_value,
+                                              std::chrono::steady_clock::time_point deadline) noexcept {
+    const auto& atomic = *static_cast<const std::atomic<std::int32_t>*>(address);
+    auto& bucket = wait_bucket_of(address);
+
+    std::unique_lock<std::mutex> lock(bucket.lock);
+    while (atomic.load(std::memory_order_acquire) == old_value) {
+        if (bucket.condition.wait_until(lock, deadline) == std::cv_status::timeout) {
+            return atomic.load(std::memory_order_acquire) != old_value;
+        }
+    }
+
+    return true;
+}
+
+void concurrencpp::details::atomic_notify_one(const void* address) noexcept {
+    notify_bucket(address);
+}
+
+void concurrencpp::details::atomic_notify_all(const void* address) noexcept {
+    notify_bucket(address);
+}
+
+#endif
@@ -0,0 +1,167 @@
+#include "concurrencpp/threads/channel.h"
+#include "concurrencpp/executors/task_batch.h"
+
+using concurrencpp::details::channel_base;
+using concurrencpp::details::channel_awaiter_base;
+
+/*
+ * channel_awaiter_base
+ */
+
+channel_awaiter_base::channel_awaiter_base(std::shared_ptr<executor> resume_executor) noexcept :
+    m_resume_executor(std::move(resume_executor)) {}
+
+/*
+ * channel_base
+ */
+
+channel_base::~channel_base() noexcept {
+#ifdef CRCPP_DEBUG_MODE
+    std::unique_lock<std::mutex> lock(m_lock);
+    assert(m_consumers.empty() && m_producers.empty() && "channel is deleted while tasks are waiting on it.");
+#endif
+}
+
+bool channel_base::enqueue_awaiter(channel_awaiter_base& awaiter, slist<channel_awaiter_base>& awaiters, std::atomic_size_t& counter) {
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    /*
+     * announce the waiter before trying one last time: whoever pushes or pops a value does so before checking for waiters,
+     * so either the operation succeeds here, or the other side sees this waiter and completes the operation for it.
+     */
+    counter.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // a closed channel takes no more values, but values that were pushed before close() are still delivered.
+    const auto closed = m_closed.load(std::memory_order_relaxed);
+    const auto completed = !(closed && &awaiters == &m_producers) && awaiter.try_complete();
+    if (completed || closed) {
+        counter.fetch_sub(1, std::memory_order_relaxed);
+        lock.unlock();
+
+        // completing the operation might unblock a waiter on the other side.
+        if (completed && &awaiters == &m_consumers) {
+            on_popped();
+        } else if (completed) {
+            on_pushed();
+        }
+
+        return false;  // don't suspend
+    }
+
+    awaiters.push_back(awaiter);
+    return true;
+}
+
+bool channel_base::enqueue_consumer(channel_awaiter_base& awaiter) {
+    return enqueue_awaiter(awaiter, m_consumers, m_waiting_consumers);
+}
+
+bool channel_base::enqueue_producer(channel_awaiter_base& awaiter) {
+    return enqueue_awaiter(awaiter, m_producers, m_waiting_producers);
+}
+
+void channel_base::add_to_batch(task_batch& batch, channel_awaiter_base& awaiter, slist<channel_awaiter_base>& failed) noexcept {
+    awaiter.next = nullptr;
+
+    try {
+        batch.add(awaiter.m_resume_executor, awaiter.m_resume_handle, &awaiter.m_interrupted);
+    } catch (...) {
+        // the awaiter can't be resumed while the lock is held, it's interrupted once the lock is released.
+        awaiter.m_interrupted = true;
+        failed.push_back(awaiter);
+    }
+}
+
+void channel_base::interrupt_all(slist<channel_awaiter_base>& awaiters) noexcept {
+    while (true) {
+        const auto awaiter = awaiters.pop_front();
+        if (awaiter == nullptr) {
+            break;
+        }
+
+        awaiter->m_resume_handle();
+    }
+}
+
+void channel_base::on_pushed() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiting_consumers.load(std::memory_order_relaxed) != 0) {
+        dispatch();
+    }
+}
+
+void channel_base::on_popped() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiting_producers.load(std::memory_order_relaxed) != 0) {
+        dispatch();
+    }
+}
+
+void channel_base::dispatch() noexcept {
+    task_batch batch;
+    slist<channel_awaiter_base> failed;
+
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+
+        // a value handed to a consumer makes room for a producer and vice versa, keep going while waiters make progress.
+        auto progress = true;
+        while (progress) {
+            progress = false;
+
+            const auto consumer = m_consumers.front();
+            if (consumer != nullptr && consumer->try_complete()) {
+                m_consumers.pop_front();
+                m_waiting_consumers.fetch_sub(1, std::memory_order_relaxed);
+                add_to_batch(batch, *consumer, failed);
+                progress = true;
+            }
+
+            const auto producer = m_producers.front();
+            if (producer != nullptr && producer->try_complete()) {
+                m_producers.pop_front();
+                m_waiting_producers.fetch_sub(1, std::memory_order_relaxed);
+                add_to_batch(batch, *producer, failed);
+                progress = true;
+            }
+        }
+    }
+
+    batch.submit();
+    interrupt_all(failed);
+}
+
+void channel_base::close() noexcept {
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (m_closed.exchange(true, std::memory_order_relaxed)) {
+        return;
+    }
+
+    auto consumers = std::move(m_consumers);
+    auto producers = std::move(m_producers);
+    m_waiting_consumers.store(0, std::memory_order_relaxed);
+    m_waiting_producers.store(0, std::memory_order_relaxed);
+    lock.unlock();
+
+    task_batch batch;
+    slist<channel_awaiter_base> failed;
+
+    for (auto* awaiters : {&consumers, &producers}) {
+        while (true) {
+            const auto awaiter = awaiters->pop_front();
+            if (awaiter == nullptr) {
+                break;
+            }
+
+            add_to_batch(batch, *awaiter, failed);
+        }
+    }
+
+    batch.submit();
+    interrupt_all(failed);
+}
+
+bool channel_base::closed() const noexcept {
+    return m_closed.load(std::memory_order_acquire);
+}
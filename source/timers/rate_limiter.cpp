@@ -0,0 +1,251 @@
+#include "concurrencpp/timers/rate_limiter.h"
+#include "concurrencpp/timers/timer_queue.h"
+#include "concurrencpp/timers/constants.h"
+
+#include "concurrencpp/errors.h"
+#include "concurrencpp/executors/executor.h"
+#include "concurrencpp/executors/task_batch.h"
+#include "concurrencpp/results/constants.h"
+#include "concurrencpp/results/impl/consumer_context.h"
+
+#include <cassert>
+
+using concurrencpp::rate_limiter;
+using concurrencpp::details::rate_limiter_awaiter;
+
+namespace concurrencpp::details {
+    namespace {
+        std::shared_ptr<concurrencpp::timer_queue> verify_timer_queue(std::shared_ptr<concurrencpp::timer_queue> timer_queue) {
+            if (!static_cast<bool>(timer_queue)) {
+                throw std::invalid_argument(consts::k_rate_limiter_null_timer_queue_err_msg);
+            }
+
+            return timer_queue;
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
+/*
+ * rate_limiter_awaiter
+ */
+
+rate_limiter_awaiter::rate_limiter_awaiter(rate_limiter& parent,
+                                           size_t count,
+                                           std::shared_ptr<concurrencpp::executor> resume_executor) noexcept :
+    timer_node(time_point {}),
+    m_parent(parent), m_count(count), m_resume_executor(std::move(resume_executor)) {}
+
+void rate_limiter_awaiter::resume(task_batch& batch) noexcept {
+    try {
+        batch.add(m_resume_executor, await_via_functor {m_caller_handle, &m_interrupted});
+    } catch (...) {
+        // if an exception is thrown, await_via_functor d.tor will set an interrupt and resume the coro
+    }
+}
+
+bool rate_limiter_awaiter::await_suspend(coroutine_handle<void> caller_handle) noexcept {
+    m_caller_handle = caller_handle;
+    return m_parent.enqueue_waiter(*this);
+}
+
+void rate_limiter_awaiter::await_resume() const {
+    if (m_interrupted) {
+        throw errors::broken_task(consts::k_broken_task_exception_error_msg);
+    }
+}
+
+void rate_limiter_awaiter::fire(task_batch& batch) noexcept {
+    m_parent.on_head_fired(*this, batch);
+}
+
+void rate_limiter_awaiter::interrupt() noexcept {
+    m_parent.on_head_interrupted();
+}
+
+/*
+ * rate_limiter
+ */
+
+rate_limiter::rate_limiter(std::shared_ptr<concurrencpp::timer_queue> timer_queue, size_t permits_per_second, size_t max_burst) :
+    m_timer_queue(details::verify_timer_queue(std::move(timer_queue))), m_permit_period(make_permit_period(permits_per_second)),
+    m_max_burst(max_burst), m_permits(max_burst), m_last_refill(m_timer_queue->now()) {
+    if (max_burst == 0) {
+        throw std::invalid_argument(details::consts::k_rate_limiter_invalid_burst_err_msg);
+    }
+}
+
+rate_limiter::time_point::duration rate_limiter::make_permit_period(size_t permits_per_second) {
+    constexpr auto one_second = std::chrono::duration_cast<time_point::duration>(std::chrono::seconds(1));
+    if (permits_per_second == 0 || permits_per_second > static_cast<size_t>(one_second.count())) {
+        throw std::invalid_argument(details::consts::k_rate_limiter_invalid_rate_err_msg);
+    }
+
+    return one_second / permits_per_second;
+}
+
+void rate_limiter::refill(time_point now) noexcept {
+    if (now <= m_last_refill) {
+        return;
+    }
+
+    const auto new_permits = static_cast<size_t>((now - m_last_refill) / m_permit_period);
+    if (m_permits + new_permits >= m_max_burst) {
+        // the bucket is full, time that passes while it's full doesn't accumulate permits.
+        m_permits = m_max_burst;
+        m_last_refill = now;
+        return;
+    }
+
+    // keep the remainder, so partial periods are not lost between refills.
+    m_permits += new_permits;
+    m_last_refill += m_permit_period * static_cast<time_point::rep>(new_permits);
+}
+
+bool rate_limiter::try_take(size_t count, time_point now) noexcept {
+    refill(now);
+
+    // waiters are served in FIFO order, newcomers can't cut in line.
+    if (m_head != nullptr || m_permits < count) {
+        return false;
+    }
+
+    m_permits -= count;
+    return true;
+}
+
+bool rate_limiter::arm_head(time_point now) noexcept {
+    assert(m_head != nullptr);
+    assert(m_head->m_count > m_permits);
+
+    auto& head = *m_head;
+    const auto missing_permits = head.m_count - m_permits;
+    const time_point refill_deadline = m_last_refill + m_permit_period * static_cast<time_point::rep>(missing_permits);
+    const time_point min_deadline = now + details::consts::k_rate_limiter_min_wake_interval;
+    head.deadline = (refill_deadline < min_deadline) ? min_deadline : refill_deadline;
+
+    try {
+        m_timer_queue->add_timer_node(head);
+    } catch (...) {
+        return false;
+    }
+
+    return true;
+}
+
+bool rate_limiter::enqueue_waiter(details::rate_limiter_awaiter& waiter) noexcept {
+    std::unique_lock<std::mutex> lock(m_lock);
+    const auto now = m_timer_queue->now();
+    if (try_take(waiter.m_count, now)) {
+        return false;  // don't suspend
+    }
+
+    if (m_tail == nullptr) {
+        m_head = m_tail = &waiter;
+    } else {
+        m_tail->m_next_waiter = &waiter;
+        m_tail = &waiter;
+        return true;
+    }
+
+    if (arm_head(now)) {
+        return true;
+    }
+
+    // the timer_queue was shut down. waiter is the only waiter, so nothing else is left to interrupt.
+    m_head = m_tail = nullptr;
+    waiter.m_interrupted = true;
+    return false;
+}
+
+void rate_limiter::on_head_fired(details::rate_limiter_awaiter& head, details::task_batch& batch) noexcept {
+    details::rate_limiter_awaiter* granted_head = nullptr;
+    details::rate_limiter_awaiter* granted_tail = nullptr;
+    details::rate_limiter_awaiter* interrupted = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        assert(m_head == &head);
+        (void)head;
+
+        const auto now = m_timer_queue->now();
+        refill(now);
+
+        // hand out everything that was accumulated since the last wakeup in one go.
+        while (m_head != nullptr && m_permits >= m_head->m_count) {
+            auto waiter = m_head;
+            m_head = waiter->m_next_waiter;
+            m_permits -= waiter->m_count;
+            waiter->m_next_waiter = nullptr;
+
+            if (granted_tail == nullptr) {
+                granted_head = granted_tail = waiter;
+            } else {
+                granted_tail->m_next_waiter = waiter;
+                granted_tail = waiter;
+            }
+        }
+
+        if (m_head == nullptr) {
+            m_tail = nullptr;
+        } else if (!arm_head(now)) {
+            interrupted = m_head;
+            m_head = m_tail = nullptr;
+        }
+    }
+
+    while (granted_head != nullptr) {
+        auto next = granted_head->m_next_waiter;
+        granted_head->resume(batch);
+        granted_head = next;
+    }
+
+    interrupt_all(interrupted);
+}
+
+void rate_limiter::on_head_interrupted() noexcept {
+    details::rate_limiter_awaiter* waiters = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        waiters = m_head;
+        m_head = m_tail = nullptr;
+    }
+
+    interrupt_all(waiters);
+}
+
+void rate_limiter::interrupt_all(details::rate_limiter_awaiter* waiters) noexcept {
+    while (waiters != nullptr) {
+        auto next = waiters->m_next_waiter;
+        waiters->m_interrupted = true;
+        waiters->m_caller_handle();
+        waiters = next;
+    }
+}
+
+concurrencpp::details::rate_limiter_awaiter rate_limiter::acquire(std::shared_ptr<executor> resume_executor, size_t count) {
+    if (!static_cast<bool>(resume_executor)) {
+        throw std::invalid_argument(details::consts::k_rate_limiter_acquire_null_executor_err_msg);
+    }
+
+    if (count > m_max_burst) {
+        throw std::invalid_argument(details::consts::k_rate_limiter_acquire_invalid_count_err_msg);
+    }
+
+    return {*this, count, std::move(resume_executor)};
+}
+
+bool rate_limiter::try_acquire(size_t count) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    return try_take(count, m_timer_queue->now());
+}
+
+size_t rate_limiter::available_permits() {
+    std::unique_lock<std::mutex> lock(m_lock);
+    refill(m_timer_queue->now());
+    return m_permits;
+}
+
+size_t rate_limiter::max_burst() const noexcept {
+    return m_max_burst;
+}
@@ -0,0 +1,50 @@
+#include "concurrencpp/timers/retry.h"
+#include "concurrencpp/timers/constants.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace concurrencpp::details {
+    namespace {
+        double next_jitter_sample() noexcept {
+            // a per-thread engine, so concurrent retries neither contend on a lock nor back off in lockstep.
+            thread_local std::minstd_rand engine(std::random_device {}());
+            std::uniform_real_distribution<double> distribution(0.0, 1.0);
+            return distribution(engine);
+        }
+    }  // namespace
+}  // namespace concurrencpp::details
+
+void concurrencpp::details::validate_retry_policy(const retry_policy& policy) {
+    if (policy.max_attempts == 0) {
+        throw std::invalid_argument(consts::k_retry_invalid_max_attempts_err_msg);
+    }
+
+    if (policy.initial_delay.count() < 0 || policy.max_delay.count() < 0) {
+        throw std::invalid_argument(consts::k_retry_invalid_delay_err_msg);
+    }
+
+    if (!(policy.multiplier >= 1.0)) {
+        throw std::invalid_argument(consts::k_retry_invalid_multiplier_err_msg);
+    }
+
+    if (!(policy.jitter >= 0.0 && policy.jitter <= 1.0)) {
+        throw std::invalid_argument(consts::k_retry_invalid_jitter_err_msg);
+    }
+}
+
+std::chrono::milliseconds concurrencpp::details::retry_backoff_delay(const retry_policy& policy, size_t attempt) {
+    const auto max_delay = static_cast<double>(policy.max_delay.count());
+    const auto exponent = static_cast<double>(attempt == 0 ? 0 : attempt - 1);
+    auto backoff = static_cast<double>(policy.initial_delay.count()) * std::pow(policy.multiplier, exponent);
+    if (!(backoff <= max_delay)) {  // also catches overflow to infinity
+        backoff = max_delay;
+    }
+
+    if (policy.jitter > 0.0) {
+        backoff *= 1.0 - policy.jitter * next_jitter_sample();
+    }
+
+    return std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(backoff));
+}
@@ -14,22 +14,17 @@ timer_state_base::timer_state_base(size_t due_time,
                                    size_t frequency,
                                    std::shared_ptr<concurrencpp::executor> executor,
                                    std::weak_ptr<concurrencpp::timer_queue> timer_queue,
-                                   bool is_oneshot) noexcept :
+                                   bool is_oneshot,
+                                   time_point now) noexcept :
     m_timer_queue(std::move(timer_queue)),
-    m_executor(std::move(executor)), m_due_time(due_time), m_frequency(frequency), m_deadline(make_deadline(milliseconds(due_time))),
+    m_executor(std::move(executor)), m_due_time(due_time), m_frequency(frequency), m_deadline(make_deadline(now, milliseconds(due_time))),
     m_cancelled(false), m_is_oneshot(is_oneshot) {
     assert(static_cast<bool>(m_executor));
 }
 
-void timer_state_base::fire() {
+void timer_state_base::update_deadline(time_point now) noexcept {
     const auto frequency = m_frequency.load(std::memory_order_relaxed);
-    m_deadline = make_deadline(milliseconds(frequency));
-
-    assert(static_cast<bool>(m_executor));
-
-    m_executor->post([self = shared_from_this()]() mutable {
-        self->execute();
-    });
+    m_deadline = make_deadline(now, milliseconds(frequency));
 }
 
 timer::timer(std::shared_ptr<timer_state_base> timer_impl) noexcept : m_state(std::move(timer_impl)) {}
@@ -2,8 +2,11 @@
 #include "concurrencpp/timers/timer_queue.h"
 
 #include "concurrencpp/coroutines/coroutine.h"
+#include "concurrencpp/executors/executor.h"
+#include "concurrencpp/executors/task_batch.h"
 
 #include <set>
+#include <stdexcept>
 #include <unordered_map>
 
 #include <cassert>
@@ -12,8 +15,13 @@ using namespace std::chrono;
 
 using concurrencpp::timer;
 using concurrencpp::timer_queue;
+using concurrencpp::details::timer_node;
 using concurrencpp::details::timer_request;
+using concurrencpp::details::timer_node_heap;
+using concurrencpp::details::timer_queue_internal;
+using concurrencpp::details::sleep_awaitable;
 using concurrencpp::details::timer_state_base;
+using concurrencpp::details::task_batch;
 
 using timer_ptr = timer_queue::timer_ptr;
 using time_point = timer_queue::time_point;
@@ -27,124 +35,356 @@ namespace concurrencpp::details {
             }
         };
 
-        class timer_queue_internal {
-            using timer_set = std::multiset<timer_ptr, deadline_comparator>;
-            using timer_set_iterator = typename timer_set::iterator;
-            using iterator_map = std::unordered_map<timer_ptr, timer_set_iterator>;
+        // runs the callable of a fired timer. owns the timer state, so a one-shot timer is kept alive until it's executed.
+        struct timer_execute_functor {
+            timer_ptr timer;
 
-           private:
-            timer_set m_timers;
-            iterator_map m_iterator_mapper;
-
-            void add_timer_internal(timer_ptr new_timer) {
-                assert(m_iterator_mapper.find(new_timer) == m_iterator_mapper.end());
-                auto timer_it = m_timers.emplace(new_timer);
-                m_iterator_mapper.emplace(std::move(new_timer), timer_it);
+            void operator()() noexcept {
+                try {
+                    timer->execute();
+                } catch (...) {
+                    // do nothing
+                }
             }
+        };
+
+        // serializes the threads that drive the virtual time of a timer_queue, and detects a timer that tries to drive
+        // the virtual time from inside advance_to (which would otherwise deadlock).
+        class virtual_time_guard {
+
+           private:
+            std::unique_lock<std::mutex> m_lock;
+            std::atomic_uintptr_t& m_owner_id;
 
-            void remove_timer_internal(timer_ptr existing_timer) {
-                auto timer_it = m_iterator_mapper.find(existing_timer);
-                if (timer_it == m_iterator_mapper.end()) {
-                    assert(existing_timer->is_oneshot() || existing_timer->cancelled());  // the timer was already deleted by
-                                                                                          // the queue when it was fired.
-                    return;
+           public:
+            virtual_time_guard(std::mutex& lock, std::atomic_uintptr_t& owner_id) : m_owner_id(owner_id) {
+                const auto this_thread_id = thread::get_current_virtual_id();
+                if (owner_id.load(std::memory_order_relaxed) == this_thread_id) {
+                    throw std::logic_error(consts::k_timer_queue_advance_reentrancy_err_msg);
                 }
 
-                auto set_iterator = timer_it->second;
-                m_timers.erase(set_iterator);
-                m_iterator_mapper.erase(timer_it);
+                m_lock = std::unique_lock<std::mutex>(lock);
+                owner_id.store(this_thread_id, std::memory_order_relaxed);
             }
 
-            void process_request_queue(request_queue& queue) {
-                for (auto& request : queue) {
-                    auto& timer_ptr = request.first;
-                    const auto opt = request.second;
-
-                    if (opt == timer_request::add) {
-                        add_timer_internal(std::move(timer_ptr));
-                    } else {
-                        remove_timer_internal(std::move(timer_ptr));
-                    }
-                }
+            ~virtual_time_guard() noexcept {
+                m_owner_id.store(0, std::memory_order_relaxed);
             }
+        };
+    }  // namespace
+
+    class timer_queue_internal {
+        using timer_set = std::multiset<timer_ptr, deadline_comparator>;
+        using timer_set_iterator = typename timer_set::iterator;
+        using iterator_map = std::unordered_map<timer_ptr, timer_set_iterator>;
+
+       private:
+        timer_set m_timers;
+        iterator_map m_iterator_mapper;
+        task_batch m_fire_batch;
+
+        void add_timer_internal(timer_ptr new_timer) {
+            assert(m_iterator_mapper.find(new_timer) == m_iterator_mapper.end());
+            auto timer_it = m_timers.emplace(new_timer);
+            m_iterator_mapper.emplace(std::move(new_timer), timer_it);
+        }
 
-            void reset_containers_memory() noexcept {
-                assert(empty());
-                timer_set timers;
-                std::swap(m_timers, timers);
-                iterator_map iterator_mapper;
-                std::swap(m_iterator_mapper, iterator_mapper);
+        void remove_timer_internal(timer_ptr existing_timer) {
+            auto timer_it = m_iterator_mapper.find(existing_timer);
+            if (timer_it == m_iterator_mapper.end()) {
+                assert(existing_timer->is_oneshot() || existing_timer->cancelled());  // the timer was already deleted by
+                                                                                      // the queue when it was fired.
+                return;
             }
 
-           public:
-            bool empty() const noexcept {
-                assert(m_iterator_mapper.size() == m_timers.size());
-                return m_timers.empty();
+            auto set_iterator = timer_it->second;
+            m_timers.erase(set_iterator);
+            m_iterator_mapper.erase(timer_it);
+        }
+
+        void add_to_batch(timer_ptr timer) {
+            const auto& executor = timer->get_executor();
+            m_fire_batch.add(executor, timer_execute_functor {std::move(timer)});
+        }
+
+        void reset_containers_memory() noexcept {
+            assert(empty());
+            timer_set timers;
+            std::swap(m_timers, timers);
+            iterator_map iterator_mapper;
+            std::swap(m_iterator_mapper, iterator_mapper);
+            m_fire_batch.reset_memory();
+        }
+
+       public:
+        bool empty() const noexcept {
+            assert(m_iterator_mapper.size() == m_timers.size());
+            return m_timers.empty();
+        }
+
+        ::time_point process_timers(request_queue& queue, slist<timer_node>& expired_nodes) {
+            process_request_queue(queue);
+
+            const auto now = high_resolution_clock::now();
+            fire_expired(now, expired_nodes);
+
+            if (m_timers.empty()) {
+                reset_containers_memory();
+                return now + std::chrono::hours(24);
             }
 
-            ::time_point process_timers(request_queue& queue) {
-                process_request_queue(queue);
-
-                const auto now = high_resolution_clock::now();
-
-                while (true) {
-                    if (m_timers.empty()) {
-                        break;
-                    }
-
-                    timer_set temp_set;
-
-                    auto first_timer_it = m_timers.begin();  // closest deadline
-                    auto timer_ptr = *first_timer_it;
-                    const auto is_oneshot = timer_ptr->is_oneshot();
-
-                    if (!timer_ptr->expired(now)) {
-                        // if this timer is not expired, the next ones are guaranteed not to, as
-                        // the set is ordered by deadlines.
-                        break;
-                    }
-
-                    // we are going to modify the timer, so first we extract it
-                    auto timer_node = m_timers.extract(first_timer_it);
-
-                    // we cannot use the naked node_handle according to the standard. it must
-                    // be contained somewhere.
-                    auto temp_it = temp_set.insert(std::move(timer_node));
-
-                    // we fire it only if it's not cancelled
-                    const auto cancelled = timer_ptr->cancelled();
-                    if (!cancelled) {
-                        (*temp_it)->fire();
-                    }
-
-                    if (is_oneshot || cancelled) {
-                        m_iterator_mapper.erase(timer_ptr);
-                        continue;  // let the timer die inside temp_set
-                    }
-
-                    // regular timer, re-insert into the right position
-                    timer_node = temp_set.extract(temp_it);
-                    auto new_it = m_timers.insert(std::move(timer_node));
-                    // AppleClang doesn't have std::unordered_map::contains yet
-                    assert(m_iterator_mapper.find(timer_ptr) != m_iterator_mapper.end());
-                    m_iterator_mapper[timer_ptr] = new_it;  // update the iterator map, multiset::extract invalidates the
-                    // timer
+            // get the closest deadline.
+            return next_deadline();
+        }
+
+        void process_request_queue(request_queue& queue) {
+            for (auto& request : queue) {
+                auto& timer_ptr = request.first;
+                const auto opt = request.second;
+
+                if (opt == timer_request::add) {
+                    add_timer_internal(std::move(timer_ptr));
+                } else {
+                    remove_timer_internal(std::move(timer_ptr));
                 }
+            }
+        }
+
+        // fires the expired timers, and the expired timer nodes that were popped from the node heap, as one batch.
+        size_t fire_expired(::time_point now, slist<timer_node>& expired_nodes) {
+            size_t fired = 0;
 
+            while (true) {
                 if (m_timers.empty()) {
-                    reset_containers_memory();
-                    return now + std::chrono::hours(24);
+                    break;
                 }
 
-                // get the closest deadline.
-                return (**m_timers.begin()).get_deadline();
+                auto first_timer_it = m_timers.begin();  // closest deadline
+                if (!(*first_timer_it)->expired(now)) {
+                    // if this timer is not expired, the next ones are guaranteed not to, as
+                    // the set is ordered by deadlines.
+                    break;
+                }
+
+                // we are going to modify the timer, so first we extract it. unlike set elements, the value of a node
+                // handle is mutable, which lets us hand the timer over without copying it.
+                auto timer_node = m_timers.extract(first_timer_it);
+                auto& timer_ptr = timer_node.value();
+
+                // we fire it only if it's not cancelled
+                if (timer_ptr->cancelled()) {
+                    m_iterator_mapper.erase(timer_ptr);
+                    continue;  // let the timer die inside timer_node
+                }
+
+                timer_ptr->update_deadline(now);
+                ++fired;
+
+                if (timer_ptr->is_oneshot()) {
+                    // the timer leaves the queue, the fired task becomes its owner.
+                    m_iterator_mapper.erase(timer_ptr);
+                    add_to_batch(std::move(timer_ptr));
+                    continue;
+                }
+
+                add_to_batch(timer_ptr);
+
+                // regular timer, re-insert into the right position
+                auto new_it = m_timers.insert(std::move(timer_node));
+                // AppleClang doesn't have std::unordered_map::contains yet
+                assert(m_iterator_mapper.find(*new_it) != m_iterator_mapper.end());
+                m_iterator_mapper[*new_it] = new_it;  // update the iterator map, multiset::extract invalidates the
+                // timer
             }
-        };
-    }  // namespace
+
+            while (true) {
+                const auto node = expired_nodes.pop_front();
+                if (node == nullptr) {
+                    break;
+                }
+
+                node->fire(m_fire_batch);  // node might be destroyed after this call
+                ++fired;
+            }
+
+            m_fire_batch.submit();
+            return fired;
+        }
+
+        ::time_point next_deadline() const noexcept {
+            if (m_timers.empty()) {
+                return ::time_point::max();
+            }
+
+            return (**m_timers.begin()).get_deadline();
+        }
+    };
 }  // namespace concurrencpp::details
 
+/*
+ * timer_node_heap
+ */
+
+void timer_node_heap::place(timer_node* node, size_t index) noexcept {
+    m_nodes[index] = node;
+    node->queue_index = index;
+}
+
+void timer_node_heap::sift_up(size_t index) noexcept {
+    const auto node = m_nodes[index];
+
+    while (index != 0) {
+        const auto parent_index = (index - 1) / 2;
+        const auto parent = m_nodes[parent_index];
+        if (parent->deadline <= node->deadline) {
+            break;
+        }
+
+        place(parent, index);
+        index = parent_index;
+    }
+
+    place(node, index);
+}
+
+void timer_node_heap::sift_down(size_t index) noexcept {
+    const auto node = m_nodes[index];
+    const auto size = m_nodes.size();
+
+    while (true) {
+        auto child_index = index * 2 + 1;
+        if (child_index >= size) {
+            break;
+        }
+
+        if (child_index + 1 < size && m_nodes[child_index + 1]->deadline < m_nodes[child_index]->deadline) {
+            ++child_index;
+        }
+
+        const auto child = m_nodes[child_index];
+        if (node->deadline <= child->deadline) {
+            break;
+        }
+
+        place(child, index);
+        index = child_index;
+    }
+
+    place(node, index);
+}
+
+void timer_node_heap::push(timer_node& node) {
+    assert(node.queue_index == timer_node::k_not_queued);
+    m_nodes.emplace_back(&node);
+    sift_up(m_nodes.size() - 1);
+}
+
+bool timer_node_heap::remove(timer_node& node) noexcept {
+    const auto index = node.queue_index;
+    if (index == timer_node::k_not_queued) {
+        return false;
+    }
+
+    assert(index < m_nodes.size());
+    assert(m_nodes[index] == &node);
+
+    node.queue_index = timer_node::k_not_queued;
+
+    const auto last = m_nodes.back();
+    m_nodes.pop_back();
+
+    if (last == &node) {
+        return true;
+    }
+
+    place(last, index);
+
+    if (index != 0 && last->deadline < m_nodes[(index - 1) / 2]->deadline) {
+        sift_up(index);
+    } else {
+        sift_down(index);
+    }
+
+    return true;
+}
+
+void timer_node_heap::pop_expired(timer_node::time_point now, slist<timer_node>& expired) noexcept {
+    while (!m_nodes.empty()) {
+        const auto node = m_nodes.front();
+        if (node->deadline > now) {
+            break;
+        }
+
+        remove(*node);
+        expired.push_back(*node);
+    }
+}
+
+void timer_node_heap::pop_all(slist<timer_node>& nodes) noexcept {
+    for (auto node : m_nodes) {
+        node->queue_index = timer_node::k_not_queued;
+        nodes.push_back(*node);
+    }
+
+    m_nodes.clear();
+}
+
+/*
+ * sleep_awaitable
+ */
+
+sleep_awaitable::sleep_awaitable(timer_queue& parent_queue, time_point deadline, std::shared_ptr<concurrencpp::executor> executor) noexcept :
+    timer_node(deadline), m_parent_queue(parent_queue), m_executor(std::move(executor)) {}
+
+bool sleep_awaitable::await_suspend(coroutine_handle<void> caller_handle) noexcept {
+    m_caller_handle = caller_handle;
+
+    try {
+        m_parent_queue.add_timer_node(*this);
+    } catch (...) {
+        // the queue has been shut down, the error is rethrown to the awaiter in await_resume.
+        m_exception = std::current_exception();
+        return false;
+    }
+
+    return true;
+}
+
+void sleep_awaitable::await_resume() const {
+    if (static_cast<bool>(m_exception)) {
+        std::rethrow_exception(m_exception);
+    }
+
+    if (m_interrupted) {
+        throw errors::broken_task(details::consts::k_broken_task_exception_error_msg);
+    }
+}
+
+void sleep_awaitable::fire(task_batch& batch) noexcept {
+    try {
+        batch.add(m_executor, await_via_functor {m_caller_handle, &m_interrupted});
+    } catch (...) {
+        // if an exception is thrown, await_via_functor d.tor will set an interrupt and resume the coro
+    }
+}
+
+void sleep_awaitable::interrupt() noexcept {
+    m_interrupted = true;
+    m_caller_handle();
+}
+
+/*
+ * timer_queue
+ */
+
 timer_queue::timer_queue(milliseconds max_waiting_time) :
-    m_atomic_abort(false), m_abort(false), m_idle(true), m_max_waiting_time(max_waiting_time) {}
+    m_atomic_abort(false), m_nearest_deadline_changed(false), m_abort(false), m_idle(true), m_max_waiting_time(max_waiting_time),
+    m_virtual_time(false), m_virtual_now(time_point {}), m_advancing_thread_id(0) {}
+
+timer_queue::timer_queue(virtual_time_tag, time_point start_time) :
+    m_atomic_abort(false), m_nearest_deadline_changed(false), m_abort(false), m_idle(true), m_max_waiting_time(0),
+    m_virtual_time(true), m_virtual_now(start_time), m_advancing_thread_id(0),
+    m_virtual_timers(std::make_unique<details::timer_queue_internal>()) {}
 
 timer_queue::~timer_queue() noexcept {
     shutdown();
@@ -175,6 +415,12 @@ void timer_queue::add_timer(std::unique_lock<std::mutex>& lock, timer_ptr new_ti
         throw errors::runtime_shutdown(details::consts::k_timer_queue_shutdown_err_msg);
     }
 
+    if (m_virtual_time) {
+        // picked up by the next call to advance_to
+        m_request_queue.emplace_back(std::move(new_timer), timer_request::add);
+        return;
+    }
+
     auto old_thread = ensure_worker_thread(lock);
     add_internal_timer(lock, new_timer);
 
@@ -183,15 +429,50 @@ void timer_queue::add_timer(std::unique_lock<std::mutex>& lock, timer_ptr new_ti
     }
 }
 
+void timer_queue::add_timer_node(details::timer_node& node) {
+    std::unique_lock<std::mutex> lock(m_lock);
+    if (m_abort) {
+        throw errors::runtime_shutdown(details::consts::k_timer_queue_shutdown_err_msg);
+    }
+
+    if (m_virtual_time) {
+        m_timer_nodes.push(node);
+        return;
+    }
+
+    auto old_thread = ensure_worker_thread(lock);
+    m_timer_nodes.push(node);
+
+    const auto wake_worker = (m_timer_nodes.top() == &node);
+    if (wake_worker) {
+        m_nearest_deadline_changed = true;
+    }
+
+    lock.unlock();
+
+    if (wake_worker) {
+        m_condition.notify_one();
+    }
+
+    if (old_thread.joinable()) {
+        old_thread.join();
+    }
+}
+
+bool timer_queue::remove_timer_node(details::timer_node& node) noexcept {
+    std::unique_lock<std::mutex> lock(m_lock);
+    return m_timer_nodes.remove(node);
+}
+
 void timer_queue::work_loop() {
     time_point next_deadline;
     details::timer_queue_internal internal_state;
 
     while (true) {
         std::unique_lock<decltype(m_lock)> lock(m_lock);
-        if (internal_state.empty()) {
+        if (internal_state.empty() && m_timer_nodes.empty()) {
             const auto res = m_condition.wait_for(lock, m_max_waiting_time, [this] {
-                return !m_request_queue.empty() || m_abort;
+                return !m_request_queue.empty() || !m_timer_nodes.empty() || m_abort;
             });
 
             if (!res) {
@@ -201,8 +482,13 @@ void timer_queue::work_loop() {
             }
 
         } else {
-            m_condition.wait_until(lock, next_deadline, [this] {
-                return !m_request_queue.empty() || m_abort;
+            auto deadline = internal_state.empty() ? time_point::max() : next_deadline;
+            if (!m_timer_nodes.empty()) {
+                deadline = std::min(deadline, m_timer_nodes.top()->deadline);
+            }
+
+            m_condition.wait_until(lock, deadline, [this] {
+                return !m_request_queue.empty() || m_nearest_deadline_changed || m_abort;
             });
         }
 
@@ -210,14 +496,16 @@ void timer_queue::work_loop() {
             return;
         }
 
+        m_nearest_deadline_changed = false;
+
+        details::slist<details::timer_node> expired_nodes;
+        m_timer_nodes.pop_expired(clock_type::now(), expired_nodes);
+
         auto request_queue = std::move(m_request_queue);
         lock.unlock();
 
-        next_deadline = internal_state.process_timers(request_queue);
-        const auto now = clock_type::now();
-        if (next_deadline <= now) {
-            continue;
-        }
+        // a deadline that is already due makes the wait above return immediately.
+        next_deadline = internal_state.process_timers(request_queue, expired_nodes);
     }
 }
 
@@ -231,18 +519,30 @@ void timer_queue::shutdown() {
         return;  // timer_queue has been shut down already.
     }
 
+    details::slist<details::timer_node> pending_nodes;
+
     std::unique_lock<std::mutex> lock(m_lock);
     m_abort = true;
+    m_timer_nodes.pop_all(pending_nodes);
 
-    if (!m_worker.joinable()) {
-        return;  // nothing to shut down
+    if (m_worker.joinable()) {
+        m_request_queue.clear();
+        lock.unlock();
+
+        m_condition.notify_all();
+        m_worker.join();
+    } else {
+        lock.unlock();
     }
 
-    m_request_queue.clear();
-    lock.unlock();
+    while (true) {
+        const auto node = pending_nodes.pop_front();
+        if (node == nullptr) {
+            break;
+        }
 
-    m_condition.notify_all();
-    m_worker.join();
+        node->interrupt();
+    }
 }
 
 concurrencpp::details::thread timer_queue::ensure_worker_thread(std::unique_lock<std::mutex>& lock) {
@@ -264,43 +564,12 @@ concurrencpp::details::thread timer_queue::ensure_worker_thread(std::unique_lock
 concurrencpp::lazy_result<void> timer_queue::make_delay_object_impl(std::chrono::milliseconds due_time,
                                                                     std::shared_ptr<concurrencpp::timer_queue> self,
                                                                     std::shared_ptr<concurrencpp::executor> executor) {
-    class delay_object_awaitable : public details::suspend_always {
-
-       private:
-        const size_t m_due_time_ms;
-        timer_queue& m_parent_queue;
-        std::shared_ptr<concurrencpp::executor> m_executor;
-        bool m_interrupted = false;
-
-       public:
-        delay_object_awaitable(size_t due_time_ms,
-                               timer_queue& parent_queue,
-                               std::shared_ptr<concurrencpp::executor> executor) noexcept :
-            m_due_time_ms(due_time_ms),
-            m_parent_queue(parent_queue), m_executor(std::move(executor)) {}
-
-        void await_suspend(details::coroutine_handle<void> coro_handle) noexcept {
-            try {
-                m_parent_queue.make_timer_impl(m_due_time_ms,
-                                               0,
-                                               std::move(m_executor),
-                                               true,
-                                               details::await_via_functor {coro_handle, &m_interrupted});
-
-            } catch (...) {
-                // if an exception is thrown, await_via_functor d.tor will set an interrupt and resume the coro
-                // no need to let the exception propagate.
-            }
-        }
-
-        void await_resume() const {
-            if (m_interrupted) {
-                throw errors::broken_task(details::consts::k_broken_task_exception_error_msg);
-            }
-        }
-    };
-
-    co_await delay_object_awaitable {static_cast<size_t>(due_time.count()), *this, std::move(executor)};
+    try {
+        co_await details::sleep_awaitable {*self, self->now() + due_time, std::move(executor)};
+    } catch (const errors::runtime_shutdown&) {
+        // delay objects have always reported a shut down queue as a broken task
+        throw errors::broken_task(details::consts::k_broken_task_exception_error_msg);
+    }
 }
 
 concurrencpp::lazy_result<void> timer_queue::make_delay_object(std::chrono::milliseconds due_time,
@@ -312,6 +581,114 @@ concurrencpp::lazy_result<void> timer_queue::make_delay_object(std::chrono::mill
     return make_delay_object_impl(due_time, shared_from_this(), std::move(executor));
 }
 
+sleep_awaitable timer_queue::sleep_for(std::chrono::milliseconds due_time, std::shared_ptr<executor> executor) {
+    if (!static_cast<bool>(executor)) {
+        throw std::invalid_argument(details::consts::k_timer_queue_sleep_for_executor_null_err_msg);
+    }
+
+    return {*this, now() + due_time, std::move(executor)};
+}
+
+sleep_awaitable timer_queue::sleep_until(time_point deadline, std::shared_ptr<executor> executor) {
+    if (!static_cast<bool>(executor)) {
+        throw std::invalid_argument(details::consts::k_timer_queue_sleep_until_executor_null_err_msg);
+    }
+
+    return {*this, deadline, std::move(executor)};
+}
+
 milliseconds timer_queue::max_worker_idle_time() const noexcept {
     return m_max_waiting_time;
 }
+
+bool timer_queue::uses_virtual_time() const noexcept {
+    return m_virtual_time;
+}
+
+timer_queue::time_point timer_queue::now() const noexcept {
+    if (m_virtual_time) {
+        return m_virtual_now.load(std::memory_order_acquire);
+    }
+
+    return clock_type::now();
+}
+
+timer_queue::time_point timer_queue::next_deadline_impl() {
+    assert(m_virtual_time);
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    auto request_queue = std::move(m_request_queue);
+
+    auto deadline = time_point::max();
+    if (!m_timer_nodes.empty()) {
+        deadline = m_timer_nodes.top()->deadline;
+    }
+
+    lock.unlock();
+
+    // m_virtual_timers is only accessed by the thread that holds m_advance_lock
+    m_virtual_timers->process_request_queue(request_queue);
+    return std::min(deadline, m_virtual_timers->next_deadline());
+}
+
+timer_queue::time_point timer_queue::next_deadline() {
+    if (!m_virtual_time) {
+        throw std::logic_error(details::consts::k_timer_queue_next_deadline_not_virtual_err_msg);
+    }
+
+    details::virtual_time_guard guard(m_advance_lock, m_advancing_thread_id);
+    return next_deadline_impl();
+}
+
+size_t timer_queue::advance_to(time_point new_now) {
+    if (!m_virtual_time) {
+        throw std::logic_error(details::consts::k_timer_queue_advance_to_not_virtual_err_msg);
+    }
+
+    details::virtual_time_guard guard(m_advance_lock, m_advancing_thread_id);
+    size_t fired = 0;
+
+    /*
+     * timers are fired one deadline at a time, with the virtual clock set to that deadline. this way, timers that are
+     * scheduled by fired timers (periodic timers, chained sleeps) are fired in order, as long as they are due before new_now.
+     */
+    while (!shutdown_requested()) {
+        const auto deadline = next_deadline_impl();
+
+        // with no pending timers the deadline is time_point::max(), nothing expires even if new_now is max() as well.
+        if (deadline > new_now || deadline == time_point::max()) {
+            break;
+        }
+
+        const auto now = std::max(deadline, m_virtual_now.load(std::memory_order_relaxed));
+        m_virtual_now.store(now, std::memory_order_release);
+
+        details::slist<details::timer_node> expired_nodes;
+
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_timer_nodes.pop_expired(now, expired_nodes);
+        }
+
+        fired += m_virtual_timers->fire_expired(now, expired_nodes);
+    }
+
+    /*
+     * an unbounded target (time_point::max()) means "fire everything that's pending", not "move to the end of time":
+     * pinning the clock at max() would overflow every deadline computed from it afterwards (now + due_time).
+     * in that case the clock stays on the last fired deadline.
+     */
+    if (new_now != time_point::max() && new_now > m_virtual_now.load(std::memory_order_relaxed)) {
+        m_virtual_now.store(new_now, std::memory_order_release);
+    }
+
+    return fired;
+}
+
+size_t timer_queue::advance_by(std::chrono::milliseconds duration) {
+    if (!m_virtual_time) {
+        throw std::logic_error(details::consts::k_timer_queue_advance_by_not_virtual_err_msg);
+    }
+
+    return advance_to(now() + duration);
+}
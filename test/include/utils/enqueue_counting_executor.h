@@ -0,0 +1,42 @@
+#ifndef CONCURRENCPP_ENQUEUE_COUNTING_EXECUTOR_H
+#define CONCURRENCPP_ENQUEUE_COUNTING_EXECUTOR_H
+
+#include "concurrencpp/executors/executor.h"
+
+#include <vector>
+
+namespace concurrencpp::tests {
+    // runs the enqueued tasks inline, and records how they were enqueued.
+    struct enqueue_counting_executor : public concurrencpp::executor {
+        size_t single_enqueues = 0;
+        std::vector<size_t> batch_sizes;
+
+        enqueue_counting_executor() : executor("enqueue_counting_executor") {}
+
+        void enqueue(concurrencpp::task task) override {
+            ++single_enqueues;
+            task();
+        }
+
+        void enqueue(std::span<concurrencpp::task> tasks) override {
+            batch_sizes.emplace_back(tasks.size());
+            for (auto& task : tasks) {
+                task();
+            }
+        }
+
+        int max_concurrency_level() const noexcept override {
+            return 0;
+        }
+
+        bool shutdown_requested() const noexcept override {
+            return false;
+        }
+
+        void shutdown() noexcept override {
+            // do nothing
+        }
+    };
+}  // namespace concurrencpp::tests
+
+#endif
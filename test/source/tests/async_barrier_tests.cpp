@@ -0,0 +1,215 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/custom_exception.h"
+#include "utils/executor_shutdowner.h"
+
+#include "concurrencpp/threads/constants.h"
+
+namespace concurrencpp::tests {
+    void test_async_barrier_constructor();
+    void test_async_barrier_arrive_and_wait();
+    void test_async_barrier_arrive_and_drop();
+    void test_async_barrier_completion_exception();
+    void test_async_barrier_mini_load_test();
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_async_barrier_constructor() {
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            async_barrier barrier(0);
+        },
+        concurrencpp::details::consts::k_async_barrier_invalid_expected_err_msg);
+
+    async_barrier barrier(2);
+    assert_equal(barrier.phase(), static_cast<size_t>(0));
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&barrier] {
+            barrier.arrive_and_wait({});
+        },
+        concurrencpp::details::consts::k_async_barrier_arrive_and_wait_null_resume_executor_err_msg);
+}
+
+void concurrencpp::tests::test_async_barrier_arrive_and_wait() {
+    constexpr size_t participants = 4;
+    constexpr size_t phases = 5;
+
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    size_t completions = 0;
+    async_barrier barrier(participants, [&completions] {
+        ++completions;
+    });
+
+    std::vector<size_t> progress(participants, 0);
+    const auto participant = [&](size_t id) -> result<void> {
+        for (size_t i = 0; i < phases; i++) {
+            co_await barrier.arrive_and_wait(executor);
+            ++progress[id];
+        }
+    };
+
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < participants; i++) {
+        results.emplace_back(participant(i));
+    }
+
+    // the last participant completes the phase without suspending, then waits at the next one
+    assert_equal(completions, static_cast<size_t>(1));
+    assert_equal(barrier.phase(), static_cast<size_t>(1));
+    assert_equal(progress[participants - 1], static_cast<size_t>(1));
+    assert_equal(executor->size(), participants - 1);
+
+    // no participant gets ahead of the others
+    while (executor->loop_once()) {
+        const auto [min, max] = std::minmax_element(progress.begin(), progress.end());
+        assert_smaller_equal(*max - *min, static_cast<size_t>(1));
+    }
+
+    assert_equal(completions, phases);
+    assert_equal(barrier.phase(), phases);
+    for (size_t i = 0; i < participants; i++) {
+        assert_equal(progress[i], phases);
+        results[i].get();
+    }
+}
+
+void concurrencpp::tests::test_async_barrier_arrive_and_drop() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    async_barrier barrier(3);
+
+    size_t passed = 0;
+    const auto participant = [&]() -> result<void> {
+        co_await barrier.arrive_and_wait(executor);
+        ++passed;
+        co_await barrier.arrive_and_wait(executor);
+        ++passed;
+    };
+
+    auto result_0 = participant();
+    auto result_1 = participant();
+
+    // dropping counts as an arrival, and the next phases expect one participant less
+    barrier.arrive_and_drop();
+    assert_equal(barrier.phase(), static_cast<size_t>(1));
+
+    executor->loop(100);
+    assert_equal(passed, static_cast<size_t>(4));
+    assert_equal(barrier.phase(), static_cast<size_t>(2));
+
+    result_0.get();
+    result_1.get();
+
+    // all the participants dropped
+    barrier.arrive_and_drop();
+    barrier.arrive_and_drop();
+    assert_equal(barrier.phase(), static_cast<size_t>(3));
+
+    assert_throws_contains_error_message<std::system_error>(
+        [&barrier] {
+            barrier.arrive_and_drop();
+        },
+        concurrencpp::details::consts::k_async_barrier_arrive_no_participants_err_msg);
+}
+
+void concurrencpp::tests::test_async_barrier_completion_exception() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    size_t completions = 0;
+    async_barrier barrier(2, [&completions] {
+        ++completions;
+        if (completions == 1) {
+            throw custom_exception(1234);
+        }
+    });
+
+    size_t passed = 0;
+    const auto participant = [&]() -> result<void> {
+        co_await barrier.arrive_and_wait(executor);
+        ++passed;
+        co_await barrier.arrive_and_wait(executor);
+        ++passed;
+    };
+
+    auto result = participant();
+
+    // the exception goes to the participant that completed the phase, the phase completes anyway
+    assert_throws<custom_exception>([&barrier] {
+        barrier.arrive_and_drop();
+    });
+
+    assert_equal(barrier.phase(), static_cast<size_t>(1));
+
+    executor->loop(100);
+    assert_equal(passed, static_cast<size_t>(2));
+    assert_equal(completions, static_cast<size_t>(2));
+    assert_equal(barrier.phase(), static_cast<size_t>(2));
+
+    // the drop was not rolled back
+    result.get();
+}
+
+void concurrencpp::tests::test_async_barrier_mini_load_test() {
+    constexpr size_t participants = 64;
+    constexpr size_t phases = 200;
+
+    auto executor = std::make_shared<concurrencpp::thread_pool_executor>("barrier pool", 4, std::chrono::seconds(10));
+    executor_shutdowner es(executor);
+
+    std::atomic_size_t arrivals {0};
+    std::atomic_bool violation {false};
+    size_t completions = 0;
+
+    async_barrier barrier(participants, [&] {
+        if (arrivals.load() != (completions + 1) * participants) {
+            violation = true;
+        }
+
+        ++completions;
+    });
+
+    const auto participant = [&](executor_tag, std::shared_ptr<thread_pool_executor>) -> result<void> {
+        for (size_t i = 0; i < phases; i++) {
+            arrivals.fetch_add(1);
+            co_await barrier.arrive_and_wait(executor);
+
+            if (barrier.phase() < i + 1) {
+                violation = true;
+            }
+        }
+    };
+
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < participants; i++) {
+        results.emplace_back(participant({}, executor));
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_false(violation.load());
+    assert_equal(completions, phases);
+    assert_equal(barrier.phase(), phases);
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("async_barrier test");
+
+    tester.add_step("constructor", test_async_barrier_constructor);
+    tester.add_step("arrive_and_wait", test_async_barrier_arrive_and_wait);
+    tester.add_step("arrive_and_drop", test_async_barrier_arrive_and_drop);
+    tester.add_step("completion exceptions", test_async_barrier_completion_exception);
+    tester.add_step("mini load test", test_async_barrier_mini_load_test);
+
+    tester.launch_test();
+    return 0;
+}
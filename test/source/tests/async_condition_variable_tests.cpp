@@ -3,6 +3,7 @@
 #include "infra/tester.h"
 #include "infra/assertions.h"
 #include "utils/executor_shutdowner.h"
+#include "utils/enqueue_counting_executor.h"
 
 #include "concurrencpp/threads/constants.h"
 
@@ -19,6 +20,9 @@ namespace concurrencpp::tests {
 
     void test_async_condition_variable_notify_one();
     void test_async_condition_variable_notify_all();
+    void test_async_condition_variable_notify_all_batched();
+    void test_async_condition_variable_notify_all_wait_morphing();
+    void test_async_condition_variable_resume_executor_shutdown();
 }  // namespace concurrencpp::tests
 
 using namespace concurrencpp::tests;
@@ -222,6 +226,113 @@ void tests::test_async_condition_variable_notify_all() {
     }
 }
 
+void tests::test_async_condition_variable_notify_all_batched() {
+    constexpr size_t task_count = 16;
+
+    async_condition_variable cv;
+    std::vector<std::unique_ptr<async_lock>> locks;
+    const auto executor = std::make_shared<enqueue_counting_executor>();
+    size_t woken = 0;
+
+    auto task = [&](async_lock& lock) -> result<void> {
+        auto sal = co_await lock.lock(executor);
+        co_await cv.await(executor, sal);
+        ++woken;
+    };
+
+    // every task waits with its own lock, so all of them can acquire their lock when notified
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < task_count; i++) {
+        locks.emplace_back(std::make_unique<async_lock>());
+        results.emplace_back(task(*locks.back()));
+    }
+
+    assert_equal(woken, static_cast<size_t>(0));
+    cv.notify_all();
+    assert_equal(woken, task_count);
+
+    // lock.lock() did not suspend, so the only enqueue is the batch of notify_all
+    assert_equal(executor->single_enqueues, static_cast<size_t>(0));
+    assert_equal(executor->batch_sizes.size(), static_cast<size_t>(1));
+    assert_equal(executor->batch_sizes[0], task_count);
+
+    for (auto& result : results) {
+        result.get();
+    }
+}
+
+void tests::test_async_condition_variable_notify_all_wait_morphing() {
+    constexpr size_t task_count = 16;
+
+    async_lock lock;
+    async_condition_variable cv;
+    const auto executor = std::make_shared<manual_executor>();
+    executor_shutdowner es(executor);
+    std::vector<size_t> log;
+
+    auto task = [&](size_t id) -> result<void> {
+        auto sal = co_await lock.lock(executor);
+        co_await cv.await(executor, sal);
+        log.emplace_back(id);
+    };
+
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < task_count; i++) {
+        results.emplace_back(task(i));
+    }
+
+    // notified while the lock is held: tasks are moved to the waiters of the lock instead of being woken up
+    assert_true(lock.try_lock());
+    const auto waits_before = lock.stats().waits;
+    cv.notify_all();
+    assert_equal(executor->size(), static_cast<size_t>(0));
+    assert_equal(lock.stats().waits, waits_before + task_count);
+
+    // every unlock hands the lock to the next task, only the owner is ever scheduled
+    lock.unlock();
+    for (size_t i = 0; i < task_count; i++) {
+        assert_equal(executor->size(), static_cast<size_t>(1));
+        assert_true(executor->loop_once());
+    }
+
+    assert_equal(executor->size(), static_cast<size_t>(0));
+    assert_equal(log.size(), task_count);
+    for (size_t i = 0; i < task_count; i++) {
+        assert_equal(log[i], i);
+        results[i].get();
+    }
+}
+
+void tests::test_async_condition_variable_resume_executor_shutdown() {
+    async_lock lock;
+    async_condition_variable cv;
+    const auto executor = std::make_shared<manual_executor>();
+    const auto working_executor = std::make_shared<manual_executor>();
+    executor_shutdowner es(working_executor);
+
+    auto task = [&](std::shared_ptr<manual_executor> ex) -> result<void> {
+        auto sal = co_await lock.lock(ex);
+        co_await cv.await(ex, sal);
+    };
+
+    auto result_0 = task(executor);
+    auto result_1 = task(working_executor);
+
+    // the first task acquires the lock but can't be resumed. it must not keep the lock locked.
+    executor->shutdown();
+    cv.notify_all();
+
+    assert_throws<errors::broken_task>([&result_0] {
+        result_0.get();
+    });
+
+    assert_true(working_executor->loop_once());
+    result_1.get();
+
+    assert_true(lock.try_lock());
+    lock.unlock();
+}
+
 int main() {
     tester tester("async_condition_variable test");
 
@@ -229,6 +340,9 @@ int main() {
     tester.add_step("await + pred", test_async_condition_variable_await_pred);
     tester.add_step("notify_one", test_async_condition_variable_notify_one);
     tester.add_step("notify_all", test_async_condition_variable_notify_all);
+    tester.add_step("notify_all - batched", test_async_condition_variable_notify_all_batched);
+    tester.add_step("notify_all - wait morphing", test_async_condition_variable_notify_all_wait_morphing);
+    tester.add_step("resume executor shutdown", test_async_condition_variable_resume_executor_shutdown);
 
     tester.launch_test();
     return 0;
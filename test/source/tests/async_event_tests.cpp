@@ -0,0 +1,155 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/executor_shutdowner.h"
+#include "utils/enqueue_counting_executor.h"
+
+#include "concurrencpp/threads/constants.h"
+
+namespace concurrencpp::tests {
+    void test_async_manual_reset_event_wait_null_resume_executor();
+    void test_async_manual_reset_event_set_reset();
+    void test_async_manual_reset_event_wait();
+    void test_async_manual_reset_event_batched_set();
+    void test_async_manual_reset_event_resume_executor_shutdown();
+
+    result<void> wait_and_log(async_manual_reset_event& event, std::shared_ptr<executor> ex, std::vector<size_t>& log, size_t id) {
+        co_await event.wait(ex);
+        log.emplace_back(id);
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_async_manual_reset_event_wait_null_resume_executor() {
+    async_manual_reset_event event;
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&event] {
+            event.wait({});
+        },
+        concurrencpp::details::consts::k_async_manual_reset_event_wait_null_resume_executor_err_msg);
+}
+
+void concurrencpp::tests::test_async_manual_reset_event_set_reset() {
+    async_manual_reset_event event;
+    assert_false(event.is_set());
+
+    event.set();
+    assert_true(event.is_set());
+    event.set();
+    assert_true(event.is_set());
+
+    event.reset();
+    assert_false(event.is_set());
+    event.reset();
+    assert_false(event.is_set());
+
+    async_manual_reset_event set_event(true);
+    assert_true(set_event.is_set());
+}
+
+void concurrencpp::tests::test_async_manual_reset_event_wait() {
+    async_manual_reset_event event;
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    std::vector<size_t> log;
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < 8; i++) {
+        results.emplace_back(wait_and_log(event, executor, log, i));
+    }
+
+    assert_equal(executor->size(), static_cast<size_t>(0));
+    assert_true(log.empty());
+
+    // all the waiters are resumed inside their executor, in the order they arrived
+    event.set();
+    assert_equal(executor->loop(100), static_cast<size_t>(8));
+
+    assert_equal(log.size(), static_cast<size_t>(8));
+    for (size_t i = 0; i < log.size(); i++) {
+        assert_equal(log[i], i);
+        results[i].get();
+    }
+
+    // a set event doesn't suspend its waiters
+    auto result = wait_and_log(event, executor, log, 8);
+    assert_equal(result.status(), result_status::value);
+    assert_equal(executor->size(), static_cast<size_t>(0));
+
+    // until it's reset
+    event.reset();
+    result = wait_and_log(event, executor, log, 9);
+    assert_equal(result.status(), result_status::idle);
+
+    event.set();
+    assert_true(executor->loop_once());
+    result.get();
+    assert_equal(log.size(), static_cast<size_t>(10));
+}
+
+void concurrencpp::tests::test_async_manual_reset_event_batched_set() {
+    constexpr size_t waiter_count = 1'000;
+
+    async_manual_reset_event event;
+    auto executor_0 = std::make_shared<enqueue_counting_executor>();
+    auto executor_1 = std::make_shared<enqueue_counting_executor>();
+
+    std::vector<size_t> log;
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < waiter_count; i++) {
+        std::shared_ptr<executor> executor = (i % 2 == 0) ? executor_0 : executor_1;
+        results.emplace_back(wait_and_log(event, executor, log, i));
+    }
+
+    // each executor gets all of its waiters in a single enqueue
+    event.set();
+    assert_equal(log.size(), waiter_count);
+
+    for (const auto& executor : {executor_0, executor_1}) {
+        assert_equal(executor->single_enqueues, static_cast<size_t>(0));
+        assert_equal(executor->batch_sizes.size(), static_cast<size_t>(1));
+        assert_equal(executor->batch_sizes[0], waiter_count / 2);
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+}
+
+void concurrencpp::tests::test_async_manual_reset_event_resume_executor_shutdown() {
+    async_manual_reset_event event;
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    auto working_executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(working_executor);
+
+    std::vector<size_t> log;
+    auto result_0 = wait_and_log(event, executor, log, 0);
+    auto result_1 = wait_and_log(event, working_executor, log, 1);
+
+    executor->shutdown();
+    event.set();
+
+    assert_throws<errors::broken_task>([&result_0] {
+        result_0.get();
+    });
+
+    assert_true(working_executor->loop_once());
+    result_1.get();
+    assert_equal(log.size(), static_cast<size_t>(1));
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("async_manual_reset_event test");
+
+    tester.add_step("wait - null resume executor", test_async_manual_reset_event_wait_null_resume_executor);
+    tester.add_step("set + reset", test_async_manual_reset_event_set_reset);
+    tester.add_step("wait", test_async_manual_reset_event_wait);
+    tester.add_step("batched set", test_async_manual_reset_event_batched_set);
+    tester.add_step("resume executor shutdown", test_async_manual_reset_event_resume_executor_shutdown);
+
+    tester.launch_test();
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/executor_shutdowner.h"
+
+#include "concurrencpp/threads/constants.h"
+
+namespace concurrencpp::tests {
+    void test_async_latch_null_resume_executor();
+    void test_async_latch_count_down();
+    void test_async_latch_wait();
+    void test_async_latch_mini_load_test();
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_async_latch_null_resume_executor() {
+    async_latch latch(1);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&latch] {
+            latch.wait({});
+        },
+        concurrencpp::details::consts::k_async_latch_wait_null_resume_executor_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&latch] {
+            latch.arrive_and_wait({});
+        },
+        concurrencpp::details::consts::k_async_latch_arrive_and_wait_null_resume_executor_err_msg);
+
+    // a failed arrive_and_wait doesn't count down
+    assert_false(latch.try_wait());
+}
+
+void concurrencpp::tests::test_async_latch_count_down() {
+    async_latch latch(5);
+    assert_false(latch.try_wait());
+
+    latch.count_down(3);
+    assert_false(latch.try_wait());
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&latch] {
+            latch.count_down(3);
+        },
+        concurrencpp::details::consts::k_async_latch_count_down_invalid_update_err_msg);
+
+    latch.count_down(0);
+    latch.count_down();
+    assert_false(latch.try_wait());
+    latch.count_down();
+    assert_true(latch.try_wait());
+
+    async_latch empty_latch(0);
+    assert_true(empty_latch.try_wait());
+}
+
+void concurrencpp::tests::test_async_latch_wait() {
+    async_latch latch(3);
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    size_t passed = 0;
+    auto waiter = [&]() -> result<void> {
+        co_await latch.wait(executor);
+        ++passed;
+    };
+
+    auto arriver = [&]() -> result<void> {
+        co_await latch.arrive_and_wait(executor);
+        ++passed;
+    };
+
+    auto result_0 = waiter();
+    auto result_1 = arriver();
+    auto result_2 = arriver();
+    assert_equal(passed, static_cast<size_t>(0));
+
+    // the last arrival doesn't suspend, and resumes the others
+    auto result_3 = arriver();
+    assert_equal(passed, static_cast<size_t>(1));
+    assert_equal(executor->loop(100), static_cast<size_t>(3));
+    assert_equal(passed, static_cast<size_t>(4));
+
+    for (auto* result : {&result_0, &result_1, &result_2, &result_3}) {
+        result->get();
+    }
+}
+
+void concurrencpp::tests::test_async_latch_mini_load_test() {
+    constexpr size_t task_count = 1'024;
+
+    auto executor = std::make_shared<concurrencpp::thread_pool_executor>("latch pool", 4, std::chrono::seconds(10));
+    executor_shutdowner es(executor);
+
+    async_latch latch(task_count);
+    std::atomic_size_t before {0};
+    std::atomic_bool violation {false};
+
+    const auto task = [&](executor_tag, std::shared_ptr<thread_pool_executor>) -> result<void> {
+        before.fetch_add(1);
+        co_await latch.arrive_and_wait(executor);
+
+        if (before.load() != task_count) {
+            violation = true;
+        }
+    };
+
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < task_count; i++) {
+        results.emplace_back(task({}, executor));
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_false(violation.load());
+    assert_true(latch.try_wait());
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("async_latch test");
+
+    tester.add_step("null resume executor", test_async_latch_null_resume_executor);
+    tester.add_step("count_down", test_async_latch_count_down);
+    tester.add_step("wait", test_async_latch_wait);
+    tester.add_step("mini load test", test_async_latch_mini_load_test);
+
+    tester.launch_test();
+    return 0;
+}
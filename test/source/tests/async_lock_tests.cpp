@@ -12,6 +12,9 @@ namespace concurrencpp::tests {
     void test_async_lock_lock();
 
     void test_async_lock_try_lock();
+    void test_async_lock_fifo_order();
+    void test_async_lock_barging();
+    void test_async_lock_bounded_barging();
 
     void test_async_lock_unlock_resumption_fails();
     void test_async_lock_unlock();
@@ -88,11 +91,11 @@ void concurrencpp::tests::test_async_lock_lock() {
 
 void concurrencpp::tests::test_async_lock_try_lock() {
     async_lock lock;
-    assert_true(lock.try_lock().run().get());
-    assert_false(lock.try_lock().run().get());
+    assert_true(lock.try_lock());
+    assert_false(lock.try_lock());
 
     lock.unlock();
-    assert_true(lock.try_lock().run().get());
+    assert_true(lock.try_lock());
 
     lock.unlock();
 }
@@ -101,8 +104,179 @@ namespace concurrencpp::tests {
     result<void> lock_coro(async_lock& lock, std::shared_ptr<executor> ex) {
         auto g = co_await lock.lock(ex);
     }
+
+    result<void> lock_and_record(async_lock& lock, std::shared_ptr<executor> ex, std::vector<size_t>& order, size_t id) {
+        auto g = co_await lock.lock(ex);
+        order.emplace_back(id);
+    }
 }  // namespace concurrencpp::tests
 
+void concurrencpp::tests::test_async_lock_fifo_order() {
+    constexpr size_t waiter_count = 64;
+
+    async_lock lock(async_lock_mode::fifo_handoff);
+    assert_equal(lock.mode(), async_lock_mode::fifo_handoff);
+
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    std::vector<size_t> order;
+    std::vector<result<void>> results;
+
+    assert_true(lock.try_lock());
+
+    for (size_t i = 0; i < waiter_count; i++) {
+        results.emplace_back(lock_and_record(lock, executor, order, i));
+    }
+
+    assert_false(lock.try_lock());
+
+    // unlock hands the lock directly to the oldest waiter, which is then resumed by its executor
+    lock.unlock();
+
+    for (size_t i = 0; i < waiter_count; i++) {
+        assert_false(lock.try_lock());
+        assert_equal(executor->loop_once(), true);
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_equal(order.size(), waiter_count);
+    for (size_t i = 0; i < waiter_count; i++) {
+        assert_equal(order[i], i);
+    }
+
+    // the last owner released the lock
+    assert_true(lock.try_lock());
+    lock.unlock();
+
+    const auto stats = lock.stats();
+    assert_equal(stats.waits, waiter_count);
+    assert_equal(stats.handoffs, waiter_count);
+    assert_equal(stats.barging_wakeups, static_cast<size_t>(0));
+    assert_equal(stats.average_queue_length, (waiter_count + 1) / 2.0);
+}
+
+void concurrencpp::tests::test_async_lock_barging() {
+    async_lock lock;
+    assert_equal(lock.mode(), async_lock_mode::barging);
+
+    auto executor_0 = std::make_shared<concurrencpp::manual_executor>();
+    auto executor_1 = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es0(executor_0);
+    executor_shutdowner es1(executor_1);
+
+    std::vector<size_t> order;
+    assert_true(lock.try_lock());
+    auto result_0 = lock_and_record(lock, executor_0, order, 0);
+    auto result_1 = lock_and_record(lock, executor_1, order, 1);
+
+    // unlock releases the lock and reschedules the oldest waiter, running tasks barge in meanwhile
+    lock.unlock();
+    assert_equal(executor_0->size(), static_cast<size_t>(1));
+    assert_true(lock.try_lock());
+
+    lock.unlock();
+    assert_equal(executor_1->size(), static_cast<size_t>(1));
+    assert_true(lock.try_lock());
+
+    // both waiters lose the race, the younger one is queued again first
+    assert_true(executor_1->loop_once());
+    assert_true(executor_0->loop_once());
+    assert_equal(result_0.status(), result_status::idle);
+    assert_equal(result_1.status(), result_status::idle);
+
+    // they keep their original order, no matter in which order they lost
+    lock.unlock();
+    assert_equal(executor_0->size(), static_cast<size_t>(1));
+    assert_equal(executor_1->size(), static_cast<size_t>(0));
+
+    assert_true(executor_0->loop_once());
+    result_0.get();
+    assert_equal(executor_1->size(), static_cast<size_t>(1));
+
+    assert_true(executor_1->loop_once());
+    result_1.get();
+
+    assert_equal(order, std::vector<size_t> {0, 1});
+    assert_true(lock.try_lock());
+    lock.unlock();
+
+    const auto stats = lock.stats();
+    assert_equal(stats.waits, static_cast<size_t>(4));
+    assert_equal(stats.handoffs, static_cast<size_t>(0));
+    assert_equal(stats.barging_wakeups, static_cast<size_t>(4));
+}
+
+void concurrencpp::tests::test_async_lock_bounded_barging() {
+    constexpr size_t max_barging = 2;
+
+    async_lock lock(async_lock_mode::bounded_barging, max_barging);
+    assert_equal(lock.mode(), async_lock_mode::bounded_barging);
+
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    std::vector<size_t> order;
+    assert_true(lock.try_lock());
+    auto result = lock_and_record(lock, executor, order, 0);
+
+    // unlock releases the lock and reschedules the waiter. meanwhile, a running task barges in.
+    for (size_t i = 0; i < max_barging; i++) {
+        lock.unlock();
+        assert_equal(executor->size(), static_cast<size_t>(1));
+        assert_true(lock.try_lock());
+
+        // the waiter loses the race and waits again
+        assert_true(executor->loop_once());
+        assert_equal(result.status(), result_status::idle);
+    }
+
+    // the waiter lost max_barging times, now it's handed the lock directly
+    lock.unlock();
+    assert_false(lock.try_lock());
+    assert_true(executor->loop_once());
+    result.get();
+    assert_equal(order.size(), static_cast<size_t>(1));
+
+    assert_true(lock.try_lock());
+    lock.unlock();
+
+    const auto stats = lock.stats();
+    assert_equal(stats.waits, max_barging + 1);
+    assert_equal(stats.handoffs, static_cast<size_t>(1));
+    assert_equal(stats.barging_wakeups, max_barging);
+    assert_equal(stats.average_queue_length, 1.0);
+
+    // mutual exclusion still holds under load
+    async_lock loaded_lock(async_lock_mode::bounded_barging);
+    size_t counter = 0;
+    constexpr size_t worker_count = 4;
+    constexpr size_t cycles = 10'000;
+
+    std::vector<std::shared_ptr<worker_thread_executor>> workers(worker_count);
+    std::vector<concurrencpp::result<void>> results(worker_count);
+
+    for (size_t i = 0; i < worker_count; i++) {
+        workers[i] = std::make_shared<worker_thread_executor>();
+        results[i] = incremenet({}, workers[i], loaded_lock, counter, cycles);
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_true(loaded_lock.try_lock());
+    assert_equal(counter, worker_count * cycles);
+    loaded_lock.unlock();
+
+    for (auto& worker : workers) {
+        worker->shutdown();
+    }
+}
+
 void concurrencpp::tests::test_async_lock_unlock_resumption_fails() {
     /* let's say that one coroutine tried to lock a lock and failed because the lock is already locked.
      * that coroutine was queued for resumption for when async_lock::unlock is called.
@@ -241,6 +415,9 @@ int main() {
 
     tester.add_step("lock", test_async_lock_lock);
     tester.add_step("try_lock", test_async_lock_try_lock);
+    tester.add_step("fifo order", test_async_lock_fifo_order);
+    tester.add_step("barging", test_async_lock_barging);
+    tester.add_step("bounded barging", test_async_lock_bounded_barging);
     tester.add_step("unlock", test_async_lock_unlock);
     tester.add_step("lock + unlock", test_async_lock_lock_unlock);
 
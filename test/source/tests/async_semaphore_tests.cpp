@@ -0,0 +1,235 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/executor_shutdowner.h"
+#include "utils/enqueue_counting_executor.h"
+
+#include "concurrencpp/threads/constants.h"
+
+namespace concurrencpp::tests {
+    void test_async_semaphore_acquire_null_resume_executor();
+    void test_async_semaphore_try_acquire();
+    void test_async_semaphore_acquire();
+    void test_async_semaphore_fifo_order();
+    void test_async_semaphore_batched_release();
+    void test_async_semaphore_resume_executor_shutdown();
+    void test_async_semaphore_mini_load_test();
+
+    result<void> acquire(async_semaphore& semaphore, std::shared_ptr<executor> ex, size_t count, std::vector<size_t>& log, size_t id) {
+        co_await semaphore.acquire(ex, count);
+        log.emplace_back(id);
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_async_semaphore_acquire_null_resume_executor() {
+    async_semaphore semaphore(1);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&semaphore] {
+            semaphore.acquire({});
+        },
+        concurrencpp::details::consts::k_async_semaphore_acquire_null_resume_executor_err_msg);
+
+    assert_equal(semaphore.available_permits(), static_cast<size_t>(1));
+}
+
+void concurrencpp::tests::test_async_semaphore_try_acquire() {
+    async_semaphore semaphore(5);
+    assert_equal(semaphore.available_permits(), static_cast<size_t>(5));
+
+    assert_true(semaphore.try_acquire(3));
+    assert_true(semaphore.try_acquire());
+    assert_false(semaphore.try_acquire(2));
+    assert_true(semaphore.try_acquire());
+    assert_false(semaphore.try_acquire());
+    assert_true(semaphore.try_acquire(0));
+
+    semaphore.release(4);
+    assert_equal(semaphore.available_permits(), static_cast<size_t>(4));
+    assert_true(semaphore.try_acquire(4));
+    assert_equal(semaphore.available_permits(), static_cast<size_t>(0));
+}
+
+void concurrencpp::tests::test_async_semaphore_acquire() {
+    async_semaphore semaphore(2);
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    std::vector<size_t> log;
+
+    // permits are available, tasks don't suspend
+    auto result_0 = acquire(semaphore, executor, 1, log, 0);
+    auto result_1 = acquire(semaphore, executor, 1, log, 1);
+    assert_equal(log.size(), static_cast<size_t>(2));
+    assert_equal(executor->size(), static_cast<size_t>(0));
+
+    auto result_2 = acquire(semaphore, executor, 1, log, 2);
+    assert_equal(log.size(), static_cast<size_t>(2));
+
+    // a waiter is queued, newcomers can't cut in line
+    semaphore.release();
+    assert_equal(executor->size(), static_cast<size_t>(1));
+    assert_false(semaphore.try_acquire());
+
+    assert_true(executor->loop_once());
+    result_2.get();
+    assert_equal(log.size(), static_cast<size_t>(3));
+
+    semaphore.release(3);
+    assert_equal(semaphore.available_permits(), static_cast<size_t>(3));
+}
+
+void concurrencpp::tests::test_async_semaphore_fifo_order() {
+    async_semaphore semaphore(0);
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    std::vector<size_t> log;
+    std::vector<result<void>> results;
+    results.emplace_back(acquire(semaphore, executor, 1, log, 0));
+    results.emplace_back(acquire(semaphore, executor, 3, log, 1));
+    results.emplace_back(acquire(semaphore, executor, 1, log, 2));
+
+    // the second waiter needs more permits than there are, the third one waits behind it
+    semaphore.release(2);
+    assert_equal(executor->size(), static_cast<size_t>(1));
+    assert_equal(semaphore.available_permits(), static_cast<size_t>(1));
+
+    semaphore.release(3);
+    assert_equal(executor->size(), static_cast<size_t>(3));
+    assert_equal(semaphore.available_permits(), static_cast<size_t>(0));
+
+    assert_equal(executor->loop(3), static_cast<size_t>(3));
+    for (auto& result : results) {
+        result.get();
+    }
+
+    const std::vector<size_t> expected = {0, 1, 2};
+    assert_equal(log.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        assert_equal(log[i], expected[i]);
+    }
+}
+
+void concurrencpp::tests::test_async_semaphore_batched_release() {
+    constexpr size_t waiter_count = 64;
+
+    async_semaphore semaphore(0);
+    auto executor_0 = std::make_shared<enqueue_counting_executor>();
+    auto executor_1 = std::make_shared<enqueue_counting_executor>();
+
+    std::vector<size_t> log;
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < waiter_count; i++) {
+        std::shared_ptr<executor> executor = (i % 2 == 0) ? executor_0 : executor_1;
+        results.emplace_back(acquire(semaphore, executor, 1, log, i));
+    }
+
+    // a release that admits several waiters hands them to each executor with a single enqueue
+    semaphore.release(waiter_count / 2);
+    assert_equal(log.size(), waiter_count / 2);
+
+    semaphore.release(waiter_count);
+    assert_equal(log.size(), waiter_count);
+    assert_equal(semaphore.available_permits(), waiter_count / 2);
+
+    for (const auto& executor : {executor_0, executor_1}) {
+        assert_equal(executor->single_enqueues, static_cast<size_t>(0));
+        assert_equal(executor->batch_sizes.size(), static_cast<size_t>(2));
+        assert_equal(executor->batch_sizes[0], waiter_count / 4);
+        assert_equal(executor->batch_sizes[1], waiter_count / 4);
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+}
+
+void concurrencpp::tests::test_async_semaphore_resume_executor_shutdown() {
+    async_semaphore semaphore(0);
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    auto working_executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(working_executor);
+
+    std::vector<size_t> log;
+    auto result_0 = acquire(semaphore, executor, 1, log, 0);
+    auto result_1 = acquire(semaphore, working_executor, 1, log, 1);
+
+    // the first waiter is admitted, but can't be resumed. its permit goes to the next waiter.
+    executor->shutdown();
+    semaphore.release();
+
+    assert_throws<errors::broken_task>([&result_0] {
+        result_0.get();
+    });
+
+    assert_true(working_executor->loop_once());
+    result_1.get();
+
+    assert_equal(log.size(), static_cast<size_t>(1));
+    assert_equal(semaphore.available_permits(), static_cast<size_t>(0));
+}
+
+void concurrencpp::tests::test_async_semaphore_mini_load_test() {
+    constexpr size_t worker_count = 8;
+    constexpr size_t max_inside = 3;
+    constexpr size_t cycles = 5'000;
+
+    async_semaphore semaphore(max_inside);
+    std::atomic_size_t inside {0};
+    std::atomic_bool violation {false};
+    std::atomic_size_t counter {0};
+
+    const auto worker_coro = [&](executor_tag, std::shared_ptr<worker_thread_executor> ex, size_t id) -> result<void> {
+        for (size_t i = 0; i < cycles; i++) {
+            const auto count = (i + id) % 2 + 1;
+            co_await semaphore.acquire(ex, count);
+
+            if (inside.fetch_add(count) + count > max_inside) {
+                violation = true;
+            }
+
+            counter.fetch_add(1, std::memory_order_relaxed);
+            inside.fetch_sub(count);
+            semaphore.release(count);
+        }
+    };
+
+    std::vector<std::shared_ptr<worker_thread_executor>> workers(worker_count);
+    std::vector<result<void>> results(worker_count);
+
+    for (size_t i = 0; i < worker_count; i++) {
+        workers[i] = std::make_shared<worker_thread_executor>();
+        results[i] = worker_coro({}, workers[i], i);
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_false(violation.load());
+    assert_equal(counter.load(), worker_count * cycles);
+    assert_equal(semaphore.available_permits(), max_inside);
+
+    for (auto& worker : workers) {
+        worker->shutdown();
+    }
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("async_semaphore test");
+
+    tester.add_step("acquire - null resume executor", test_async_semaphore_acquire_null_resume_executor);
+    tester.add_step("try_acquire", test_async_semaphore_try_acquire);
+    tester.add_step("acquire", test_async_semaphore_acquire);
+    tester.add_step("fifo order", test_async_semaphore_fifo_order);
+    tester.add_step("batched release", test_async_semaphore_batched_release);
+    tester.add_step("resume executor shutdown", test_async_semaphore_resume_executor_shutdown);
+    tester.add_step("mini load test", test_async_semaphore_mini_load_test);
+
+    tester.launch_test();
+    return 0;
+}
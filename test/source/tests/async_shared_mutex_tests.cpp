@@ -0,0 +1,280 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/executor_shutdowner.h"
+
+#include "concurrencpp/threads/constants.h"
+
+namespace concurrencpp::tests {
+    void test_async_shared_mutex_lock_null_resume_executor();
+    void test_async_shared_mutex_try_lock();
+    void test_async_shared_mutex_unlock();
+    void test_async_shared_mutex_writer_preference();
+    void test_async_shared_mutex_readers_before_next_writer();
+    void test_async_shared_mutex_resume_executor_shutdown();
+    void test_async_shared_mutex_mini_load_test();
+
+    result<void> read(async_shared_mutex& mutex, std::shared_ptr<executor> ex, std::vector<std::string>& log, std::string name) {
+        auto guard = co_await mutex.lock_shared(ex);
+        log.emplace_back(std::move(name));
+    }
+
+    result<void> write(async_shared_mutex& mutex, std::shared_ptr<executor> ex, std::vector<std::string>& log, std::string name) {
+        auto guard = co_await mutex.lock(ex);
+        log.emplace_back(std::move(name));
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_async_shared_mutex_lock_null_resume_executor() {
+    async_shared_mutex mutex;
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&mutex] {
+            mutex.lock({});
+        },
+        concurrencpp::details::consts::k_async_shared_mutex_lock_null_resume_executor_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&mutex] {
+            mutex.lock_shared({});
+        },
+        concurrencpp::details::consts::k_async_shared_mutex_lock_shared_null_resume_executor_err_msg);
+}
+
+void concurrencpp::tests::test_async_shared_mutex_try_lock() {
+    async_shared_mutex mutex;
+
+    // readers share the mutex
+    assert_true(mutex.try_lock_shared());
+    assert_true(mutex.try_lock_shared());
+    assert_false(mutex.try_lock());
+
+    mutex.unlock_shared();
+    assert_false(mutex.try_lock());
+
+    mutex.unlock_shared();
+    assert_true(mutex.try_lock());
+
+    // a writer excludes everyone
+    assert_false(mutex.try_lock());
+    assert_false(mutex.try_lock_shared());
+
+    mutex.unlock();
+    assert_true(mutex.try_lock_shared());
+    mutex.unlock_shared();
+}
+
+void concurrencpp::tests::test_async_shared_mutex_unlock() {
+    assert_throws_contains_error_message<std::system_error>(
+        [] {
+            async_shared_mutex mutex;
+            mutex.unlock();
+        },
+        concurrencpp::details::consts::k_async_shared_mutex_unlock_invalid_lock_err_msg);
+
+    assert_throws_contains_error_message<std::system_error>(
+        [] {
+            scoped_async_shared_lock lock;
+            lock.unlock();
+        },
+        concurrencpp::details::consts::k_scoped_async_shared_lock_unlock_invalid_lock_err_msg);
+
+    assert_throws_contains_error_message<std::system_error>(
+        [] {
+            scoped_async_exclusive_lock lock;
+            lock.unlock();
+        },
+        concurrencpp::details::consts::k_scoped_async_exclusive_lock_unlock_invalid_lock_err_msg);
+
+    async_shared_mutex mutex;
+    auto executor = std::make_shared<concurrencpp::inline_executor>();
+
+    {
+        auto guard = mutex.lock(executor).run().get();
+        assert_true(guard.owns_lock());
+        assert_equal(guard.mutex(), &mutex);
+        assert_false(mutex.try_lock_shared());
+
+        guard.unlock();
+        assert_false(guard.owns_lock());
+        assert_true(mutex.try_lock_shared());
+        mutex.unlock_shared();
+    }
+
+    {
+        auto guard = mutex.lock_shared(executor).run().get();
+        assert_true(static_cast<bool>(guard));
+        assert_false(mutex.try_lock());
+
+        auto moved = std::move(guard);
+        assert_false(guard.owns_lock());
+        assert_true(moved.owns_lock());
+    }
+
+    assert_true(mutex.try_lock());
+    mutex.unlock();
+}
+
+void concurrencpp::tests::test_async_shared_mutex_writer_preference() {
+    async_shared_mutex mutex;
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    std::vector<std::string> log;
+
+    assert_true(mutex.try_lock_shared());
+    auto writer = write(mutex, executor, log, "writer");
+
+    // a writer is waiting: new readers wait behind it, although only readers own the mutex
+    auto reader = read(mutex, executor, log, "reader");
+    assert_false(mutex.try_lock_shared());
+    assert_equal(executor->size(), static_cast<size_t>(0));
+
+    // the last reader hands the mutex to the writer
+    mutex.unlock_shared();
+    assert_equal(executor->size(), static_cast<size_t>(1));
+    assert_true(executor->loop_once());
+    writer.get();
+
+    // the writer released the mutex and let the reader in
+    assert_true(executor->loop_once());
+    reader.get();
+
+    assert_equal(log.size(), static_cast<size_t>(2));
+    assert_equal(log[0], std::string("writer"));
+    assert_equal(log[1], std::string("reader"));
+
+    assert_true(mutex.try_lock());
+    mutex.unlock();
+}
+
+void concurrencpp::tests::test_async_shared_mutex_readers_before_next_writer() {
+    async_shared_mutex mutex;
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    std::vector<std::string> log;
+    std::vector<result<void>> results;
+
+    assert_true(mutex.try_lock());
+    results.emplace_back(write(mutex, executor, log, "writer 1"));
+    results.emplace_back(read(mutex, executor, log, "reader 0"));
+    results.emplace_back(read(mutex, executor, log, "reader 1"));
+    results.emplace_back(write(mutex, executor, log, "writer 2"));
+
+    // all the waiting readers are let in together, before the next writer
+    mutex.unlock();
+    assert_equal(executor->size(), static_cast<size_t>(2));
+    assert_equal(executor->loop(2), static_cast<size_t>(2));
+
+    assert_true(executor->loop_once());  // writer 1
+    assert_true(executor->loop_once());  // writer 2
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    const std::vector<std::string> expected = {"reader 0", "reader 1", "writer 1", "writer 2"};
+    assert_equal(log.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        assert_equal(log[i], expected[i]);
+    }
+}
+
+void concurrencpp::tests::test_async_shared_mutex_resume_executor_shutdown() {
+    async_shared_mutex mutex;
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    auto working_executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(working_executor);
+
+    std::vector<std::string> log;
+
+    assert_true(mutex.try_lock());
+    auto reader = read(mutex, executor, log, "reader");
+    auto writer = write(mutex, working_executor, log, "writer");
+
+    // the reader is let in, but can't be resumed. it must not keep the mutex locked.
+    executor->shutdown();
+    mutex.unlock();
+
+    assert_throws<errors::broken_task>([&reader] {
+        reader.get();
+    });
+
+    assert_true(working_executor->loop_once());
+    writer.get();
+
+    assert_equal(log.size(), static_cast<size_t>(1));
+    assert_true(mutex.try_lock_shared());
+    mutex.unlock_shared();
+}
+
+void concurrencpp::tests::test_async_shared_mutex_mini_load_test() {
+    constexpr size_t worker_count = 4;
+    constexpr size_t cycles = 10'000;
+
+    async_shared_mutex mutex;
+    std::atomic_intptr_t readers_inside {0};
+    std::atomic_bool writer_inside {false};
+    std::atomic_bool violation {false};
+    size_t writes = 0;
+
+    const auto worker_coro = [&](executor_tag, std::shared_ptr<worker_thread_executor> ex, size_t id) -> result<void> {
+        for (size_t i = 0; i < cycles; i++) {
+            if ((i + id) % 10 == 0) {
+                auto guard = co_await mutex.lock(ex);
+                if (writer_inside.exchange(true) || readers_inside.load() != 0) {
+                    violation = true;
+                }
+
+                ++writes;
+                writer_inside = false;
+            } else {
+                auto guard = co_await mutex.lock_shared(ex);
+                readers_inside.fetch_add(1);
+                if (writer_inside.load()) {
+                    violation = true;
+                }
+
+                readers_inside.fetch_sub(1);
+            }
+        }
+    };
+
+    std::vector<std::shared_ptr<worker_thread_executor>> workers(worker_count);
+    std::vector<result<void>> results(worker_count);
+
+    for (size_t i = 0; i < worker_count; i++) {
+        workers[i] = std::make_shared<worker_thread_executor>();
+        results[i] = worker_coro({}, workers[i], i);
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_false(violation.load());
+    assert_equal(writes, worker_count * cycles / 10);
+
+    for (auto& worker : workers) {
+        worker->shutdown();
+    }
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("async_shared_mutex test");
+
+    tester.add_step("lock - null resume executor", test_async_shared_mutex_lock_null_resume_executor);
+    tester.add_step("try_lock", test_async_shared_mutex_try_lock);
+    tester.add_step("unlock", test_async_shared_mutex_unlock);
+    tester.add_step("writer preference", test_async_shared_mutex_writer_preference);
+    tester.add_step("readers before next writer", test_async_shared_mutex_readers_before_next_writer);
+    tester.add_step("resume executor shutdown", test_async_shared_mutex_resume_executor_shutdown);
+    tester.add_step("mini load test", test_async_shared_mutex_mini_load_test);
+
+    tester.launch_test();
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+
+#include "concurrencpp/threads/atomic_wait.h"
+
+#include <thread>
+#include <vector>
+
+namespace concurrencpp::tests {
+    void test_atomic_wait_until_changed_value();
+    void test_atomic_wait_until_timeout();
+    void test_atomic_wait_until_notify_one();
+    void test_atomic_wait_until_notify_all();
+    void test_atomic_wait_until_timeout_then_notify();
+    void test_atomic_wait_notify();
+}  // namespace concurrencpp::tests
+
+using namespace std::chrono;
+using concurrencpp::details::atomic_wait_until;
+
+void concurrencpp::tests::test_atomic_wait_until_changed_value() {
+    std::atomic_int32_t atomic {1};
+
+    // the value is not the expected one, don't block even if the deadline is far away
+    const auto before = steady_clock::now();
+    assert_true(atomic_wait_until(atomic, 0, before + seconds(10)));
+    const auto after = steady_clock::now();
+
+    assert_smaller(after - before, milliseconds(100));
+}
+
+void concurrencpp::tests::test_atomic_wait_until_timeout() {
+    std::atomic_int32_t atomic {0};
+
+    // a deadline in the past returns immediately
+    assert_false(atomic_wait_until(atomic, 0, steady_clock::now() - seconds(1)));
+
+    const auto waiting_time = milliseconds(50);
+    const auto before = steady_clock::now();
+    const auto deadline = before + waiting_time;
+
+    // spurious wakeups are allowed, but the deadline can't be cut short
+    while (atomic_wait_until(atomic, 0, deadline)) {
+        assert_equal(atomic.load(), 0);
+    }
+
+    assert_bigger_equal(steady_clock::now(), deadline);
+}
+
+void concurrencpp::tests::test_atomic_wait_until_notify_one() {
+    std::atomic_int32_t atomic {0};
+    const auto unblocking_time = steady_clock::now() + milliseconds(150);
+
+    std::thread thread([&atomic, unblocking_time] {
+        std::this_thread::sleep_until(unblocking_time);
+        atomic.store(1);
+        concurrencpp::details::atomic_notify_one(&atomic);  // qualified, unqualified adl picks std::atomic_notify_one
+    });
+
+    const auto deadline = steady_clock::now() + seconds(10);
+    while (atomic.load() == 0) {
+        assert_true(atomic_wait_until(atomic, 0, deadline));
+    }
+
+    // woken up by the notification, not by polling or by the deadline
+    const auto now = steady_clock::now();
+    assert_bigger_equal(now, unblocking_time);
+    assert_smaller(now, unblocking_time + milliseconds(500));
+
+    thread.join();
+}
+
+void concurrencpp::tests::test_atomic_wait_until_notify_all() {
+    constexpr size_t waiter_count = 8;
+
+    std::atomic_int32_t atomic {0};
+    std::atomic_size_t woken {0};
+    std::vector<std::thread> waiters;
+    waiters.reserve(waiter_count);
+
+    const auto deadline = steady_clock::now() + seconds(10);
+    for (size_t i = 0; i < waiter_count; i++) {
+        waiters.emplace_back([&atomic, &woken, deadline] {
+            while (atomic.load() == 0) {
+                if (!atomic_wait_until(atomic, 0, deadline)) {
+                    return;
+                }
+            }
+
+            woken.fetch_add(1);
+        });
+    }
+
+    std::this_thread::sleep_for(milliseconds(50));
+    atomic.store(1);
+    concurrencpp::details::atomic_notify_all(&atomic);
+
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+
+    assert_equal(woken.load(), waiter_count);
+    assert_smaller(steady_clock::now(), deadline);
+}
+
+void concurrencpp::tests::test_atomic_wait_until_timeout_then_notify() {
+    std::atomic_int32_t atomic {0};
+
+    // a waiter that timed out doesn't leave anything behind, a later wait on the same address is woken normally
+    assert_false(atomic_wait_until(atomic, 0, steady_clock::now() + milliseconds(20)));
+
+    const auto unblocking_time = steady_clock::now() + milliseconds(100);
+    std::thread thread([&atomic, unblocking_time] {
+        std::this_thread::sleep_until(unblocking_time);
+        atomic.store(1);
+        concurrencpp::details::atomic_notify_one(&atomic);
+    });
+
+    const auto deadline = steady_clock::now() + seconds(10);
+    while (atomic.load() == 0) {
+        assert_true(atomic_wait_until(atomic, 0, deadline));
+    }
+
+    assert_smaller(steady_clock::now(), unblocking_time + milliseconds(500));
+    thread.join();
+}
+
+void concurrencpp::tests::test_atomic_wait_notify() {
+    std::atomic_int32_t atomic {1};
+
+    // the value is not the expected one, don't block
+    concurrencpp::details::atomic_wait(atomic, 0);
+
+    atomic.store(0);
+    const auto unblocking_time = steady_clock::now() + milliseconds(100);
+    std::thread thread([&atomic, unblocking_time] {
+        std::this_thread::sleep_until(unblocking_time);
+        atomic.store(1);
+        concurrencpp::details::atomic_notify_one(&atomic);
+    });
+
+    concurrencpp::details::atomic_wait(atomic, 0);
+
+    assert_equal(atomic.load(), 1);
+    assert_bigger_equal(steady_clock::now(), unblocking_time);
+    thread.join();
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("atomic_wait test");
+
+    tester.add_step("changed value", test_atomic_wait_until_changed_value);
+    tester.add_step("timeout", test_atomic_wait_until_timeout);
+    tester.add_step("notify_one", test_atomic_wait_until_notify_one);
+    tester.add_step("notify_all", test_atomic_wait_until_notify_all);
+    tester.add_step("timeout then notify", test_atomic_wait_until_timeout_then_notify);
+    tester.add_step("untimed wait", test_atomic_wait_notify);
+
+    tester.launch_test();
+    return 0;
+}
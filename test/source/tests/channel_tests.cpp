@@ -0,0 +1,412 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/executor_shutdowner.h"
+#include "utils/enqueue_counting_executor.h"
+
+#include "concurrencpp/threads/constants.h"
+
+namespace concurrencpp::tests {
+    void test_channel_constructor();
+    void test_channel_try_push_try_pop();
+    void test_channel_push_pop();
+    void test_channel_pop_many();
+    void test_channel_batched_wakeup();
+    void test_channel_close();
+    void test_channel_push_after_close_race();
+    void test_channel_resume_executor_shutdown();
+    void test_channel_interrupted_producer();
+    void test_channel_mini_load_test();
+
+    result<void> consume(channel<int>& channel, std::shared_ptr<executor> ex, std::vector<int>& log) {
+        while (true) {
+            auto value = co_await channel.pop(ex);
+            if (!value.has_value()) {
+                co_return;
+            }
+
+            log.emplace_back(*value);
+        }
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_channel_constructor() {
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            channel<int> channel(0);
+        },
+        concurrencpp::details::consts::k_channel_invalid_capacity_err_msg);
+
+    channel<int> channel(7);
+    assert_equal(channel.capacity(), static_cast<size_t>(7));
+    assert_false(channel.closed());
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&channel] {
+            channel.push({}, 1);
+        },
+        concurrencpp::details::consts::k_channel_push_null_resume_executor_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&channel] {
+            channel.pop({});
+        },
+        concurrencpp::details::consts::k_channel_pop_null_resume_executor_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&channel] {
+            channel.pop_many({}, 1);
+        },
+        concurrencpp::details::consts::k_channel_pop_many_null_resume_executor_err_msg);
+
+    auto executor = std::make_shared<concurrencpp::inline_executor>();
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&channel, executor] {
+            channel.pop_many(executor, 0);
+        },
+        concurrencpp::details::consts::k_channel_pop_many_invalid_max_count_err_msg);
+}
+
+void concurrencpp::tests::test_channel_try_push_try_pop() {
+    channel<std::string> channel(3);
+
+    // the ring wraps around several times
+    for (size_t lap = 0; lap < 5; lap++) {
+        assert_true(channel.try_push(std::string("a")));
+        assert_true(channel.try_push(std::string("b")));
+
+        const std::string c = "c";
+        assert_true(channel.try_push(c));
+
+        // a failed push doesn't move from its value
+        std::string d = "d";
+        assert_false(channel.try_push(std::move(d)));
+        assert_equal(d, std::string("d"));
+
+        assert_equal(*channel.try_pop(), std::string("a"));
+        assert_equal(*channel.try_pop(), std::string("b"));
+        assert_equal(*channel.try_pop(), std::string("c"));
+        assert_false(channel.try_pop().has_value());
+    }
+
+    std::vector<std::string> values;
+    assert_equal(channel.try_pop_many(values, 10), static_cast<size_t>(0));
+
+    channel.try_push(std::string("x"));
+    channel.try_push(std::string("y"));
+    assert_equal(channel.try_pop_many(values, 10), static_cast<size_t>(2));
+    assert_equal(values.size(), static_cast<size_t>(2));
+    assert_equal(values[1], std::string("y"));
+}
+
+void concurrencpp::tests::test_channel_push_pop() {
+    channel<int> channel(2);
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    std::vector<int> log;
+    auto consumer = consume(channel, executor, log);
+    assert_equal(executor->size(), static_cast<size_t>(0));
+
+    // a waiting consumer gets the pushed value directly, and is resumed inside its executor
+    assert_true(channel.try_push(1));
+    assert_equal(executor->size(), static_cast<size_t>(1));
+    assert_true(executor->loop_once());
+    assert_equal(log.size(), static_cast<size_t>(1));
+    assert_equal(log[0], 1);
+
+    // producers wait for room
+    const auto producer = [&](int first) -> result<void> {
+        for (int i = first; i < first + 4; i++) {
+            const auto pushed = co_await channel.push(executor, i);
+            assert_true(pushed);
+        }
+    };
+
+    auto producer_result = producer(2);
+    executor->loop(100);
+
+    producer_result.get();
+    channel.close();
+    executor->loop(100);
+    consumer.get();
+
+    const std::vector<int> expected = {1, 2, 3, 4, 5};
+    assert_equal(log.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        assert_equal(log[i], expected[i]);
+    }
+}
+
+void concurrencpp::tests::test_channel_pop_many() {
+    channel<int> channel(16);
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    auto result = channel.pop_many(executor, 4).run();
+    assert_equal(result.status(), result_status::idle);
+
+    for (int i = 0; i < 6; i++) {
+        assert_true(channel.try_push(i));
+    }
+
+    // the consumer waits for one value, then drains what it can without waiting
+    executor->loop(100);
+    const auto values = result.get();
+    assert_equal(values.size(), static_cast<size_t>(4));
+    for (int i = 0; i < 4; i++) {
+        assert_equal(values[i], i);
+    }
+
+    auto rest = channel.pop_many(executor, 4).run().get();
+    assert_equal(rest.size(), static_cast<size_t>(2));
+
+    channel.close();
+    assert_true(channel.pop_many(executor, 4).run().get().empty());
+}
+
+void concurrencpp::tests::test_channel_batched_wakeup() {
+    constexpr size_t consumer_count = 32;
+
+    channel<int> channel(consumer_count);
+    auto executor = std::make_shared<enqueue_counting_executor>();
+
+    std::vector<int> log;
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < consumer_count; i++) {
+        results.emplace_back(consume(channel, executor, log));
+    }
+
+    // closing the channel hands all the waiting consumers to their executor in one batch
+    channel.close();
+    assert_equal(executor->single_enqueues, static_cast<size_t>(0));
+    assert_equal(executor->batch_sizes.size(), static_cast<size_t>(1));
+    assert_equal(executor->batch_sizes[0], consumer_count);
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_true(log.empty());
+}
+
+void concurrencpp::tests::test_channel_close() {
+    channel<int> channel(2);
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    assert_true(channel.try_push(1));
+    assert_true(channel.try_push(2));
+
+    const auto producer = [&]() -> result<bool> {
+        co_return co_await channel.push(executor, 3);
+    };
+
+    auto blocked_producer = producer();
+    assert_equal(blocked_producer.status(), result_status::idle);
+
+    // a waiting producer is resumed with false, values in the channel are still delivered
+    channel.close();
+    assert_true(channel.closed());
+    executor->loop(100);
+    assert_false(blocked_producer.get());
+
+    assert_false(channel.try_push(4));
+    assert_false(producer().get());
+
+    std::vector<int> log;
+    auto consumer = consume(channel, executor, log);
+    consumer.get();
+
+    assert_equal(log.size(), static_cast<size_t>(2));
+    assert_equal(log[0], 1);
+    assert_equal(log[1], 2);
+}
+
+void concurrencpp::tests::test_channel_push_after_close_race() {
+    channel<int> channel(1);
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    assert_true(channel.try_push(1));
+
+    // the push finds the channel full and open, then the channel is drained and closed before the push suspends
+    auto awaiter = channel.push(executor, 2);
+    assert_false(awaiter.await_ready());
+
+    assert_equal(channel.try_pop(), std::optional<int>(1));
+    channel.close();
+
+    // there's room now, but a closed channel takes no more values
+    assert_false(awaiter.await_suspend(concurrencpp::details::noop_coroutine()));
+    assert_false(awaiter.await_resume());
+    assert_false(channel.try_pop().has_value());
+}
+
+void concurrencpp::tests::test_channel_resume_executor_shutdown() {
+    channel<int> channel(4);
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    auto working_executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(working_executor);
+
+    std::vector<int> log;
+    auto consumer_0 = consume(channel, executor, log);
+    auto consumer_1 = consume(channel, working_executor, log);
+
+    // the first consumer is handed the value but can't be resumed, the value goes to the second one
+    executor->shutdown();
+    assert_true(channel.try_push(42));
+
+    assert_throws<errors::broken_task>([&consumer_0] {
+        consumer_0.get();
+    });
+
+    assert_true(working_executor->loop_once());
+    assert_equal(log.size(), static_cast<size_t>(1));
+    assert_equal(log[0], 42);
+
+    channel.close();
+    working_executor->loop(100);
+    consumer_1.get();
+
+    // the channel is full by the time the value is given back, it is still served first
+    concurrencpp::channel<int> full_channel(1);
+    auto executor_1 = std::make_shared<concurrencpp::manual_executor>();
+
+    std::vector<int> log_1;
+    auto consumer_2 = consume(full_channel, executor_1, log_1);
+
+    assert_true(full_channel.try_push(1));
+    assert_true(full_channel.try_push(2));
+    assert_false(full_channel.try_push(3));
+
+    executor_1->shutdown();
+    assert_throws<errors::broken_task>([&consumer_2] {
+        consumer_2.get();
+    });
+
+    std::vector<int> values;
+    assert_equal(full_channel.try_pop_many(values, 4), static_cast<size_t>(2));
+    assert_equal(values[0], 1);
+    assert_equal(values[1], 2);
+}
+
+void concurrencpp::tests::test_channel_interrupted_producer() {
+    channel<int> channel(1);
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+
+    const auto producer = [&](int value) -> result<bool> {
+        co_return co_await channel.push(executor, value);
+    };
+
+    assert_true(channel.try_push(1));
+    auto blocked_producer = producer(2);
+    assert_equal(blocked_producer.status(), result_status::idle);
+
+    // popping makes room: the waiting producer's value is pushed for it, but its executor rejects the resumption.
+    // the value was delivered, so the producer reports it instead of throwing broken_task.
+    executor->shutdown();
+    assert_equal(channel.try_pop(), std::optional<int>(1));
+    assert_equal(blocked_producer.status(), result_status::value);
+    assert_true(blocked_producer.get());
+    assert_equal(channel.try_pop(), std::optional<int>(2));
+
+    // a producer that can't be resumed and whose value was not pushed still gets broken_task
+    assert_true(channel.try_push(3));
+    auto executor_1 = std::make_shared<concurrencpp::manual_executor>();
+    auto rejected_producer = [&]() -> result<bool> {
+        co_return co_await channel.push(executor_1, 4);
+    }();
+
+    executor_1->shutdown();
+    channel.close();
+
+    assert_throws<errors::broken_task>([&rejected_producer] {
+        rejected_producer.get();
+    });
+
+    assert_equal(channel.try_pop(), std::optional<int>(3));
+    assert_false(channel.try_pop().has_value());
+}
+
+void concurrencpp::tests::test_channel_mini_load_test() {
+    constexpr size_t producer_count = 4;
+    constexpr size_t consumer_count = 4;
+    constexpr size_t values_per_producer = 50'000;
+
+    channel<size_t> channel(64);
+    auto producers = std::make_shared<concurrencpp::thread_pool_executor>("producers", 2, std::chrono::seconds(10));
+    auto consumers = std::make_shared<concurrencpp::thread_pool_executor>("consumers", 2, std::chrono::seconds(10));
+    executor_shutdowner es0(producers), es1(consumers);
+
+    const auto producer = [&](executor_tag, std::shared_ptr<thread_pool_executor>, size_t id) -> result<void> {
+        for (size_t i = 0; i < values_per_producer; i++) {
+            const auto pushed = co_await channel.push(producers, id * values_per_producer + i + 1);
+            assert_true(pushed);
+        }
+    };
+
+    const auto consumer = [&](executor_tag, std::shared_ptr<thread_pool_executor>) -> result<std::pair<size_t, size_t>> {
+        size_t count = 0, sum = 0;
+        while (true) {
+            auto values = co_await channel.pop_many(consumers, 32);
+            if (values.empty()) {
+                co_return std::make_pair(count, sum);
+            }
+
+            for (const auto value : values) {
+                sum += value;
+            }
+
+            count += values.size();
+        }
+    };
+
+    std::vector<result<void>> producer_results;
+    for (size_t i = 0; i < producer_count; i++) {
+        producer_results.emplace_back(producer({}, producers, i));
+    }
+
+    std::vector<result<std::pair<size_t, size_t>>> consumer_results;
+    for (size_t i = 0; i < consumer_count; i++) {
+        consumer_results.emplace_back(consumer({}, consumers));
+    }
+
+    for (auto& result : producer_results) {
+        result.get();
+    }
+
+    channel.close();
+
+    size_t count = 0, sum = 0;
+    for (auto& result : consumer_results) {
+        const auto [consumer_count_, consumer_sum] = result.get();
+        count += consumer_count_;
+        sum += consumer_sum;
+    }
+
+    constexpr size_t total = producer_count * values_per_producer;
+    assert_equal(count, total);
+    assert_equal(sum, total * (total + 1) / 2);
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("channel test");
+
+    tester.add_step("constructor", test_channel_constructor);
+    tester.add_step("try_push + try_pop", test_channel_try_push_try_pop);
+    tester.add_step("push + pop", test_channel_push_pop);
+    tester.add_step("pop_many", test_channel_pop_many);
+    tester.add_step("batched wakeup", test_channel_batched_wakeup);
+    tester.add_step("close", test_channel_close);
+    tester.add_step("push after close race", test_channel_push_after_close_race);
+    tester.add_step("resume executor shutdown", test_channel_resume_executor_shutdown);
+    tester.add_step("interrupted producer", test_channel_interrupted_producer);
+    tester.add_step("mini load test", test_channel_mini_load_test);
+
+    tester.launch_test();
+    return 0;
+}
@@ -54,6 +54,8 @@ namespace concurrencpp::tests {
     void test_manual_executor_wait_for_tasks_for();
     void test_manual_executor_wait_for_tasks_until();
 
+    void test_manual_executor_virtual_time();
+
     void assert_executed_locally(const std::unordered_map<size_t, size_t>& execution_map) {
         assert_equal(execution_map.size(), static_cast<size_t>(1));  // only one thread executed the tasks
         assert_equal(execution_map.begin()->first, concurrencpp::details::thread::get_current_virtual_id());  // and it's this thread.
@@ -1525,6 +1527,141 @@ void concurrencpp::tests::test_manual_executor_wait_for_tasks_until() {
     }
 }
 
+void concurrencpp::tests::test_manual_executor_virtual_time() {
+    const auto start_time = concurrencpp::timer_queue::time_point {} + hours(1);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            concurrencpp::manual_executor executor(std::shared_ptr<concurrencpp::timer_queue> {});
+        },
+        concurrencpp::details::consts::k_manual_executor_null_timer_queue_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            concurrencpp::manual_executor executor(std::make_shared<concurrencpp::timer_queue>(seconds(120)));
+        },
+        concurrencpp::details::consts::k_manual_executor_real_time_timer_queue_err_msg);
+
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {}, start_time);
+    auto executor = std::make_shared<concurrencpp::manual_executor>(timer_queue);
+    executor_shutdowner shutdown(executor);
+
+    // loop and loop_once don't let time pass
+    {
+        size_t fired = 0;
+        auto timer = timer_queue->make_timer(seconds(1), seconds(1), executor, [&fired] {
+            ++fired;
+        });
+
+        assert_equal(executor->loop(100), static_cast<size_t>(0));
+        assert_false(executor->loop_once());
+        assert_equal(timer_queue->now(), start_time);
+
+        // time passes only when the executor is idle, and stops at the deadline without blocking
+        const auto before = high_resolution_clock::now();
+        assert_equal(executor->loop_for(10'000, hours(1)), static_cast<size_t>(3600));
+        const auto after = high_resolution_clock::now();
+
+        assert_equal(fired, static_cast<size_t>(3600));
+        assert_equal(timer_queue->now(), start_time + hours(1));
+        assert_smaller(after - before, seconds(30));
+
+        // max_count is respected
+        assert_equal(executor->loop_for(10, hours(1)), static_cast<size_t>(10));
+        assert_equal(timer_queue->now(), start_time + hours(1) + seconds(10));
+    }
+
+    // loop_until takes virtual time points with virtual_time_tag, coroutines sleep in virtual time
+    {
+        const auto sleeper = [](std::shared_ptr<concurrencpp::timer_queue> timer_queue,
+                                std::shared_ptr<concurrencpp::manual_executor> executor) -> result<size_t> {
+            size_t iterations = 0;
+            for (size_t i = 0; i < 100; i++) {
+                co_await timer_queue->sleep_for(minutes(1), executor);
+                ++iterations;
+            }
+
+            co_return iterations;
+        };
+
+        auto result = sleeper(timer_queue, executor);
+        const auto deadline = timer_queue->now() + minutes(50) + seconds(30);
+
+        assert_equal(executor->loop_until(1'000, concurrencpp::virtual_time_tag {}, deadline), static_cast<size_t>(50));
+        assert_equal(timer_queue->now(), deadline);
+        assert_equal(result.status(), result_status::idle);
+
+        assert_true(executor->loop_once_for(minutes(1)));
+        assert_equal(executor->loop_for(1'000, hours(1)), static_cast<size_t>(49));
+        assert_equal(result.get(), static_cast<size_t>(100));
+    }
+
+    // an idle executor returns from an unbounded loop_until once no timer is pending
+    {
+        using time_point = concurrencpp::timer_queue::time_point;
+
+        auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {}, start_time);
+        auto executor = std::make_shared<concurrencpp::manual_executor>(timer_queue);
+        executor_shutdowner shutdown(executor);
+
+        size_t fired = 0;
+        auto oneshot = timer_queue->make_one_shot_timer(minutes(1), executor, [&fired] {
+            ++fired;
+        });
+
+        assert_equal(executor->loop_until(100, time_point::max()), static_cast<size_t>(1));
+        assert_equal(fired, static_cast<size_t>(1));
+        assert_false(executor->loop_once_until(time_point::max()));
+        assert_equal(timer_queue->now(), start_time + minutes(1));
+
+        // the clock wasn't moved to the end of time, timers made afterwards are due when they should be
+        time_point fired_at;
+        auto late = timer_queue->make_one_shot_timer(minutes(1), executor, [&fired_at, timer_queue] {
+            fired_at = timer_queue->now();
+        });
+
+        assert_equal(executor->loop_until(100, time_point::max()), static_cast<size_t>(1));
+        assert_equal(fired_at, start_time + minutes(2));
+        assert_equal(timer_queue->now(), start_time + minutes(2));
+    }
+
+    // real time points are relative to their clock, whatever clock high_resolution_clock happens to be
+    {
+        auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {}, start_time);
+        auto executor = std::make_shared<concurrencpp::manual_executor>(timer_queue);
+        executor_shutdowner shutdown(executor);
+
+        assert_equal(executor->loop_until(100, system_clock::now() + seconds(1)), static_cast<size_t>(0));
+        assert_bigger(timer_queue->now(), start_time);
+        assert_smaller_equal(timer_queue->now(), start_time + seconds(1));
+
+        const auto before = timer_queue->now();
+        assert_false(executor->loop_once_until(high_resolution_clock::now() + seconds(1)));
+        assert_bigger(timer_queue->now(), before);
+        assert_smaller_equal(timer_queue->now(), before + seconds(1));
+
+        // a time point that already passed doesn't move the clock
+        const auto now = timer_queue->now();
+        assert_equal(executor->loop_until(100, steady_clock::now() - seconds(1)), static_cast<size_t>(0));
+        assert_equal(timer_queue->now(), now);
+
+        assert_false(executor->loop_once_until(concurrencpp::virtual_time_tag {}, now + hours(1)));
+        assert_equal(timer_queue->now(), now + hours(1));
+    }
+
+    // virtual time points can't be given to a real time executor
+    {
+        auto executor = std::make_shared<concurrencpp::manual_executor>();
+        executor_shutdowner shutdown(executor);
+
+        assert_throws_with_error_message<std::logic_error>(
+            [executor] {
+                executor->loop_until(1, concurrencpp::virtual_time_tag {}, high_resolution_clock::now());
+            },
+            concurrencpp::details::consts::k_manual_executor_not_virtual_err_msg);
+    }
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -1550,6 +1687,7 @@ int main() {
     tester.add_step("wait_for_tasks_for", test_manual_executor_wait_for_tasks_for);
     tester.add_step("wait_for_tasks_until", test_manual_executor_wait_for_tasks_until);
     tester.add_step("clear", test_manual_executor_clear);
+    tester.add_step("virtual time", test_manual_executor_virtual_time);
 
     tester.launch_test();
     return 0;
@@ -0,0 +1,242 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/object_observer.h"
+#include "utils/custom_exception.h"
+#include "utils/executor_shutdowner.h"
+
+using namespace concurrencpp::tests;
+
+namespace concurrencpp::tests {
+    void test_async_generator_move_constructor();
+    void test_async_generator_destructor();
+    void test_async_generator_next_empty();
+    void test_async_generator_next_exception();
+    void test_async_generator_next_values();
+    void test_async_generator_next_reference();
+    void test_async_generator_awaiting_body();
+    void test_async_generator_paginated_scan();
+}  // namespace concurrencpp::tests
+
+using concurrencpp::result;
+using concurrencpp::async_generator;
+
+namespace concurrencpp::tests {
+    template<class type>
+    result<std::vector<type>> drain(async_generator<type>& gen) {
+        std::vector<type> values;
+        while (auto value = co_await gen.next()) {
+            values.emplace_back(*value);
+        }
+
+        co_return values;
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_async_generator_move_constructor() {
+    auto gen0 = []() -> async_generator<int> {
+        co_yield 1;
+    }();
+
+    assert_true(static_cast<bool>(gen0));
+
+    async_generator<int> gen1(std::move(gen0));
+    assert_false(static_cast<bool>(gen0));
+    assert_true(static_cast<bool>(gen1));
+}
+
+void concurrencpp::tests::test_async_generator_destructor() {
+    auto gen_fn = [](testing_stub stub) -> async_generator<int> {
+        co_yield 1;
+    };
+
+    object_observer observer;
+
+    {
+        auto gen0 = gen_fn(observer.get_testing_stub());
+        auto gen1(std::move(gen0));  // check to see that empty generator d.tor is benign
+    }
+
+    assert_equal(observer.get_destruction_count(), 1);
+
+    // destroying a generator that is suspended on a co_yield
+    {
+        auto gen = gen_fn(observer.get_testing_stub());
+        auto consumer = [](async_generator<int>& gen) -> result<int> {
+            co_return *(co_await gen.next());
+        };
+
+        assert_equal(consumer(gen).get(), 1);
+    }
+
+    assert_equal(observer.get_destruction_count(), 2);
+}
+
+void concurrencpp::tests::test_async_generator_next_empty() {
+    auto gen0 = []() -> async_generator<int> {
+        co_yield 1;
+    }();
+
+    auto gen1(std::move(gen0));
+    assert_throws_with_error_message<errors::empty_generator>(
+        [&gen0] {
+            gen0.next();
+        },
+        concurrencpp::details::consts::k_empty_async_generator_next_err_msg);
+}
+
+void concurrencpp::tests::test_async_generator_next_exception() {
+    auto gen = []() -> async_generator<int> {
+        co_yield 1;
+        throw custom_exception(1234567);
+    }();
+
+    auto consumer = [](async_generator<int>& gen) -> result<void> {
+        auto value = co_await gen.next();
+        assert_equal(*value, 1);
+
+        try {
+            co_await gen.next();
+            assert_false(true);
+        } catch (const custom_exception& e) {
+            assert_equal(e.id, static_cast<intptr_t>(1234567));
+        }
+
+        // the exception is thrown once, the generator is finished afterwards
+        assert_equal(co_await gen.next(), static_cast<int*>(nullptr));
+    };
+
+    consumer(gen).get();
+}
+
+void concurrencpp::tests::test_async_generator_next_values() {
+    auto gen = []() -> async_generator<std::string> {
+        for (int i = 0; i < 16; i++) {
+            co_yield std::to_string(i);
+        }
+    }();
+
+    const auto values = drain(gen).get();
+    assert_equal(values.size(), static_cast<size_t>(16));
+
+    for (int i = 0; i < 16; i++) {
+        assert_equal(values[i], std::to_string(i));
+    }
+
+    // a finished generator keeps reporting the end of the sequence
+    auto consumer = [](async_generator<std::string>& gen) -> result<std::string*> {
+        co_return co_await gen.next();
+    };
+
+    assert_equal(consumer(gen).get(), static_cast<std::string*>(nullptr));
+
+    auto empty_gen = []() -> async_generator<int> {
+        co_return;
+    }();
+
+    assert_true(drain(empty_gen).get().empty());
+}
+
+void concurrencpp::tests::test_async_generator_next_reference() {
+    std::vector<int> values {1, 2, 3};
+
+    auto gen = [](std::vector<int>& values) -> async_generator<int&> {
+        for (auto& value : values) {
+            co_yield value;
+        }
+    }(values);
+
+    auto consumer = [](async_generator<int&>& gen) -> result<void> {
+        while (auto value = co_await gen.next()) {
+            *value *= 10;
+        }
+    };
+
+    consumer(gen).get();
+    assert_equal(values, std::vector<int> {10, 20, 30});
+}
+
+void concurrencpp::tests::test_async_generator_awaiting_body() {
+    result_promise<int> promise;
+
+    auto gen = [](result<int> input) -> async_generator<int> {
+        co_yield 1;
+        co_yield co_await input;
+        co_yield 3;
+    }(promise.get_result());
+
+    std::thread::id consumer_thread_id;
+    auto consumer = [](async_generator<int>& gen, std::thread::id& consumer_thread_id) -> result<std::vector<int>> {
+        std::vector<int> values;
+        while (auto value = co_await gen.next()) {
+            values.emplace_back(*value);
+            consumer_thread_id = std::this_thread::get_id();
+        }
+
+        co_return values;
+    }(gen, consumer_thread_id);
+
+    // the consumer is suspended while the generator awaits its input
+    assert_equal(consumer.status(), result_status::idle);
+    assert_equal(consumer_thread_id, std::this_thread::get_id());
+
+    std::thread setter([promise = std::move(promise)]() mutable {
+        promise.set_result(2);
+    });
+
+    // the generator and then the consumer are resumed inside the thread that set the input
+    const auto setter_thread_id = setter.get_id();
+    setter.join();
+
+    assert_equal(consumer.get(), std::vector<int> {1, 2, 3});
+    assert_equal(consumer_thread_id, setter_thread_id);
+}
+
+void concurrencpp::tests::test_async_generator_paginated_scan() {
+    constexpr size_t page_count = 64;
+    constexpr size_t page_size = 32;
+
+    auto executor = std::make_shared<thread_pool_executor>("async_generator pool", 4, std::chrono::seconds(10));
+    executor_shutdowner es(executor);
+
+    auto scan = [](std::shared_ptr<thread_pool_executor> executor) -> async_generator<size_t> {
+        for (size_t page = 0; page < page_count; page++) {
+            auto records = co_await executor->submit([page] {
+                std::vector<size_t> records(page_size);
+                for (size_t i = 0; i < page_size; i++) {
+                    records[i] = page * page_size + i;
+                }
+
+                return records;
+            });
+
+            for (auto record : records) {
+                co_yield record;
+            }
+        }
+    }(executor);
+
+    const auto records = drain(scan).get();
+    assert_equal(records.size(), page_count * page_size);
+
+    for (size_t i = 0; i < records.size(); i++) {
+        assert_equal(records[i], i);
+    }
+}
+
+int main() {
+    tester tester("async_generator test");
+
+    tester.add_step("move constructor", test_async_generator_move_constructor);
+    tester.add_step("destructor", test_async_generator_destructor);
+    tester.add_step("next, empty generator", test_async_generator_next_empty);
+    tester.add_step("next, exception", test_async_generator_next_exception);
+    tester.add_step("next, values", test_async_generator_next_values);
+    tester.add_step("next, references", test_async_generator_next_reference);
+    tester.add_step("co_await inside the generator", test_async_generator_awaiting_body);
+    tester.add_step("paginated scan", test_async_generator_paginated_scan);
+
+    tester.launch_test();
+    return 0;
+}
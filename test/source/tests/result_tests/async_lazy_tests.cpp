@@ -0,0 +1,306 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/custom_exception.h"
+#include "utils/executor_shutdowner.h"
+
+namespace concurrencpp::tests {
+    void test_async_lazy_constructor();
+    void test_async_lazy_runs_once();
+    void test_async_lazy_ready_value();
+    void test_async_lazy_exception();
+    void test_async_lazy_awaitable_initializer();
+    void test_async_lazy_get_share();
+    void test_async_lazy_executor_shutdown();
+    void test_async_once();
+    void test_async_lazy_mini_load_test();
+
+    result<int> await_lazy(async_lazy<int>& lazy, std::shared_ptr<size_t> counter) {
+        const auto value = co_await lazy;
+        ++(*counter);
+        co_return value;
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_async_lazy_constructor() {
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            async_lazy<int> lazy({}, [] {
+                return 0;
+            });
+        },
+        concurrencpp::details::consts::k_async_lazy_null_executor_err_msg);
+
+    // the initializer doesn't run until the value is needed
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    async_lazy<int> lazy(executor, [] {
+        return 1;
+    });
+
+    assert_equal(lazy.status(), result_status::idle);
+    assert_equal(executor->size(), static_cast<size_t>(0));
+}
+
+void concurrencpp::tests::test_async_lazy_runs_once() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    size_t invocations = 0;
+    async_lazy<int> lazy(executor, [&invocations] {
+        ++invocations;
+        return 42;
+    });
+
+    auto counter = std::make_shared<size_t>(0);
+    std::vector<result<int>> results;
+    for (size_t i = 0; i < 8; i++) {
+        results.emplace_back(await_lazy(lazy, counter));
+    }
+
+    // all the awaiters are parked, a single initializer was posted
+    assert_equal(executor->size(), static_cast<size_t>(1));
+    assert_equal(*counter, static_cast<size_t>(0));
+
+    assert_true(executor->loop_once());
+    assert_equal(invocations, static_cast<size_t>(1));
+    assert_equal(*counter, results.size());
+    assert_equal(lazy.status(), result_status::value);
+
+    for (auto& result : results) {
+        assert_equal(result.get(), 42);
+    }
+
+    assert_equal(executor->size(), static_cast<size_t>(0));
+}
+
+void concurrencpp::tests::test_async_lazy_ready_value() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    async_lazy<std::string> lazy(executor, [] {
+        return std::string("value");
+    });
+
+    lazy.start();
+    lazy.start();
+    assert_equal(executor->size(), static_cast<size_t>(1));
+    assert_true(executor->loop_once());
+
+    // once the value is ready, awaiting it doesn't suspend and yields the same object
+    const auto awaiter = [](async_lazy<std::string>& lazy) -> result<std::string*> {
+        auto& value = co_await lazy;
+        co_return &value;
+    };
+
+    auto result_0 = awaiter(lazy);
+    auto result_1 = awaiter(lazy);
+    assert_equal(result_0.status(), result_status::value);
+    assert_equal(result_1.status(), result_status::value);
+
+    const auto ptr = result_0.get();
+    assert_equal(ptr, result_1.get());
+    assert_equal(*ptr, std::string("value"));
+    assert_equal(executor->size(), static_cast<size_t>(0));
+}
+
+void concurrencpp::tests::test_async_lazy_exception() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    size_t invocations = 0;
+    async_lazy<int> lazy(executor, [&invocations]() -> int {
+        ++invocations;
+        throw custom_exception(7);
+    });
+
+    auto counter = std::make_shared<size_t>(0);
+    auto result_0 = await_lazy(lazy, counter);
+    assert_true(executor->loop_once());
+
+    // the exception is the value: it is rethrown to every awaiter, the initializer is not retried
+    auto result_1 = await_lazy(lazy, counter);
+    for (auto* result : {&result_0, &result_1}) {
+        try {
+            result->get();
+            assert_false(true);
+        } catch (const custom_exception& e) {
+            assert_equal(e.id, static_cast<intptr_t>(7));
+        }
+    }
+
+    assert_equal(invocations, static_cast<size_t>(1));
+    assert_equal(*counter, static_cast<size_t>(0));
+    assert_equal(lazy.status(), result_status::exception);
+}
+
+void concurrencpp::tests::test_async_lazy_awaitable_initializer() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    result_promise<int> promise;
+    auto promised_result = promise.get_result();
+
+    async_lazy<int> lazy(executor, [&promised_result]() mutable {
+        return std::move(promised_result);
+    });
+
+    auto counter = std::make_shared<size_t>(0);
+    auto result = await_lazy(lazy, counter);
+    assert_true(executor->loop_once());
+
+    // the initializer returned a result, the async_lazy is ready when it is
+    assert_equal(lazy.status(), result_status::idle);
+    promise.set_result(5);
+
+    assert_equal(result.get(), 5);
+    assert_equal(lazy.status(), result_status::value);
+
+    async_lazy<void> void_lazy(executor, []() -> lazy_result<void> {
+        co_return;
+    });
+
+    void_lazy.start();
+    assert_true(executor->loop_once());
+    assert_equal(void_lazy.status(), result_status::value);
+}
+
+void concurrencpp::tests::test_async_lazy_get_share() {
+    auto executor = std::make_shared<concurrencpp::thread_executor>();
+    executor_shutdowner es(executor);
+
+    async_lazy<int> lazy(executor, [] {
+        return 3;
+    });
+
+    auto shared = lazy.share();
+    assert_equal(lazy.get(), 3);
+    assert_equal(shared.get(), 3);
+    assert_equal(&shared.get(), &lazy.get());
+}
+
+void concurrencpp::tests::test_async_lazy_executor_shutdown() {
+    // the executor is shut down before the initializer runs: awaiters are not left hanging
+    {
+        auto executor = std::make_shared<concurrencpp::manual_executor>();
+        async_lazy<int> lazy(executor, [] {
+            return 0;
+        });
+
+        auto counter = std::make_shared<size_t>(0);
+        auto result = await_lazy(lazy, counter);
+        executor->shutdown();
+
+        assert_throws<errors::broken_task>([&result] {
+            result.get();
+        });
+
+        assert_equal(lazy.status(), result_status::exception);
+    }
+
+    // the executor is shut down before the value is needed
+    {
+        auto executor = std::make_shared<concurrencpp::manual_executor>();
+        async_lazy<int> lazy(executor, [] {
+            return 0;
+        });
+
+        executor->shutdown();
+
+        auto counter = std::make_shared<size_t>(0);
+        auto result = await_lazy(lazy, counter);
+        assert_throws<errors::broken_task>([&result] {
+            result.get();
+        });
+
+        assert_throws<errors::broken_task>([&lazy] {
+            lazy.get();
+        });
+    }
+}
+
+void concurrencpp::tests::test_async_once() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    size_t invocations = 0;
+    async_once once(executor, [&invocations] {
+        ++invocations;
+    });
+
+    const auto awaiter = [](async_once& once) -> result<void> {
+        co_await once;
+    };
+
+    auto result_0 = awaiter(once);
+    auto result_1 = awaiter(once);
+    assert_true(executor->loop_once());
+    assert_false(executor->loop_once());
+
+    result_0.get();
+    result_1.get();
+    awaiter(once).get();
+    assert_equal(invocations, static_cast<size_t>(1));
+}
+
+void concurrencpp::tests::test_async_lazy_mini_load_test() {
+    constexpr size_t worker_count = 4;
+    constexpr size_t rounds = 200;
+
+    std::vector<std::shared_ptr<worker_thread_executor>> workers(worker_count);
+    for (auto& worker : workers) {
+        worker = std::make_shared<worker_thread_executor>();
+    }
+
+    auto initializer_executor = std::make_shared<thread_pool_executor>("async_lazy initializer", 2, std::chrono::seconds(10));
+
+    for (size_t round = 0; round < rounds; round++) {
+        std::atomic_size_t invocations {0};
+        async_lazy<size_t> lazy(initializer_executor, [&invocations, round] {
+            invocations.fetch_add(1);
+            return round;
+        });
+
+        const auto worker_coro = [&lazy](executor_tag, std::shared_ptr<worker_thread_executor>) -> result<size_t> {
+            co_return co_await lazy;
+        };
+
+        std::vector<result<size_t>> results(worker_count);
+        for (size_t i = 0; i < worker_count; i++) {
+            results[i] = worker_coro({}, workers[i]);
+        }
+
+        for (auto& result : results) {
+            assert_equal(result.get(), round);
+        }
+
+        assert_equal(invocations.load(), static_cast<size_t>(1));
+    }
+
+    for (auto& worker : workers) {
+        worker->shutdown();
+    }
+
+    initializer_executor->shutdown();
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("async_lazy test");
+
+    tester.add_step("constructor", test_async_lazy_constructor);
+    tester.add_step("runs once", test_async_lazy_runs_once);
+    tester.add_step("ready value", test_async_lazy_ready_value);
+    tester.add_step("exception", test_async_lazy_exception);
+    tester.add_step("awaitable initializer", test_async_lazy_awaitable_initializer);
+    tester.add_step("get + share", test_async_lazy_get_share);
+    tester.add_step("executor shutdown", test_async_lazy_executor_shutdown);
+    tester.add_step("async_once", test_async_once);
+    tester.add_step("mini load test", test_async_lazy_mini_load_test);
+
+    tester.launch_test();
+    return 0;
+}
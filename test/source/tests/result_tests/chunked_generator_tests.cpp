@@ -0,0 +1,241 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/object_observer.h"
+#include "utils/custom_exception.h"
+
+#include <numeric>
+
+using namespace concurrencpp::tests;
+
+namespace concurrencpp::tests {
+    void test_chunked_generator_move_constructor();
+    void test_chunked_generator_destructor();
+    void test_chunked_generator_empty();
+    void test_chunked_generator_values();
+    void test_chunked_generator_chunks();
+    void test_chunked_generator_spans();
+    void test_chunked_generator_resumptions();
+    void test_chunked_generator_exception();
+}  // namespace concurrencpp::tests
+
+using concurrencpp::chunked_generator;
+
+namespace concurrencpp::tests {
+    chunked_generator<int, 8> iota(int count, size_t* steps = nullptr) {
+        if (steps != nullptr) {
+            ++(*steps);
+        }
+
+        for (int i = 0; i < count; i++) {
+            co_yield i;
+
+            if (steps != nullptr) {
+                ++(*steps);
+            }
+        }
+    }
+
+    template<class generator_type>
+    std::vector<std::vector<int>> collect_chunks(generator_type& gen) {
+        std::vector<std::vector<int>> chunks;
+        for (auto chunk : gen.chunks()) {
+            chunks.emplace_back(chunk.begin(), chunk.end());
+        }
+
+        return chunks;
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_chunked_generator_move_constructor() {
+    auto gen0 = iota(1);
+    assert_true(static_cast<bool>(gen0));
+
+    chunked_generator<int, 8> gen1(std::move(gen0));
+    assert_false(static_cast<bool>(gen0));
+    assert_true(static_cast<bool>(gen1));
+}
+
+void concurrencpp::tests::test_chunked_generator_destructor() {
+    auto gen_fn = [](testing_stub stub) -> chunked_generator<int, 4> {
+        co_yield 1;
+    };
+
+    object_observer observer;
+
+    {
+        auto gen0 = gen_fn(observer.get_testing_stub());
+        auto gen1(std::move(gen0));  // check to see that empty generator d.tor is benign
+    }
+
+    assert_equal(observer.get_destruction_count(), 1);
+}
+
+void concurrencpp::tests::test_chunked_generator_empty() {
+    auto gen0 = iota(1);
+    auto gen1(std::move(gen0));
+
+    assert_throws_with_error_message<errors::empty_generator>(
+        [&gen0] {
+            gen0.begin();
+        },
+        concurrencpp::details::consts::k_empty_chunked_generator_begin_err_msg);
+
+    assert_throws_with_error_message<errors::empty_generator>(
+        [&gen0] {
+            gen0.chunks();
+        },
+        concurrencpp::details::consts::k_empty_chunked_generator_chunks_err_msg);
+
+    // a generator that yields nothing
+    auto gen2 = iota(0);
+    assert_true(gen2.begin() == gen2.end());
+
+    auto gen3 = iota(0);
+    assert_true(collect_chunks(gen3).empty());
+}
+
+void concurrencpp::tests::test_chunked_generator_values() {
+    for (int count : {1, 7, 8, 9, 16, 100}) {
+        auto gen = iota(count);
+        int expected = 0;
+
+        for (auto value : gen) {
+            assert_equal(value, expected);
+            ++expected;
+        }
+
+        assert_equal(expected, count);
+    }
+
+    // values that are not trivially copyable
+    auto gen = []() -> chunked_generator<std::string, 2> {
+        for (int i = 0; i < 5; i++) {
+            std::string value = std::to_string(i);
+            co_yield std::move(value);
+        }
+    }();
+
+    std::vector<std::string> values;
+    for (auto& value : gen) {
+        values.emplace_back(value);
+    }
+
+    assert_equal(values, std::vector<std::string> {"0", "1", "2", "3", "4"});
+}
+
+void concurrencpp::tests::test_chunked_generator_chunks() {
+    auto gen = iota(20);
+    const auto chunks = collect_chunks(gen);
+
+    // full chunks, then the rest
+    assert_equal(chunks.size(), static_cast<size_t>(3));
+    assert_equal(chunks[0], std::vector<int> {0, 1, 2, 3, 4, 5, 6, 7});
+    assert_equal(chunks[1], std::vector<int> {8, 9, 10, 11, 12, 13, 14, 15});
+    assert_equal(chunks[2], std::vector<int> {16, 17, 18, 19});
+
+    // chunks are contiguous
+    auto gen1 = iota(64);
+    int sum = 0;
+    for (auto chunk : gen1.chunks()) {
+        sum = std::accumulate(chunk.data(), chunk.data() + chunk.size(), sum);
+    }
+
+    assert_equal(sum, 63 * 64 / 2);
+}
+
+void concurrencpp::tests::test_chunked_generator_spans() {
+    const std::vector<int> block {100, 101, 102};
+
+    auto gen = [](const std::vector<int>& block) -> chunked_generator<int, 8> {
+        co_yield 1;
+        co_yield 2;
+
+        // the values that were buffered before come first
+        co_yield std::span<const int>(block);
+
+        // handed out as a chunk of its own, even if it's bigger than the buffer
+        std::vector<int> big(10, 7);
+        co_yield std::span<const int>(big);
+
+        co_yield std::span<const int>();  // skipped
+        co_yield 3;
+    }(block);
+
+    const auto chunks = collect_chunks(gen);
+
+    assert_equal(chunks.size(), static_cast<size_t>(4));
+    assert_equal(chunks[0], std::vector<int> {1, 2});
+    assert_equal(chunks[1], block);
+    assert_equal(chunks[2], std::vector<int>(10, 7));
+    assert_equal(chunks[3], std::vector<int> {3});
+
+    // a yielded span is not copied
+    auto gen1 = [](const std::vector<int>& block) -> chunked_generator<int, 8> {
+        co_yield std::span<const int>(block);
+    }(block);
+
+    for (auto chunk : gen1.chunks()) {
+        assert_equal(chunk.data(), block.data());
+    }
+}
+
+void concurrencpp::tests::test_chunked_generator_resumptions() {
+    constexpr int count = 1'000;
+    size_t steps = 0;
+
+    auto gen = iota(count, &steps);
+    for (auto value : gen) {
+        // the generator filled the whole chunk, and isn't resumed again until the chunk is consumed
+        assert_equal(steps, static_cast<size_t>(value / 8 + 1) * 8);
+    }
+
+    assert_equal(steps, static_cast<size_t>(count + 1));
+}
+
+void concurrencpp::tests::test_chunked_generator_exception() {
+    auto gen = []() -> chunked_generator<int, 8> {
+        co_yield 1;
+        co_yield 2;
+        throw custom_exception(1234567);
+    }();
+
+    auto it = gen.begin();
+    assert_equal(*it, 1);
+
+    ++it;
+    assert_equal(*it, 2);
+
+    // the buffered values are handed out before the exception is thrown
+    assert_throws<custom_exception>([&it] {
+        ++it;
+    });
+
+    assert_true(it == gen.end());
+
+    auto gen1 = []() -> chunked_generator<int, 8> {
+        throw custom_exception(1234567);
+        co_yield 1;
+    }();
+
+    assert_throws<custom_exception>([&gen1] {
+        gen1.begin();
+    });
+}
+
+int main() {
+    tester tester("chunked_generator test");
+
+    tester.add_step("move constructor", test_chunked_generator_move_constructor);
+    tester.add_step("destructor", test_chunked_generator_destructor);
+    tester.add_step("empty generators", test_chunked_generator_empty);
+    tester.add_step("values", test_chunked_generator_values);
+    tester.add_step("chunks", test_chunked_generator_chunks);
+    tester.add_step("spans", test_chunked_generator_spans);
+    tester.add_step("resumptions", test_chunked_generator_resumptions);
+    tester.add_step("exceptions", test_chunked_generator_exception);
+
+    tester.launch_test();
+    return 0;
+}
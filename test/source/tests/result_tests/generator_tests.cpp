@@ -26,6 +26,15 @@ namespace concurrencpp::tests {
 
     void test_generator_iterator_dereferencing_operators();
     void test_generator_iterator_comparison_operators();
+
+    void test_elements_of_empty_generator();
+    void test_elements_of_tree_walk();
+    void test_elements_of_deep_nesting();
+    void test_elements_of_exception();
+    void test_elements_of_lvalue();
+    void test_elements_of_exhausted_generator();
+    void test_elements_of_owned_generator();
+    void test_elements_of_destruction();
 }  // namespace concurrencpp::tests
 
 void concurrencpp::tests::test_generator_move_constructor() {
@@ -281,6 +290,229 @@ void concurrencpp::tests::test_generator_iterator_comparison_operators() {
     }
 }
 
+namespace concurrencpp::tests {
+    generator<size_t> walk_range(size_t begin, size_t end) {
+        if (end - begin == 1) {
+            co_yield begin;
+            co_return;
+        }
+
+        const auto mid = begin + (end - begin) / 2;
+        co_yield elements_of(walk_range(begin, mid));
+        co_yield elements_of(walk_range(mid, end));
+    }
+
+    generator<size_t> countdown(size_t depth) {
+        co_yield depth;
+        if (depth != 0) {
+            co_yield elements_of(countdown(depth - 1));
+        }
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_elements_of_empty_generator() {
+    auto gen = []() -> generator<int> {
+        generator<int> nested = []() -> generator<int> {
+            co_yield 1;
+        }();
+
+        auto moved(std::move(nested));
+        co_yield elements_of(nested);
+    }();
+
+    assert_throws_with_error_message<errors::empty_generator>(
+        [&gen] {
+            gen.begin();
+        },
+        concurrencpp::details::consts::k_empty_generator_elements_of_err_msg);
+
+    // a nested generator that yields nothing
+    auto gen1 = []() -> generator<int> {
+        co_yield 1;
+        co_yield elements_of([]() -> generator<int> {
+            co_return;
+        }());
+        co_yield 2;
+    }();
+
+    std::vector<int> values;
+    for (auto value : gen1) {
+        values.emplace_back(value);
+    }
+
+    assert_equal(values, std::vector<int> {1, 2});
+}
+
+void concurrencpp::tests::test_elements_of_tree_walk() {
+    // a 10 level deep walk
+    constexpr size_t leaf_count = 1'024;
+
+    size_t expected = 0;
+    for (auto value : walk_range(0, leaf_count)) {
+        assert_equal(value, expected);
+        ++expected;
+    }
+
+    assert_equal(expected, leaf_count);
+}
+
+void concurrencpp::tests::test_elements_of_deep_nesting() {
+    constexpr size_t depth = 1'000;
+
+    auto expected = depth;
+    for (auto value : countdown(depth)) {
+        assert_equal(value, expected);
+        --expected;
+    }
+
+    assert_equal(expected, static_cast<size_t>(-1));
+}
+
+void concurrencpp::tests::test_elements_of_exception() {
+    auto thrower = []() -> generator<int> {
+        co_yield 1;
+        throw custom_exception(1234567);
+    };
+
+    // the exception is re-thrown inside the generator that yielded the nested one
+    {
+        auto gen = [](auto thrower) -> generator<int> {
+            try {
+                co_yield elements_of(thrower());
+            } catch (const custom_exception& e) {
+                assert_equal(e.id, static_cast<intptr_t>(1234567));
+            }
+
+            co_yield 2;
+        }(thrower);
+
+        std::vector<int> values;
+        for (auto value : gen) {
+            values.emplace_back(value);
+        }
+
+        assert_equal(values, std::vector<int> {1, 2});
+    }
+
+    // and reaches the consumer if it's not caught
+    {
+        auto gen = [](auto thrower) -> generator<int> {
+            co_yield 0;
+            co_yield elements_of(thrower());
+            co_yield 2;
+        }(thrower);
+
+        auto it = gen.begin();
+        assert_equal(*it, 0);
+
+        ++it;
+        assert_equal(*it, 1);
+
+        assert_throws<custom_exception>([&it] {
+            ++it;
+        });
+
+        assert_true(it == gen.end());
+    }
+}
+
+void concurrencpp::tests::test_elements_of_lvalue() {
+    std::vector<int> values {1, 2, 3};
+
+    auto gen = [](std::vector<int>& values) -> generator<int&> {
+        auto nested = [](std::vector<int>& values) -> generator<int&> {
+            for (auto& value : values) {
+                co_yield value;
+            }
+        }(values);
+
+        co_yield elements_of(nested);
+        assert_true(static_cast<bool>(nested));  // still owned by this generator
+    };
+
+    for (auto& value : gen(values)) {
+        value *= 10;
+    }
+
+    assert_equal(values, std::vector<int> {10, 20, 30});
+}
+
+void concurrencpp::tests::test_elements_of_exhausted_generator() {
+    auto gen = []() -> generator<int> {
+        auto nested = []() -> generator<int> {
+            co_yield 1;
+            co_yield 2;
+        }();
+
+        // drain the nested generator first, it has nothing left to yield
+        for (auto value : nested) {
+            co_yield value;
+        }
+
+        co_yield elements_of(nested);
+        co_yield 3;
+    };
+
+    std::vector<int> values;
+    for (auto value : gen()) {
+        values.emplace_back(value);
+    }
+
+    assert_equal(values, std::vector<int> {1, 2, 3});
+}
+
+void concurrencpp::tests::test_elements_of_owned_generator() {
+    object_observer observer;
+
+    {
+        auto gen = [](testing_stub stub) -> generator<int> {
+            // the rvalue generator is moved into the elements_of object, yielding it later doesn't dangle
+            auto nested = elements_of([](testing_stub stub) -> generator<int> {
+                co_yield 1;
+                co_yield 2;
+            }(std::move(stub)));
+
+            co_yield 0;
+            co_yield nested;
+            co_yield 3;
+        }(observer.get_testing_stub());
+
+        std::vector<int> values;
+        for (auto value : gen) {
+            values.emplace_back(value);
+        }
+
+        assert_equal(values, std::vector<int> {0, 1, 2, 3});
+    }
+
+    assert_equal(observer.get_destruction_count(), 1);
+}
+
+void concurrencpp::tests::test_elements_of_destruction() {
+    object_observer observer;
+
+    {
+        auto nested = [](testing_stub stub) -> generator<int> {
+            co_yield 1;
+            co_yield 2;
+        };
+
+        auto gen = [](auto nested, testing_stub stub0, testing_stub stub1) -> generator<int> {
+            co_yield elements_of(nested(std::move(stub1)));
+        }(nested, observer.get_testing_stub(), observer.get_testing_stub());
+
+        // leave the loop while the nested generator is suspended
+        for (auto value : gen) {
+            assert_equal(value, 1);
+            break;
+        }
+
+        assert_equal(observer.get_destruction_count(), 0);
+    }
+
+    assert_equal(observer.get_destruction_count(), 2);
+}
+
 int main() {
     {
         tester tester("generator test");
@@ -304,5 +536,20 @@ int main() {
         tester.launch_test();
     }
 
+    {
+        tester tester("elements_of test");
+
+        tester.add_step("empty generators", test_elements_of_empty_generator);
+        tester.add_step("tree walk", test_elements_of_tree_walk);
+        tester.add_step("deep nesting", test_elements_of_deep_nesting);
+        tester.add_step("exceptions", test_elements_of_exception);
+        tester.add_step("lvalue generator", test_elements_of_lvalue);
+        tester.add_step("exhausted generator", test_elements_of_exhausted_generator);
+        tester.add_step("owned generator", test_elements_of_owned_generator);
+        tester.add_step("destruction", test_elements_of_destruction);
+
+        tester.launch_test();
+    }
+
     return 0;
 }
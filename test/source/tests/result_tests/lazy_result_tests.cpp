@@ -33,6 +33,12 @@ namespace concurrencpp::tests {
     void test_lazy_result_run_impl(std::shared_ptr<thread_executor> ex);
     void test_lazy_result_run();
 
+    template<class type>
+    result<void> test_lazy_result_resolve_for_impl(std::shared_ptr<timer_queue> timer_queue,
+                                                   std::shared_ptr<thread_executor> thread_executor,
+                                                   std::shared_ptr<manual_executor> manual_executor);
+    void test_lazy_result_resolve_for();
+
     template<class type>
     void test_lazy_result_assignment_operator_self();
 
@@ -83,6 +89,13 @@ namespace concurrencpp::tests {
         co_return value_gen<type>::default_value();
     }
 
+    template<class type>
+    lazy_result<type> async_lazy_coro_val(bool& started, std::shared_ptr<manual_executor> ex) {
+        started = true;
+        co_await resume_on(ex);
+        co_return value_gen<type>::default_value();
+    }
+
     template<class type>
     lazy_result<type> async_lazy_coro_ex(bool& started, std::shared_ptr<thread_executor> ex, intptr_t id) {
         started = true;
@@ -398,6 +411,61 @@ void concurrencpp::tests::test_lazy_result_run() {
     test_lazy_result_run_impl<std::string&>(runtime.thread_executor());
 }
 
+template<class type>
+concurrencpp::result<void> concurrencpp::tests::test_lazy_result_resolve_for_impl(std::shared_ptr<timer_queue> timer_queue,
+                                                                                  std::shared_ptr<thread_executor> thread_executor,
+                                                                                  std::shared_ptr<manual_executor> manual_executor) {
+    assert_throws_with_error_message<errors::empty_result>(
+        [timer_queue, thread_executor] {
+            lazy_result<type>().resolve_for(timer_queue, std::chrono::milliseconds(100), thread_executor);
+        },
+        concurrencpp::details::consts::k_empty_lazy_result_resolve_for_err_msg);
+
+    assert_throws_with_error_message<errors::empty_result>(
+        [timer_queue, thread_executor] {
+            lazy_result<type>().resolve_until(timer_queue, std::chrono::high_resolution_clock::now(), thread_executor);
+        },
+        concurrencpp::details::consts::k_empty_lazy_result_resolve_until_err_msg);
+
+    // the task finishes before the timeout
+    {
+        auto started = false;
+        auto lazy = async_lazy_coro_val<type>(started, thread_executor);
+        auto done_result = co_await lazy.resolve_for(timer_queue, std::chrono::seconds(10), thread_executor);
+
+        assert_true(started);
+        assert_false(static_cast<bool>(lazy));
+        test_ready_result(std::move(done_result));
+    }
+
+    // the timeout is reached first, the task keeps running and can be resolved later
+    {
+        auto started = false;
+        auto lazy = async_lazy_coro_val<type>(started, manual_executor);
+        auto timed_out = co_await lazy.resolve_for(timer_queue, std::chrono::milliseconds(100), thread_executor);
+
+        assert_true(started);
+        assert_false(static_cast<bool>(lazy));
+        assert_equal(timed_out.status(), result_status::idle);
+
+        assert_true(manual_executor->loop_once());
+        test_ready_result(co_await timed_out.resolve());
+    }
+}
+
+void concurrencpp::tests::test_lazy_result_resolve_for() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(std::chrono::seconds(120));
+    auto thread_executor = std::make_shared<concurrencpp::thread_executor>();
+    auto manual_executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es0(thread_executor), es1(manual_executor);
+
+    test_lazy_result_resolve_for_impl<int>(timer_queue, thread_executor, manual_executor).get();
+    test_lazy_result_resolve_for_impl<std::string>(timer_queue, thread_executor, manual_executor).get();
+    test_lazy_result_resolve_for_impl<void>(timer_queue, thread_executor, manual_executor).get();
+    test_lazy_result_resolve_for_impl<int&>(timer_queue, thread_executor, manual_executor).get();
+    test_lazy_result_resolve_for_impl<std::string&>(timer_queue, thread_executor, manual_executor).get();
+}
+
 template<class type>
 void concurrencpp::tests::test_lazy_result_assignment_operator_self() {
     object_observer observer;
@@ -500,6 +568,7 @@ int main() {
     tester.add_step("resolve", test_lazy_result_resolve);
     tester.add_step("operator co_await", test_lazy_result_co_await_operator);
     tester.add_step("run", test_lazy_result_run);
+    tester.add_step("resolve_for/resolve_until", test_lazy_result_resolve_for);
     tester.add_step("operator =", test_lazy_result_assignment_operator);
 
     tester.launch_test();
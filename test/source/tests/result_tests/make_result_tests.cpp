@@ -3,8 +3,11 @@
 #include "infra/tester.h"
 #include "infra/assertions.h"
 #include "utils/object_observer.h"
+#include "utils/custom_exception.h"
 #include "utils/test_ready_result.h"
 
+#include <array>
+
 namespace concurrencpp::tests {
     template<class type>
     void test_make_ready_result_impl();
@@ -13,6 +16,10 @@ namespace concurrencpp::tests {
     template<class type>
     void test_make_exceptional_result_impl();
     void test_make_exceptional_result();
+
+    void test_ready_result_inline_operations();
+    void test_ready_result_throwing_value();
+    void test_ready_result_large_value();
 }  // namespace concurrencpp::tests
 
 template<class type>
@@ -61,6 +68,146 @@ void concurrencpp::tests::test_make_exceptional_result() {
     test_make_exceptional_result_impl<std::string&>();
 }
 
+void concurrencpp::tests::test_ready_result_inline_operations() {
+    // a ready result is moved and assigned like any other result
+    {
+        auto result = make_ready_result<std::string>("first");
+        result = make_ready_result<std::string>("second");
+
+        auto moved = std::move(result);
+        assert_false(static_cast<bool>(result));
+        assert_equal(moved.status(), result_status::value);
+        assert_equal(moved.wait_for(std::chrono::seconds(0)), result_status::value);
+        assert_equal(moved.get(), std::string("second"));
+        assert_false(static_cast<bool>(moved));
+
+        result_promise<std::string> promise;
+        moved = promise.get_result();
+        moved = make_ready_result<std::string>("third");
+        assert_equal(moved.get(), std::string("third"));
+    }
+
+    // co_await and resolve don't suspend
+    {
+        const auto awaiter = [](result<std::string> result) -> concurrencpp::result<std::string> {
+            co_return co_await result;
+        };
+
+        const auto resolver = [](result<int> result) -> concurrencpp::result<int> {
+            auto resolved = co_await result.resolve();
+            assert_equal(resolved.status(), result_status::exception);
+            co_return co_await resolved;
+        };
+
+        auto awaited = awaiter(make_ready_result<std::string>("value"));
+        assert_equal(awaited.status(), result_status::value);
+        assert_equal(awaited.get(), std::string("value"));
+
+        auto resolved = resolver(make_exceptional_result<int>(custom_exception(5)));
+        assert_equal(resolved.status(), result_status::exception);
+        assert_throws<custom_exception>([&resolved] {
+            resolved.get();
+        });
+    }
+
+    // operations that need a shared state still work
+    {
+        auto executor = std::make_shared<inline_executor>();
+        result_promise<int> promise;
+
+        auto all = when_all(executor, make_ready_result<int>(1), promise.get_result());
+        auto any = when_any(executor, make_ready_result<int>(2), make_ready_result<int>(3));
+        auto continuation = make_ready_result<int>(4).then_inline([](int i) {
+            return i + 1;
+        });
+
+        shared_result<int> shared(make_ready_result<int>(6));
+
+        promise.set_result(7);
+
+        auto all_results = all.run().get();
+        assert_equal(std::get<0>(all_results).get(), 1);
+        assert_equal(std::get<1>(all_results).get(), 7);
+
+        auto any_result = any.run().get();
+        assert_equal(any_result.index, static_cast<size_t>(0));
+        assert_equal(std::get<0>(any_result.results).get(), 2);
+
+        assert_equal(continuation.get(), 5);
+        assert_equal(shared.get(), 6);
+    }
+}
+
+namespace concurrencpp::tests {
+    struct throwing_value {
+        const intptr_t id;
+
+        throwing_value(intptr_t id) : id(id) {
+            if (id < 0) {
+                throw custom_exception(id);
+            }
+        }
+
+        throwing_value(throwing_value&& rhs) noexcept = default;
+    };
+
+    struct throwing_move_value {
+        throwing_move_value() = default;
+        throwing_move_value(throwing_move_value&&) noexcept(false) {}
+    };
+
+    struct large_value {
+        std::array<intptr_t, 32> ids;
+
+        large_value(intptr_t id) noexcept {
+            ids.fill(id);
+        }
+    };
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_ready_result_throwing_value() {
+    // a value that can't be built propagates the error and produces no result
+    assert_throws<custom_exception>([] {
+        make_ready_result<throwing_value>(-1);
+    });
+
+    auto result = make_ready_result<throwing_value>(5);
+    assert_equal(result.status(), result_status::value);
+    assert_equal(result.get().id, static_cast<intptr_t>(5));
+}
+
+void concurrencpp::tests::test_ready_result_large_value() {
+    // only values that can be moved without throwing and that are small enough are kept inline
+    static_assert(concurrencpp::details::is_inline_ready_result_v<int>);
+    static_assert(concurrencpp::details::is_inline_ready_result_v<std::string>);
+    static_assert(concurrencpp::details::is_inline_ready_result_v<void>);
+    static_assert(concurrencpp::details::is_inline_ready_result_v<large_value&>);
+    static_assert(!concurrencpp::details::is_inline_ready_result_v<throwing_move_value>);
+    static_assert(!concurrencpp::details::is_inline_ready_result_v<large_value>);
+
+    // big values don't make every result bigger, a ready one gets a shared state instead
+    static_assert(sizeof(result<large_value>) < sizeof(large_value));
+
+    auto result = make_ready_result<large_value>(7);
+    assert_equal(result.status(), result_status::value);
+    assert_equal(result.wait_for(std::chrono::seconds(0)), result_status::value);
+    assert_equal(result.get().ids[31], static_cast<intptr_t>(7));
+    assert_false(static_cast<bool>(result));
+
+    const auto awaiter = [](concurrencpp::result<large_value> result) -> concurrencpp::result<intptr_t> {
+        auto resolved = co_await result.resolve();
+        co_return (co_await resolved).ids[0];
+    };
+
+    assert_equal(awaiter(make_ready_result<large_value>(8)).get(), static_cast<intptr_t>(8));
+
+    auto exceptional = make_exceptional_result<large_value>(custom_exception(9));
+    assert_equal(exceptional.status(), result_status::exception);
+    assert_throws<custom_exception>([&exceptional] {
+        exceptional.get();
+    });
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -68,6 +215,9 @@ int main() {
 
     tester.add_step("make_ready_result", test_make_ready_result);
     tester.add_step("make_exceptional_result", test_make_exceptional_result);
+    tester.add_step("ready results operations", test_ready_result_inline_operations);
+    tester.add_step("throwing values", test_ready_result_throwing_value);
+    tester.add_step("large values", test_ready_result_large_value);
 
     tester.launch_test();
     return 0;
@@ -0,0 +1,259 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/custom_exception.h"
+#include "utils/executor_shutdowner.h"
+
+using namespace concurrencpp::tests;
+
+namespace concurrencpp::tests {
+    void test_parallel_map_validation();
+    void test_parallel_map_order();
+    void test_parallel_map_references();
+    void test_parallel_map_backpressure();
+    void test_parallel_map_exceptions();
+    void test_parallel_map_early_destruction();
+}  // namespace concurrencpp::tests
+
+using concurrencpp::generator;
+using concurrencpp::parallel_map;
+
+namespace concurrencpp::tests {
+    generator<size_t> sequence(size_t count, std::atomic_size_t* produced = nullptr) {
+        for (size_t i = 0; i < count; i++) {
+            if (produced != nullptr) {
+                produced->fetch_add(1, std::memory_order_relaxed);
+            }
+
+            co_yield i;
+        }
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_parallel_map_validation() {
+    auto executor = std::make_shared<inline_executor>();
+    auto identity = [](size_t i) {
+        return i;
+    };
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [identity] {
+            parallel_map(std::shared_ptr<inline_executor> {}, sequence(1), identity, 1);
+        },
+        concurrencpp::details::consts::k_parallel_map_null_executor_err_msg);
+
+    assert_throws_with_error_message<errors::empty_generator>(
+        [executor, identity] {
+            auto gen = sequence(1);
+            auto moved(std::move(gen));
+            parallel_map(executor, std::move(gen), identity, 1);
+        },
+        concurrencpp::details::consts::k_parallel_map_empty_generator_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [executor, identity] {
+            parallel_map(executor, sequence(1), identity, 0);
+        },
+        concurrencpp::details::consts::k_parallel_map_zero_window_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [executor, identity] {
+            parallel_map(executor, sequence(1), identity, 1, 0);
+        },
+        concurrencpp::details::consts::k_parallel_map_zero_chunk_size_err_msg);
+
+    // an empty sequence
+    auto outputs = parallel_map(executor, sequence(0), identity, 1);
+    assert_true(outputs.begin() == outputs.end());
+}
+
+void concurrencpp::tests::test_parallel_map_order() {
+    constexpr size_t count = 10'000;
+
+    auto executor = std::make_shared<thread_pool_executor>("parallel_map pool", 4, std::chrono::seconds(10));
+    executor_shutdowner es(executor);
+
+    size_t expected = 0;
+    for (auto& output : parallel_map(
+             executor,
+             sequence(count),
+             [](size_t i) {
+                 return std::to_string(i * i);
+             },
+             4,
+             16)) {
+        assert_equal(output, std::to_string(expected * expected));
+        ++expected;
+    }
+
+    assert_equal(expected, count);
+}
+
+void concurrencpp::tests::test_parallel_map_references() {
+    std::vector<std::string> values {"a", "b", "c", "d", "e"};
+
+    auto input = [](std::vector<std::string>& values) -> generator<std::string&> {
+        for (auto& value : values) {
+            co_yield value;
+        }
+    }(values);
+
+    std::vector<std::string> outputs;
+    for (auto& output : parallel_map(
+             std::make_shared<inline_executor>(),
+             std::move(input),
+             [](std::string s) {
+                 return s + s;
+             },
+             2,
+             2)) {
+        outputs.emplace_back(output);
+    }
+
+    // referenced values are copied, not moved
+    assert_equal(values, std::vector<std::string> {"a", "b", "c", "d", "e"});
+    assert_equal(outputs, std::vector<std::string> {"aa", "bb", "cc", "dd", "ee"});
+
+    // values are moved out of a value generator, so move-only values can be mapped too
+    auto input_1 = [](const std::vector<std::string>& values) -> generator<std::unique_ptr<std::string>> {
+        for (const auto& value : values) {
+            co_yield std::make_unique<std::string>(value);
+        }
+    }(values);
+
+    outputs.clear();
+    for (auto& output : parallel_map(
+             std::make_shared<inline_executor>(),
+             std::move(input_1),
+             [](std::unique_ptr<std::string> s) {
+                 return *s + *s;
+             },
+             2,
+             2)) {
+        outputs.emplace_back(output);
+    }
+
+    assert_equal(outputs, std::vector<std::string> {"aa", "bb", "cc", "dd", "ee"});
+}
+
+void concurrencpp::tests::test_parallel_map_backpressure() {
+    constexpr size_t count = 4'096;
+    constexpr size_t window = 4;
+    constexpr size_t chunk_size = 8;
+
+    auto executor = std::make_shared<thread_pool_executor>("parallel_map pool", 4, std::chrono::seconds(10));
+    executor_shutdowner es(executor);
+
+    std::atomic_size_t produced {0};
+    size_t consumed = 0;
+
+    for (auto output : parallel_map(
+             executor,
+             sequence(count, &produced),
+             [](size_t i) {
+                 return i;
+             },
+             window,
+             chunk_size)) {
+        ++consumed;
+        assert_equal(output + 1, consumed);
+
+        // the chunk being consumed, the chunks in flight and the value the input generator is suspended on
+        assert_smaller_equal(produced.load(std::memory_order_relaxed), consumed + (window + 1) * chunk_size + 1);
+    }
+
+    assert_equal(consumed, count);
+}
+
+void concurrencpp::tests::test_parallel_map_exceptions() {
+    auto executor = std::make_shared<thread_pool_executor>("parallel_map pool", 2, std::chrono::seconds(10));
+    executor_shutdowner es(executor);
+
+    // the callable throws
+    {
+        size_t consumed = 0;
+
+        assert_throws<custom_exception>([&] {
+            for (auto output : parallel_map(
+                     executor,
+                     sequence(1'000),
+                     [](size_t i) {
+                         if (i == 500) {
+                             throw custom_exception(i);
+                         }
+
+                         return i;
+                     },
+                     4,
+                     10)) {
+                assert_equal(output, consumed);
+                ++consumed;
+            }
+        });
+
+        // the outputs of the chunks before the failing one were yielded
+        assert_equal(consumed, static_cast<size_t>(500));
+    }
+
+    // the input generator throws
+    {
+        auto input = []() -> generator<int> {
+            co_yield 1;
+            throw custom_exception(2);
+        }();
+
+        assert_throws<custom_exception>([&] {
+            for (auto output : parallel_map(
+                     executor,
+                     std::move(input),
+                     [](int i) {
+                         return i;
+                     },
+                     1)) {
+                (void)output;
+            }
+        });
+    }
+}
+
+void concurrencpp::tests::test_parallel_map_early_destruction() {
+    auto executor = std::make_shared<thread_pool_executor>("parallel_map pool", 4, std::chrono::seconds(10));
+    auto shared_state = std::make_shared<int>(0);
+
+    {
+        auto outputs = parallel_map(
+            executor,
+            sequence(100'000),
+            [shared_state](size_t i) {
+                std::this_thread::sleep_for(std::chrono::microseconds(1));
+                return i + static_cast<size_t>(*shared_state);
+            },
+            8,
+            32);
+
+        for (auto output : outputs) {
+            if (output == 10) {
+                break;
+            }
+        }
+    }
+
+    // chunks still in flight keep the callable alive, and finish on their own
+    executor->shutdown();
+    assert_equal(shared_state.use_count(), 1);
+}
+
+int main() {
+    tester tester("parallel_map test");
+
+    tester.add_step("validation", test_parallel_map_validation);
+    tester.add_step("input order", test_parallel_map_order);
+    tester.add_step("references", test_parallel_map_references);
+    tester.add_step("backpressure", test_parallel_map_backpressure);
+    tester.add_step("exceptions", test_parallel_map_exceptions);
+    tester.add_step("early destruction", test_parallel_map_early_destruction);
+
+    tester.launch_test();
+    return 0;
+}
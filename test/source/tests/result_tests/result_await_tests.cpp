@@ -12,6 +12,11 @@ namespace concurrencpp::tests {
     template<class type>
     void test_result_await_impl();
     void test_result_await();
+    void test_result_await_deep_chain();
+
+    result<size_t> chain_link(result<size_t> previous) {
+        co_return (co_await previous) + 1;
+    }
 }  // namespace concurrencpp::tests
 
 using concurrencpp::result;
@@ -211,12 +216,32 @@ void concurrencpp::tests::test_result_await() {
     test_result_await_impl<std::string&>();
 }
 
+void concurrencpp::tests::test_result_await_deep_chain() {
+    // every link is suspended on the previous one. completing the first link resumes the whole chain from the
+    // promise's thread, which would nest a native stack frame per link if producers resumed their consumers directly.
+    constexpr size_t chain_length = 10'000;
+
+    result_promise<size_t> promise;
+    auto chain = promise.get_result();
+
+    for (size_t i = 0; i < chain_length; i++) {
+        chain = chain_link(std::move(chain));
+    }
+
+    assert_equal(chain.status(), result_status::idle);
+
+    promise.set_result(0);
+    assert_equal(chain.status(), result_status::value);
+    assert_equal(chain.get(), chain_length);
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
     tester tester("result::await");
 
     tester.add_step("await", test_result_await);
+    tester.add_step("deep continuation chain", test_result_await_deep_chain);
 
     tester.launch_test();
     return 0;
@@ -49,6 +49,8 @@ namespace concurrencpp::tests {
     template<class type>
     void test_rp_assignment_operator_impl();
     void test_rp_assignment_operator();
+
+    void test_result_promise_state_recycling();
 }  // namespace concurrencpp::tests
 
 using concurrencpp::result_promise;
@@ -432,6 +434,36 @@ void concurrencpp::tests::test_rp_assignment_operator() {
     test_rp_assignment_operator_impl<std::string&>();
 }
 
+void concurrencpp::tests::test_result_promise_state_recycling() {
+    // a freed standalone state is reused by the next state of the same size that is allocated on the same thread
+    auto state = new concurrencpp::details::result_state<size_t>();
+    const void* freed_address = state;
+    delete state;
+
+    auto recycled_state = new concurrencpp::details::result_state<size_t>();
+    assert_equal(static_cast<const void*>(recycled_state), freed_address);
+    delete recycled_state;
+
+    // states freed on other threads are recycled by those threads, nothing leaks or crashes
+    std::vector<result<int>> results;
+    std::vector<result_promise<int>> promises(1'024);
+    for (auto& promise : promises) {
+        results.emplace_back(promise.get_result());
+    }
+
+    std::thread setter([promises = std::move(promises)]() mutable {
+        for (size_t i = 0; i < promises.size(); i++) {
+            promises[i].set_result(static_cast<int>(i));
+        }
+    });
+
+    setter.join();
+
+    for (size_t i = 0; i < results.size(); i++) {
+        assert_equal(results[i].get(), static_cast<int>(i));
+    }
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -444,6 +476,7 @@ int main() {
     tester.add_step("set_exception", test_result_promise_set_exception);
     tester.add_step("set_from_function", test_result_promise_set_from_function);
     tester.add_step("operator =", test_rp_assignment_operator);
+    tester.add_step("state recycling", test_result_promise_state_recycling);
 
     tester.launch_test();
     return 0;
@@ -31,6 +31,10 @@ namespace concurrencpp::tests {
     void test_result_wait_until_impl();
     void test_result_wait_until();
 
+    template<class type>
+    void test_result_timed_wait_wakeup_impl();
+    void test_result_timed_wait_wakeup();
+
     template<class type>
     void test_result_assignment_operator_empty_to_empty();
     template<class type>
@@ -632,6 +636,98 @@ void concurrencpp::tests::test_result_wait_until() {
     test_result_wait_until_impl<std::string&>();
 }
 
+template<class type>
+void concurrencpp::tests::test_result_timed_wait_wakeup_impl() {
+    // a timed wait is woken up by the producer, not by the deadline
+    {
+        result_promise<type> rp;
+        auto result = rp.get_result();
+        const auto unblocking_time = high_resolution_clock::now() + milliseconds(100);
+
+        std::thread thread([rp = std::move(rp), unblocking_time]() mutable {
+            std::this_thread::sleep_until(unblocking_time);
+            rp.set_from_function(value_gen<type>::default_value);
+        });
+
+        const auto status = result.wait_for(seconds(10));
+        const auto now = high_resolution_clock::now();
+
+        assert_equal(status, result_status::value);
+        assert_bigger_equal(now, unblocking_time);
+        assert_smaller(now, unblocking_time + milliseconds(500));
+
+        test_ready_result(std::move(result));
+        thread.join();
+    }
+
+    // a timed wait that times out leaves the result idle and consumable
+    {
+        result_promise<type> rp;
+        auto result = rp.get_result();
+
+        assert_equal(result.wait_for(milliseconds(20)), result_status::idle);
+        assert_equal(result.wait_until(high_resolution_clock::now() + milliseconds(20)), result_status::idle);
+        assert_equal(result.status(), result_status::idle);
+
+        rp.set_from_function(value_gen<type>::default_value);
+        test_ready_result(std::move(result));
+    }
+
+    // a timed out wait followed by a completion: the next timed wait is woken up by the producer
+    {
+        result_promise<type> rp;
+        auto result = rp.get_result();
+
+        assert_equal(result.wait_for(milliseconds(20)), result_status::idle);
+
+        const auto id = 123456789;
+        const auto unblocking_time = high_resolution_clock::now() + milliseconds(100);
+
+        std::thread thread([rp = std::move(rp), unblocking_time, id]() mutable {
+            std::this_thread::sleep_until(unblocking_time);
+            rp.set_exception(std::make_exception_ptr(custom_exception(id)));
+        });
+
+        const auto status = result.wait_until(high_resolution_clock::now() + seconds(10));
+        const auto now = high_resolution_clock::now();
+
+        assert_equal(status, result_status::exception);
+        assert_bigger_equal(now, unblocking_time);
+        assert_smaller(now, unblocking_time + milliseconds(500));
+
+        test_ready_result_custom_exception(std::move(result), id);
+        thread.join();
+    }
+
+    // a completion that races with the deadline is never lost
+    for (size_t i = 0; i < 100; i++) {
+        result_promise<type> rp;
+        auto result = rp.get_result();
+
+        std::thread thread([rp = std::move(rp)]() mutable {
+            std::this_thread::sleep_for(microseconds(500));
+            rp.set_from_function(value_gen<type>::default_value);
+        });
+
+        const auto status = result.wait_for(microseconds(500));
+        thread.join();
+
+        if (status == result_status::idle) {
+            assert_equal(result.wait_for(seconds(10)), result_status::value);
+        }
+
+        test_ready_result(std::move(result));
+    }
+}
+
+void concurrencpp::tests::test_result_timed_wait_wakeup() {
+    test_result_timed_wait_wakeup_impl<int>();
+    test_result_timed_wait_wakeup_impl<std::string>();
+    test_result_timed_wait_wakeup_impl<void>();
+    test_result_timed_wait_wakeup_impl<int&>();
+    test_result_timed_wait_wakeup_impl<std::string&>();
+}
+
 template<class type>
 void concurrencpp::tests::test_result_assignment_operator_empty_to_empty() {
     result<type> result_0, result_1;
@@ -720,6 +816,7 @@ int main() {
     tester.add_step("wait", test_result_wait);
     tester.add_step("wait_for", test_result_wait_for);
     tester.add_step("wait_until", test_result_wait_until);
+    tester.add_step("timed wait wakeup", test_result_timed_wait_wakeup);
     tester.add_step("operator =", test_result_assignment_operator);
 
     tester.launch_test();
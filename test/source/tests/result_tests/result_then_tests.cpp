@@ -0,0 +1,319 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/custom_exception.h"
+#include "utils/throwing_executor.h"
+#include "utils/executor_shutdowner.h"
+
+namespace concurrencpp::tests {
+    void test_result_then_validation();
+    void test_result_then_inline_not_ready();
+    void test_result_then_inline_ready();
+    void test_result_then_fused_chain();
+    void test_result_then_void();
+    void test_result_then_exception();
+    void test_result_then_executor();
+    void test_result_then_executor_shutdown();
+    void test_result_then_mini_load_test();
+}  // namespace concurrencpp::tests
+
+using concurrencpp::result;
+using concurrencpp::result_promise;
+
+void concurrencpp::tests::test_result_then_validation() {
+    assert_throws_with_error_message<errors::empty_result>(
+        [] {
+            result<int>().then_inline([](int i) {
+                return i;
+            });
+        },
+        concurrencpp::details::consts::k_result_then_inline_error_msg);
+
+    assert_throws_with_error_message<errors::empty_result>(
+        [] {
+            result<int>().then(std::make_shared<inline_executor>(), [](int i) {
+                return i;
+            });
+        },
+        concurrencpp::details::consts::k_result_then_error_msg);
+
+    result_promise<int> promise;
+    auto result = promise.get_result();
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&result] {
+            result.then({}, [](int i) {
+                return i;
+            });
+        },
+        concurrencpp::details::consts::k_result_then_null_executor_error_msg);
+
+    // a failed call doesn't consume the result
+    assert_true(static_cast<bool>(result));
+}
+
+void concurrencpp::tests::test_result_then_inline_not_ready() {
+    result_promise<int> promise;
+    auto result = promise.get_result();
+
+    std::thread::id continuation_thread_id;
+    auto continuation = result.then_inline([&continuation_thread_id](int i) {
+        continuation_thread_id = std::this_thread::get_id();
+        return std::to_string(i);
+    });
+
+    assert_false(static_cast<bool>(result));
+    assert_equal(continuation.status(), result_status::idle);
+
+    // the continuation runs inside the thread that completes the input
+    std::thread setter([promise = std::move(promise)]() mutable {
+        promise.set_result(123);
+    });
+
+    const auto setter_thread_id = setter.get_id();
+    setter.join();
+
+    assert_equal(continuation.status(), result_status::value);
+    assert_equal(continuation.get(), std::string("123"));
+    assert_equal(continuation_thread_id, setter_thread_id);
+}
+
+void concurrencpp::tests::test_result_then_inline_ready() {
+    // the input is ready: the continuation runs right away, inside the calling thread
+    auto continuation = make_ready_result<int>(7).then_inline([](int i) {
+        return i * 6;
+    });
+
+    assert_equal(continuation.status(), result_status::value);
+    assert_equal(continuation.get(), 42);
+}
+
+void concurrencpp::tests::test_result_then_fused_chain() {
+    result_promise<int> promise;
+    std::vector<int> calls;
+
+    auto continuation = promise.get_result().then_inline(
+        [&calls](int i) {
+            calls.emplace_back(1);
+            return i + 1;
+        },
+        [&calls](int i) {
+            calls.emplace_back(2);
+            return i * 10;
+        },
+        [&calls](int i) {
+            calls.emplace_back(3);
+            return std::to_string(i);
+        });
+
+    assert_true(calls.empty());
+
+    promise.set_result(4);
+    assert_equal(continuation.get(), std::string("50"));
+    assert_equal(calls, std::vector<int> {1, 2, 3});
+
+    // each step may return void, in which case the next one takes no arguments
+    result_promise<void> void_promise;
+    size_t steps = 0;
+
+    auto void_continuation = void_promise.get_result().then_inline(
+        [&steps] {
+            ++steps;
+        },
+        [&steps] {
+            ++steps;
+            return steps;
+        });
+
+    void_promise.set_result();
+    assert_equal(void_continuation.get(), static_cast<size_t>(2));
+}
+
+void concurrencpp::tests::test_result_then_void() {
+    result_promise<std::string> promise;
+    std::string captured;
+
+    result<void> continuation = promise.get_result().then_inline([&captured](std::string s) {
+        captured = std::move(s);
+    });
+
+    promise.set_result("value");
+    continuation.get();
+    assert_equal(captured, std::string("value"));
+
+    // references are passed through
+    int value = 0;
+    result_promise<int&> ref_promise;
+    auto ref_continuation = ref_promise.get_result().then_inline([](int& ref) {
+        return &ref;
+    });
+
+    ref_promise.set_result(value);
+    assert_equal(ref_continuation.get(), &value);
+}
+
+void concurrencpp::tests::test_result_then_exception() {
+    // the input failed: the callables are skipped and the exception is forwarded
+    {
+        result_promise<int> promise;
+        size_t invocations = 0;
+
+        auto continuation = promise.get_result().then_inline(
+            [&invocations](int i) {
+                ++invocations;
+                return i;
+            },
+            [&invocations](int i) {
+                ++invocations;
+                return i;
+            });
+
+        promise.set_exception(std::make_exception_ptr(custom_exception(1)));
+
+        try {
+            continuation.get();
+            assert_false(true);
+        } catch (const custom_exception& e) {
+            assert_equal(e.id, static_cast<intptr_t>(1));
+        }
+
+        assert_equal(invocations, static_cast<size_t>(0));
+    }
+
+    // a callable throws: the rest of the chain is skipped
+    {
+        result_promise<int> promise;
+        size_t invocations = 0;
+
+        auto continuation = promise.get_result().then_inline(
+            [](int i) -> int {
+                throw custom_exception(i);
+            },
+            [&invocations](int i) {
+                ++invocations;
+                return i;
+            });
+
+        promise.set_result(2);
+
+        try {
+            continuation.get();
+            assert_false(true);
+        } catch (const custom_exception& e) {
+            assert_equal(e.id, static_cast<intptr_t>(2));
+        }
+
+        assert_equal(invocations, static_cast<size_t>(0));
+    }
+}
+
+void concurrencpp::tests::test_result_then_executor() {
+    auto executor = std::make_shared<manual_executor>();
+    executor_shutdowner es(executor);
+
+    result_promise<int> promise;
+    auto continuation = promise.get_result().then(executor, [](int i) {
+        return i + 1;
+    });
+
+    assert_equal(executor->size(), static_cast<size_t>(0));
+
+    // completing the input posts the continuation, it doesn't run it
+    promise.set_result(1);
+    assert_equal(executor->size(), static_cast<size_t>(1));
+    assert_equal(continuation.status(), result_status::idle);
+
+    assert_true(executor->loop_once());
+    assert_equal(continuation.get(), 2);
+
+    // a ready input is posted right away
+    auto ready_continuation = make_ready_result<int>(5).then(executor, [](int i) {
+        return i + 1;
+    });
+
+    assert_equal(executor->size(), static_cast<size_t>(1));
+    assert_true(executor->loop_once());
+    assert_equal(ready_continuation.get(), 6);
+}
+
+void concurrencpp::tests::test_result_then_executor_shutdown() {
+    // the executor throws: the continuation never runs and its result is broken
+    {
+        auto continuation = make_ready_result<int>(0).then(std::make_shared<throwing_executor>(), [](int i) {
+            return i;
+        });
+
+        assert_throws<errors::broken_task>([&continuation] {
+            continuation.get();
+        });
+    }
+
+    // the executor is shut down with the continuation still queued
+    {
+        auto executor = std::make_shared<manual_executor>();
+        auto continuation = make_ready_result<int>(0).then(executor, [](int i) {
+            return i;
+        });
+
+        executor->shutdown();
+
+        assert_throws<errors::broken_task>([&continuation] {
+            continuation.get();
+        });
+    }
+}
+
+void concurrencpp::tests::test_result_then_mini_load_test() {
+    constexpr size_t task_count = 1'024;
+
+    auto executor = std::make_shared<thread_pool_executor>("result::then pool", 4, std::chrono::seconds(10));
+    executor_shutdowner es(executor);
+
+    std::vector<result<size_t>> continuations;
+    continuations.reserve(task_count);
+
+    for (size_t i = 0; i < task_count; i++) {
+        auto input = executor->submit([i] {
+            return i;
+        });
+
+        if (i % 2 == 0) {
+            continuations.emplace_back(input.then_inline([](size_t i) {
+                return i * 2;
+            }));
+        } else {
+            continuations.emplace_back(input.then(
+                executor,
+                [](size_t i) {
+                    return i + 1;
+                },
+                [](size_t i) {
+                    return i * 2 - 2;
+                }));
+        }
+    }
+
+    for (size_t i = 0; i < task_count; i++) {
+        assert_equal(continuations[i].get(), i * 2);
+    }
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("result::then test");
+
+    tester.add_step("validation", test_result_then_validation);
+    tester.add_step("then_inline, input not ready", test_result_then_inline_not_ready);
+    tester.add_step("then_inline, input ready", test_result_then_inline_ready);
+    tester.add_step("fused chain", test_result_then_fused_chain);
+    tester.add_step("void + reference types", test_result_then_void);
+    tester.add_step("exceptions", test_result_then_exception);
+    tester.add_step("then(executor)", test_result_then_executor);
+    tester.add_step("executor shutdown", test_result_then_executor_shutdown);
+    tester.add_step("mini load test", test_result_then_mini_load_test);
+
+    tester.launch_test();
+    return 0;
+}
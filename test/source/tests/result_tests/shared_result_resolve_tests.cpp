@@ -12,6 +12,10 @@ namespace concurrencpp::tests {
     template<class type>
     void test_shared_result_resolve_impl();
     void test_shared_result_resolve();
+
+    template<class type>
+    void test_shared_result_resolve_for_impl();
+    void test_shared_result_resolve_for();
 }  // namespace concurrencpp::tests
 
 using concurrencpp::result;
@@ -195,12 +199,131 @@ void concurrencpp::tests::test_shared_result_resolve() {
     test_shared_result_resolve_impl<int&>();
     test_shared_result_resolve_impl<std::string&>();
 }
+
+namespace concurrencpp::tests {
+    template<class type>
+    result<void> test_resolve_for_ready_before_timeout(std::shared_ptr<timer_queue> timer_queue,
+                                                       std::shared_ptr<thread_executor> thread_executor) {
+        result_promise<type> rp;
+        auto result = shared_result<type>(rp.get_result());
+
+        auto setter = thread_executor->submit([rp = std::move(rp)]() mutable {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            rp.set_from_function(value_gen<type>::default_value);
+        });
+
+        const auto before = std::chrono::high_resolution_clock::now();
+        auto done_result = co_await result.resolve_for(timer_queue, std::chrono::seconds(10), thread_executor);
+        const auto after = std::chrono::high_resolution_clock::now();
+
+        assert_smaller(after - before, std::chrono::seconds(5));
+        test_ready_result(std::move(done_result));
+        co_await setter;
+    }
+
+    template<class type>
+    result<void> test_resolve_for_timeout(std::shared_ptr<timer_queue> timer_queue, std::shared_ptr<thread_executor> thread_executor) {
+        result_promise<type> rp;
+        auto result = shared_result<type>(rp.get_result());
+
+        const auto before = std::chrono::high_resolution_clock::now();
+        auto timed_out = co_await result.resolve_for(timer_queue, std::chrono::milliseconds(100), thread_executor);
+        const auto after = std::chrono::high_resolution_clock::now();
+
+        assert_bigger_equal(after - before, std::chrono::milliseconds(100));
+        assert_true(static_cast<bool>(timed_out));
+        assert_equal(timed_out.status(), result_status::idle);
+
+        // the consumer was rewound, the result can be awaited again.
+        rp.set_from_function(value_gen<type>::default_value);
+        test_ready_result(co_await timed_out.resolve());
+    }
+
+    template<class type>
+    result<void> test_resolve_until_timeout(std::shared_ptr<timer_queue> timer_queue, std::shared_ptr<thread_executor> thread_executor) {
+        result_promise<type> rp;
+        auto result = shared_result<type>(rp.get_result());
+
+        const auto deadline = std::chrono::high_resolution_clock::now() + std::chrono::milliseconds(100);
+        auto timed_out = co_await result.resolve_until(timer_queue, deadline, thread_executor);
+
+        assert_bigger_equal(std::chrono::high_resolution_clock::now(), deadline);
+        assert_equal(timed_out.status(), result_status::idle);
+
+        rp.set_from_function(value_gen<type>::default_value);
+        test_ready_result(co_await timed_out.resolve());
+    }
+}  // namespace concurrencpp::tests
+
+template<class type>
+void concurrencpp::tests::test_shared_result_resolve_for_impl() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(std::chrono::seconds(120));
+    auto thread_executor = std::make_shared<concurrencpp::thread_executor>();
+    executor_shutdowner es(thread_executor);
+
+    // empty result throws
+    {
+        assert_throws_with_error_message<concurrencpp::errors::empty_result>(
+            [timer_queue, thread_executor] {
+                shared_result<type>().resolve_for(timer_queue, std::chrono::milliseconds(100), thread_executor);
+            },
+            concurrencpp::details::consts::k_shared_result_resolve_for_error_msg);
+
+        assert_throws_with_error_message<concurrencpp::errors::empty_result>(
+            [timer_queue, thread_executor] {
+                shared_result<type>().resolve_until(timer_queue, std::chrono::high_resolution_clock::now(), thread_executor);
+            },
+            concurrencpp::details::consts::k_shared_result_resolve_until_error_msg);
+    }
+
+    // null timer_queue / executor throw
+    {
+        assert_throws_with_error_message<std::invalid_argument>(
+            [thread_executor] {
+                auto result = shared_result<type>(result_gen<type>::ready());
+                result.resolve_for({}, std::chrono::milliseconds(100), thread_executor);
+            },
+            concurrencpp::details::consts::k_resolve_timeout_null_timer_queue_error_msg);
+
+        assert_throws_with_error_message<std::invalid_argument>(
+            [timer_queue] {
+                auto result = shared_result<type>(result_gen<type>::ready());
+                result.resolve_for(timer_queue, std::chrono::milliseconds(100), {});
+            },
+            concurrencpp::details::consts::k_resolve_timeout_null_executor_error_msg);
+    }
+
+    // ready result resolves immediately
+    {
+        auto result = shared_result<type>(result_gen<type>::ready());
+        [](auto result, auto timer_queue, auto thread_executor) -> concurrencpp::result<void> {
+            const auto thread_id_0 = thread::get_current_virtual_id();
+            auto done_result = co_await result.resolve_for(timer_queue, std::chrono::seconds(10), thread_executor);
+            assert_equal(thread_id_0, thread::get_current_virtual_id());
+            test_ready_result(std::move(done_result));
+        }(std::move(result), timer_queue, thread_executor)
+            .get();
+    }
+
+    test_resolve_for_ready_before_timeout<type>(timer_queue, thread_executor).get();
+    test_resolve_for_timeout<type>(timer_queue, thread_executor).get();
+    test_resolve_until_timeout<type>(timer_queue, thread_executor).get();
+}
+
+void concurrencpp::tests::test_shared_result_resolve_for() {
+    test_shared_result_resolve_for_impl<int>();
+    test_shared_result_resolve_for_impl<std::string>();
+    test_shared_result_resolve_for_impl<void>();
+    test_shared_result_resolve_for_impl<int&>();
+    test_shared_result_resolve_for_impl<std::string&>();
+}
 using namespace concurrencpp::tests;
 
 int main() {
     tester tester("shared_result::resolve");
 
     tester.add_step("reslove", test_shared_result_resolve);
+    tester.add_step("resolve_for/resolve_until", test_shared_result_resolve_for);
 
     tester.launch_test();
     return 0;
@@ -5,6 +5,8 @@
 #include "utils/object_observer.h"
 #include "utils/test_generators.h"
 #include "utils/test_ready_result.h"
+#include "utils/executor_shutdowner.h"
+#include "utils/enqueue_counting_executor.h"
 
 namespace concurrencpp::tests {
     template<class type>
@@ -56,6 +58,9 @@ namespace concurrencpp::tests {
     template<class type>
     void test_shared_result_assignment_operator_impl();
     void test_shared_result_assignment_operator();
+
+    void test_shared_result_many_awaiters();
+    void test_shared_result_resume_executor();
 }  // namespace concurrencpp::tests
 
 using concurrencpp::result;
@@ -879,6 +884,182 @@ void concurrencpp::tests::test_shared_result_assignment_operator() {
     test_shared_result_assignment_operator_impl<std::string&>();
 }
 
+void concurrencpp::tests::test_shared_result_many_awaiters() {
+    constexpr size_t rounds = 100;
+    constexpr size_t coroutine_count = 64;
+    constexpr size_t thread_count = 4;
+
+    const auto awaiter = [](shared_result<int> sr, std::atomic_size_t& counter) -> result<void> {
+        const auto value = co_await sr;
+        if (value == 7) {
+            counter.fetch_add(1);
+        }
+    };
+
+    for (size_t round = 0; round < rounds; round++) {
+        result_promise<int> rp;
+        shared_result<int> sr(rp.get_result());
+        std::atomic_size_t counter {0};
+
+        std::vector<result<void>> results;
+        for (size_t i = 0; i < coroutine_count / 2; i++) {
+            results.emplace_back(awaiter(sr, counter));
+        }
+
+        // blocked threads, threads that time out and coroutines are pushed concurrently with the producer
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < thread_count; i++) {
+            threads.emplace_back([sr, &counter, i]() mutable {
+                if (i % 2 == 0) {
+                    sr.wait_for(std::chrono::microseconds(i * 50));
+                }
+
+                if (sr.get() == 7) {
+                    counter.fetch_add(1);
+                }
+            });
+        }
+
+        std::thread producer([&rp] {
+            rp.set_result(7);
+        });
+
+        for (size_t i = coroutine_count / 2; i < coroutine_count; i++) {
+            results.emplace_back(awaiter(sr, counter));
+        }
+
+        producer.join();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (auto& result : results) {
+            result.get();
+        }
+
+        assert_equal(counter.load(), coroutine_count + thread_count);
+    }
+
+    // a blocking wait that times out is unlinked, and the producer doesn't touch it
+    result_promise<int> rp;
+    shared_result<int> sr(rp.get_result());
+    std::atomic_size_t counter {0};
+
+    auto result_0 = awaiter(sr, counter);
+    assert_equal(sr.wait_for(std::chrono::milliseconds(5)), result_status::idle);
+    auto result_1 = awaiter(sr, counter);
+    assert_equal(sr.wait_for(std::chrono::milliseconds(5)), result_status::idle);
+
+    rp.set_result(7);
+    result_0.get();
+    result_1.get();
+    assert_equal(counter.load(), static_cast<size_t>(2));
+    assert_equal(sr.wait_for(std::chrono::milliseconds(5)), result_status::value);
+}
+
+void concurrencpp::tests::test_shared_result_resume_executor() {
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            shared_result<int> sr(make_ready_result<int>(0), {});
+        },
+        concurrencpp::details::consts::k_shared_result_null_resume_executor_error_msg);
+
+    constexpr size_t awaiter_count = 10;
+    constexpr size_t inline_resumptions = 3;
+
+    const auto awaiter = [](shared_result<int> sr, std::atomic_size_t& counter) -> result<void> {
+        co_await sr;
+        counter.fetch_add(1);
+    };
+
+    // all the awaiters but the inline ones are enqueued in a single batch
+    {
+        auto executor = std::make_shared<enqueue_counting_executor>();
+        result_promise<int> rp;
+        shared_result<int> sr(rp.get_result(), executor, inline_resumptions);
+        std::atomic_size_t counter {0};
+
+        std::vector<result<void>> results;
+        for (size_t i = 0; i < awaiter_count; i++) {
+            results.emplace_back(awaiter(sr, counter));
+        }
+
+        rp.set_result(1);
+        assert_equal(counter.load(), awaiter_count);
+        assert_equal(executor->single_enqueues, static_cast<size_t>(0));
+        assert_equal(executor->batch_sizes.size(), static_cast<size_t>(1));
+        assert_equal(executor->batch_sizes[0], awaiter_count - inline_resumptions);
+
+        // awaiting a ready shared_result doesn't go through the executor
+        awaiter(sr, counter).get();
+        assert_equal(executor->batch_sizes.size(), static_cast<size_t>(1));
+    }
+
+    {
+        auto executor = std::make_shared<manual_executor>();
+        executor_shutdowner es(executor);
+        result_promise<int> rp;
+        shared_result<int> sr(rp.get_result(), executor, inline_resumptions);
+        std::atomic_size_t counter {0};
+
+        std::vector<result<void>> results;
+        for (size_t i = 0; i < awaiter_count; i++) {
+            results.emplace_back(awaiter(sr, counter));
+        }
+
+        rp.set_result(1);
+        assert_equal(counter.load(), inline_resumptions);
+        assert_equal(executor->size(), awaiter_count - inline_resumptions);
+
+        executor->loop(awaiter_count);
+        assert_equal(counter.load(), awaiter_count);
+    }
+
+    // the result is ready, awaiters dropped by the executor are resumed inline rather than interrupted
+    {
+        auto executor = std::make_shared<manual_executor>();
+        result_promise<int> rp;
+        shared_result<int> sr(rp.get_result(), executor);
+        std::atomic_size_t counter {0};
+
+        std::vector<result<void>> results;
+        for (size_t i = 0; i < awaiter_count; i++) {
+            results.emplace_back(awaiter(sr, counter));
+        }
+
+        executor->shutdown();
+        rp.set_result(1);
+
+        assert_equal(counter.load(), awaiter_count);
+        for (auto& result : results) {
+            result.get();
+        }
+    }
+
+    // the awaiters are spread over a thread pool
+    {
+        constexpr size_t pool_awaiter_count = 1'000;
+
+        auto executor = std::make_shared<thread_pool_executor>("shared_result fan-out", 4, std::chrono::seconds(10));
+        result_promise<int> rp;
+        shared_result<int> sr(rp.get_result(), executor, 1);
+        std::atomic_size_t counter {0};
+
+        std::vector<result<void>> results;
+        for (size_t i = 0; i < pool_awaiter_count; i++) {
+            results.emplace_back(awaiter(sr, counter));
+        }
+
+        rp.set_result(1);
+        for (auto& result : results) {
+            result.get();
+        }
+
+        assert_equal(counter.load(), pool_awaiter_count);
+        executor->shutdown();
+    }
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -891,6 +1072,8 @@ int main() {
     tester.add_step("wait_for", test_shared_result_wait_for);
     tester.add_step("wait_until", test_shared_result_wait_until);
     tester.add_step("operator =", test_shared_result_assignment_operator);
+    tester.add_step("many awaiters", test_shared_result_many_awaiters);
+    tester.add_step("resume executor", test_shared_result_resume_executor);
 
     tester.launch_test();
     return 0;
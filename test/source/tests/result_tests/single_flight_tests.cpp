@@ -0,0 +1,389 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/custom_exception.h"
+#include "utils/executor_shutdowner.h"
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+namespace concurrencpp::tests {
+    void test_single_flight_constructor();
+    void test_single_flight_coalescing();
+    void test_single_flight_inline_executor();
+    void test_single_flight_awaitable_loader();
+    void test_single_flight_failures_not_cached();
+    void test_single_flight_ttl();
+    void test_single_flight_erase_clear();
+    void test_single_flight_executor_shutdown();
+    void test_single_flight_mini_load_test();
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_single_flight_constructor() {
+    auto executor = std::make_shared<concurrencpp::inline_executor>();
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+
+    using cache_type = single_flight<int, int>;
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            cache_type cache({});
+        },
+        concurrencpp::details::consts::k_single_flight_null_executor_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [executor] {
+            cache_type cache(executor, 0);
+        },
+        concurrencpp::details::consts::k_single_flight_invalid_shard_count_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [timer_queue] {
+            cache_type cache({}, timer_queue, 1s);
+        },
+        concurrencpp::details::consts::k_single_flight_null_executor_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [executor] {
+            cache_type cache(executor, {}, 1s);
+        },
+        concurrencpp::details::consts::k_single_flight_null_timer_queue_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [executor, timer_queue] {
+            cache_type cache(executor, timer_queue, 0ms);
+        },
+        concurrencpp::details::consts::k_single_flight_invalid_ttl_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [executor, timer_queue] {
+            cache_type cache(executor, timer_queue, 1s, 0);
+        },
+        concurrencpp::details::consts::k_single_flight_invalid_shard_count_err_msg);
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_single_flight_coalescing() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    single_flight<std::string, std::string> cache(executor);
+
+    size_t loads = 0;
+    const auto loader = [&loads](const std::string& key) {
+        ++loads;
+        return key + " value";
+    };
+
+    std::vector<shared_result<std::string>> results;
+    for (size_t i = 0; i < 100; i++) {
+        results.emplace_back(cache.get("a", loader));
+    }
+
+    results.emplace_back(cache.get("b", loader));
+
+    // one flight per key
+    assert_equal(executor->size(), static_cast<size_t>(2));
+    assert_equal(cache.size(), static_cast<size_t>(2));
+    assert_equal(executor->loop(100), static_cast<size_t>(2));
+    assert_equal(loads, static_cast<size_t>(2));
+
+    // callers of the same flight share the same value
+    for (size_t i = 0; i < 100; i++) {
+        assert_equal(results[i].get(), std::string("a value"));
+        assert_equal(&results[i].get(), &results[0].get());
+    }
+
+    assert_equal(results.back().get(), std::string("b value"));
+
+    // without a ttl, only in-flight loads are shared
+    assert_equal(cache.size(), static_cast<size_t>(0));
+    auto result = cache.get("a", loader);
+    assert_equal(executor->loop(100), static_cast<size_t>(1));
+    assert_equal(result.get(), std::string("a value"));
+    assert_equal(loads, static_cast<size_t>(3));
+}
+
+void concurrencpp::tests::test_single_flight_inline_executor() {
+    auto executor = std::make_shared<concurrencpp::inline_executor>();
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+
+    single_flight<int, int> cache(executor, timer_queue, 1s, 1);
+
+    size_t loads = 0;
+    const auto loader = [&loads](int key) {
+        ++loads;
+        return key * 2;
+    };
+
+    // the loader runs inline, while get is still running
+    assert_equal(cache.get(1, loader).get(), 2);
+    assert_equal(cache.get(1, loader).get(), 2);
+    assert_equal(cache.get(2, loader).get(), 4);
+    assert_equal(loads, static_cast<size_t>(2));
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_single_flight_awaitable_loader() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    single_flight<int, int> cache(executor);
+    result_promise<int> promise;
+    auto promised_result = promise.get_result();
+
+    size_t loads = 0;
+    const auto loader = [&loads, &promised_result](int) mutable {
+        ++loads;
+        return std::move(promised_result);
+    };
+
+    auto result_0 = cache.get(1, loader);
+    assert_true(executor->loop_once());
+
+    // the flight is not over until the returned result is
+    auto result_1 = cache.get(1, loader);
+    assert_equal(result_1.status(), result_status::idle);
+    promise.set_result(7);
+
+    assert_equal(result_0.get(), 7);
+    assert_equal(result_1.get(), 7);
+    assert_equal(loads, static_cast<size_t>(1));
+}
+
+void concurrencpp::tests::test_single_flight_failures_not_cached() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    executor_shutdowner es(executor);
+
+    single_flight<int, int> cache(executor, timer_queue, 1s);
+
+    size_t loads = 0;
+    const auto loader = [&loads](int key) {
+        ++loads;
+        if (loads == 1) {
+            throw custom_exception(key);
+        }
+
+        return key;
+    };
+
+    auto result_0 = cache.get(5, loader);
+    auto result_1 = cache.get(5, loader);
+    assert_true(executor->loop_once());
+
+    // all the callers of the failed flight get its exception
+    for (auto* result : {&result_0, &result_1}) {
+        try {
+            result->get();
+            assert_false(true);
+        } catch (const custom_exception& e) {
+            assert_equal(e.id, static_cast<intptr_t>(5));
+        }
+    }
+
+    // the next caller starts a new flight
+    assert_equal(cache.size(), static_cast<size_t>(0));
+    auto result_2 = cache.get(5, loader);
+    assert_true(executor->loop_once());
+    assert_equal(result_2.get(), 5);
+    assert_equal(loads, static_cast<size_t>(2));
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_single_flight_ttl() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    executor_shutdowner es(executor);
+
+    single_flight<int, size_t> cache(executor, timer_queue, 100ms);
+
+    size_t loads = 0;
+    const auto loader = [&loads](int) {
+        return ++loads;
+    };
+
+    auto result_0 = cache.get(1, loader);
+
+    // the ttl starts when the value is loaded
+    timer_queue->advance_by(50ms);
+    executor->loop(100);
+    assert_equal(result_0.get(), static_cast<size_t>(1));
+
+    timer_queue->advance_by(90ms);
+    executor->loop(100);
+    assert_equal(cache.get(1, loader).get(), static_cast<size_t>(1));
+
+    timer_queue->advance_by(10ms);
+    auto result_1 = cache.get(1, loader);
+    executor->loop(100);
+    assert_equal(result_1.get(), static_cast<size_t>(2));
+
+    // the periodic purge removes expired values that nobody asks for
+    auto result_2 = cache.get(2, loader);
+    executor->loop(100);
+    assert_equal(result_2.get(), static_cast<size_t>(3));
+    assert_equal(cache.size(), static_cast<size_t>(2));
+
+    for (size_t i = 0; i < 3; i++) {
+        timer_queue->advance_by(100ms);
+        executor->loop(100);
+    }
+
+    assert_equal(cache.size(), static_cast<size_t>(0));
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_single_flight_erase_clear() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    executor_shutdowner es(executor);
+
+    single_flight<int, int> cache(executor, timer_queue, 1s);
+
+    size_t loads = 0;
+    const auto loader = [&loads](int key) {
+        ++loads;
+        return key;
+    };
+
+    // erasing an in-flight key doesn't affect its callers, but the next caller starts a new flight
+    auto result_0 = cache.get(1, loader);
+    assert_true(cache.erase(1));
+    assert_false(cache.erase(1));
+
+    auto result_1 = cache.get(1, loader);
+    assert_equal(executor->loop(100), static_cast<size_t>(2));
+    assert_equal(result_0.get(), 1);
+    assert_equal(result_1.get(), 1);
+    assert_equal(loads, static_cast<size_t>(2));
+
+    // the stale flight doesn't override the new one
+    assert_equal(cache.size(), static_cast<size_t>(1));
+    cache.get(1, loader).get();
+    assert_equal(loads, static_cast<size_t>(2));
+
+    cache.get(2, loader);
+    cache.clear();
+    assert_equal(cache.size(), static_cast<size_t>(0));
+    executor->loop(100);
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_single_flight_executor_shutdown() {
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    single_flight<int, int> cache(executor);
+
+    const auto loader = [](int key) {
+        return key;
+    };
+
+    // pending loads are interrupted, and the key is not left poisoned
+    auto result_0 = cache.get(1, loader);
+    executor->shutdown();
+
+    assert_throws<errors::broken_task>([&result_0] {
+        result_0.get();
+    });
+
+    assert_equal(cache.size(), static_cast<size_t>(0));
+
+    auto result_1 = cache.get(1, loader);
+    assert_throws<errors::broken_task>([&result_1] {
+        result_1.get();
+    });
+
+    assert_equal(cache.size(), static_cast<size_t>(0));
+
+    // a loader that can't be copied into the flight doesn't leave the key poisoned either
+    struct throwing_loader {
+        throwing_loader() noexcept = default;
+        throwing_loader(const throwing_loader&) {
+            throw custom_exception(1234);
+        }
+
+        int operator()(int key) const noexcept {
+            return key;
+        }
+    };
+
+    const throwing_loader bad_loader;
+    assert_throws<custom_exception>([&cache, &bad_loader] {
+        cache.get(2, bad_loader);
+    });
+
+    assert_equal(cache.size(), static_cast<size_t>(0));
+}
+
+void concurrencpp::tests::test_single_flight_mini_load_test() {
+    constexpr size_t worker_count = 4;
+    constexpr size_t requests = 5'000;
+    constexpr int key_count = 10;
+
+    auto loader_executor = std::make_shared<thread_pool_executor>("single_flight loader", 2, std::chrono::seconds(10));
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(std::chrono::seconds(10));
+
+    single_flight<int, int> cache(loader_executor, timer_queue, 1h, 4);
+    std::atomic_size_t loads {0};
+
+    const auto loader = [&loads](int key) {
+        loads.fetch_add(1);
+        return key * 10;
+    };
+
+    const auto worker_coro = [&](executor_tag, std::shared_ptr<worker_thread_executor> ex, size_t id) -> result<void> {
+        for (size_t i = 0; i < requests; i++) {
+            const auto key = static_cast<int>((i + id) % key_count);
+            const auto value = co_await cache.get(key, loader);
+            if (value != key * 10) {
+                throw std::runtime_error("single_flight returned a wrong value");
+            }
+        }
+    };
+
+    std::vector<std::shared_ptr<worker_thread_executor>> workers(worker_count);
+    std::vector<result<void>> results(worker_count);
+
+    for (size_t i = 0; i < worker_count; i++) {
+        workers[i] = std::make_shared<worker_thread_executor>();
+        results[i] = worker_coro({}, workers[i], i);
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_equal(loads.load(), static_cast<size_t>(key_count));
+
+    for (auto& worker : workers) {
+        worker->shutdown();
+    }
+
+    loader_executor->shutdown();
+    timer_queue->shutdown();
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester tester("single_flight test");
+
+    tester.add_step("constructor", test_single_flight_constructor);
+    tester.add_step("coalescing", test_single_flight_coalescing);
+    tester.add_step("inline executor", test_single_flight_inline_executor);
+    tester.add_step("awaitable loader", test_single_flight_awaitable_loader);
+    tester.add_step("failures are not cached", test_single_flight_failures_not_cached);
+    tester.add_step("ttl", test_single_flight_ttl);
+    tester.add_step("erase + clear", test_single_flight_erase_clear);
+    tester.add_step("executor shutdown", test_single_flight_executor_shutdown);
+    tester.add_step("mini load test", test_single_flight_mini_load_test);
+
+    tester.launch_test();
+    return 0;
+}
@@ -40,6 +40,8 @@ namespace concurrencpp::tests {
     void test_when_any_tuple_resuming_mechanism(std::shared_ptr<worker_thread_executor> wte);
 
     void test_when_any_tuple();
+
+    void test_when_any_racing_producers();
 }  // namespace concurrencpp::tests
 
 template<class type>
@@ -453,6 +455,37 @@ void concurrencpp::tests::test_when_any_tuple() {
     test_when_any_tuple_resuming_mechanism(wte);
 }
 
+void concurrencpp::tests::test_when_any_racing_producers() {
+    // all the producers complete together: the losers still touch the when_any context while the winner resumes the
+    // when_any coroutine, which then destroys it.
+    constexpr size_t iteration_count = 1'024;
+    constexpr size_t result_count = 4;
+
+    auto producers = std::make_shared<thread_pool_executor>("when_any producers", result_count, std::chrono::seconds(10));
+    executor_shutdowner es(producers);
+    auto resume_executor = std::make_shared<inline_executor>();
+
+    for (size_t i = 0; i < iteration_count; i++) {
+        std::vector<result_promise<size_t>> result_promises(result_count);
+        std::vector<result<size_t>> results;
+
+        for (auto& rp : result_promises) {
+            results.emplace_back(rp.get_result());
+        }
+
+        auto any = when_any(resume_executor, results.begin(), results.end()).run();
+
+        for (size_t j = 0; j < result_count; j++) {
+            producers->post([rp = std::move(result_promises[j]), j]() mutable {
+                rp.set_result(j);
+            });
+        }
+
+        auto done = any.get();
+        assert_equal(done.results[done.index].get(), done.index);
+    }
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -460,6 +493,7 @@ int main() {
 
     test.add_step("when_any(begin, end)", test_when_any_vector);
     test.add_step("when_any(result_types&& ... results)", test_when_any_tuple);
+    test.add_step("racing producers", test_when_any_racing_producers);
 
     test.launch_test();
     return 0;
@@ -64,7 +64,7 @@ concurrencpp::result<void> concurrencpp::tests::test_scoped_async_lock_construct
 
     {
         async_lock lock;
-        const auto locked = co_await lock.try_lock();
+        const auto locked = lock.try_lock();
         assert_true(locked);
         scoped_async_lock sal(lock, std::adopt_lock);
         assert_true(sal.owns_lock());
@@ -146,7 +146,7 @@ void concurrencpp::tests::test_scoped_async_lock_try_lock() {
         assert_throws_contains_error_message<std::system_error>(
             [] {
                 scoped_async_lock sal;
-                sal.try_lock().run().get();
+                sal.try_lock();
             },
             concurrencpp::details::consts::k_scoped_async_lock_try_lock_no_mutex_err_msg);
     }
@@ -155,11 +155,11 @@ void concurrencpp::tests::test_scoped_async_lock_try_lock() {
         assert_throws_contains_error_message<std::system_error>(
             [] {
                 async_lock lock;
-                const auto locked = lock.try_lock().run().get();
+                const auto locked = lock.try_lock();
                 assert_true(locked);
 
                 scoped_async_lock sal(lock, std::adopt_lock);
-                sal.try_lock().run().get();
+                sal.try_lock();
             },
             concurrencpp::details::consts::k_scoped_async_lock_try_lock_deadlock_err_msg);
     }
@@ -169,7 +169,7 @@ void concurrencpp::tests::test_scoped_async_lock_try_lock() {
     scoped_async_lock sal(lock, std::defer_lock);
     assert_false(sal.owns_lock());
 
-    const auto locked = sal.try_lock().run().get();
+    const auto locked = sal.try_lock();
     assert_true(locked);
 
     assert_true(sal.owns_lock());
@@ -185,7 +185,7 @@ void concurrencpp::tests::test_scoped_async_lock_unlock() {
         },
         concurrencpp::details::consts::k_scoped_async_lock_unlock_invalid_lock_err_msg);
 
-    const auto locked = sal.try_lock().run().get();
+    const auto locked = sal.try_lock();
     assert_true(locked);
 
     sal.unlock();
@@ -210,7 +210,7 @@ void concurrencpp::tests::test_scoped_async_lock_swap() {
 
     {  // empty + non-empty
         async_lock lock1;
-        const auto locked = lock1.try_lock().run().get();
+        const auto locked = lock1.try_lock();
         assert_true(locked);
 
         scoped_async_lock sal0, sal1(lock1, std::adopt_lock);
@@ -227,7 +227,7 @@ void concurrencpp::tests::test_scoped_async_lock_swap() {
 
     {  // non-empty + empty
         async_lock lock0;
-        const auto locked = lock0.try_lock().run().get();
+        const auto locked = lock0.try_lock();
         assert_true(locked);
 
         scoped_async_lock sal0(lock0, std::adopt_lock), sal1;
@@ -244,10 +244,10 @@ void concurrencpp::tests::test_scoped_async_lock_swap() {
 
     {  // non-empty + non-empty
         async_lock lock0, lock1;
-        const auto locked0 = lock0.try_lock().run().get();
+        const auto locked0 = lock0.try_lock();
         assert_true(locked0);
 
-        const auto locked1 = lock1.try_lock().run().get();
+        const auto locked1 = lock1.try_lock();
         assert_true(locked1);
 
         scoped_async_lock sal0(lock0, std::adopt_lock), sal1(lock1, std::adopt_lock);
@@ -264,7 +264,7 @@ void concurrencpp::tests::test_scoped_async_lock_swap() {
 
     {  // swap with self
         async_lock lock;
-        const auto locked = lock.try_lock().run().get();
+        const auto locked = lock.try_lock();
         assert_true(locked);
 
         scoped_async_lock sal(lock, std::adopt_lock);
@@ -282,7 +282,7 @@ void concurrencpp::tests::test_scoped_async_lock_release() {
     assert_equal(sal.release(), nullptr);
 
     async_lock lock;
-    const auto locked = lock.try_lock().run().get();
+    const auto locked = lock.try_lock();
     assert_true(locked);
     scoped_async_lock sal0(lock, std::adopt_lock);
 
@@ -0,0 +1,221 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/executor_shutdowner.h"
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+namespace concurrencpp::tests {
+    void test_rate_limiter_constructor();
+    void test_rate_limiter_try_acquire();
+    void test_rate_limiter_acquire();
+    void test_rate_limiter_batched_wakeup();
+    void test_rate_limiter_shutdown();
+
+    result<void> acquire_and_count(std::shared_ptr<rate_limiter> limiter,
+                                   std::shared_ptr<executor> executor,
+                                   size_t count,
+                                   std::shared_ptr<size_t> counter) {
+        co_await limiter->acquire(executor, count);
+        ++(*counter);
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_rate_limiter_constructor() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [] {
+            rate_limiter limiter({}, 10, 10);
+        },
+        concurrencpp::details::consts::k_rate_limiter_null_timer_queue_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [timer_queue] {
+            rate_limiter limiter(timer_queue, 0, 10);
+        },
+        concurrencpp::details::consts::k_rate_limiter_invalid_rate_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [timer_queue] {
+            rate_limiter limiter(timer_queue, 10, 0);
+        },
+        concurrencpp::details::consts::k_rate_limiter_invalid_burst_err_msg);
+
+    rate_limiter limiter(timer_queue, 10, 7);
+    assert_equal(limiter.max_burst(), static_cast<size_t>(7));
+    assert_equal(limiter.available_permits(), static_cast<size_t>(7));
+
+    auto executor = std::make_shared<concurrencpp::inline_executor>();
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&limiter] {
+            limiter.acquire({});
+        },
+        concurrencpp::details::consts::k_rate_limiter_acquire_null_executor_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&limiter, executor] {
+            limiter.acquire(executor, 8);
+        },
+        concurrencpp::details::consts::k_rate_limiter_acquire_invalid_count_err_msg);
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_rate_limiter_try_acquire() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    rate_limiter limiter(timer_queue, 10, 5);
+
+    assert_true(limiter.try_acquire(3));
+    assert_true(limiter.try_acquire(2));
+    assert_false(limiter.try_acquire());
+    assert_true(limiter.try_acquire(0));
+
+    // permits are refilled at a constant rate, partial periods are not lost
+    timer_queue->advance_by(50ms);
+    assert_equal(limiter.available_permits(), static_cast<size_t>(0));
+
+    timer_queue->advance_by(50ms);
+    assert_equal(limiter.available_permits(), static_cast<size_t>(1));
+
+    timer_queue->advance_by(250ms);
+    assert_equal(limiter.available_permits(), static_cast<size_t>(3));
+
+    // the bucket never holds more than max_burst permits
+    timer_queue->advance_by(10s);
+    assert_equal(limiter.available_permits(), static_cast<size_t>(5));
+    assert_false(limiter.try_acquire(6));
+    assert_true(limiter.try_acquire(5));
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_rate_limiter_acquire() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    auto limiter = std::make_shared<rate_limiter>(timer_queue, 10, 2);
+    auto counter = std::make_shared<size_t>(0);
+
+    // permits are available, coroutines don't suspend
+    auto result_0 = acquire_and_count(limiter, executor, 1, counter);
+    auto result_1 = acquire_and_count(limiter, executor, 1, counter);
+    assert_equal(*counter, static_cast<size_t>(2));
+    assert_equal(executor->size(), static_cast<size_t>(0));
+
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < 4; i++) {
+        results.emplace_back(acquire_and_count(limiter, executor, 1, counter));
+    }
+
+    assert_equal(*counter, static_cast<size_t>(2));
+    assert_false(limiter->try_acquire());  // waiters are served first
+
+    // waiters are resumed in FIFO order, as permits become available
+    for (size_t i = 0; i < results.size(); i++) {
+        assert_equal(timer_queue->advance_by(100ms), static_cast<size_t>(1));
+        assert_equal(executor->loop(100), static_cast<size_t>(1));
+        assert_equal(*counter, static_cast<size_t>(3 + i));
+
+        results[i].get();
+        for (size_t j = i + 1; j < results.size(); j++) {
+            assert_equal(results[j].status(), result_status::idle);
+        }
+    }
+
+    // a waiter that needs several permits waits for all of them
+    auto result_2 = acquire_and_count(limiter, executor, 2, counter);
+    assert_equal(timer_queue->advance_by(100ms), static_cast<size_t>(0));
+    assert_equal(result_2.status(), result_status::idle);
+    assert_equal(timer_queue->advance_by(100ms), static_cast<size_t>(1));
+    executor->loop(100);
+    result_2.get();
+    assert_equal(*counter, static_cast<size_t>(7));
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_rate_limiter_batched_wakeup() {
+    constexpr size_t waiter_count = 100;
+
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    // a permit every 100 microseconds, waiters are woken up at most once per millisecond
+    auto limiter = std::make_shared<rate_limiter>(timer_queue, 10'000, 10);
+    auto counter = std::make_shared<size_t>(0);
+    assert_true(limiter->try_acquire(10));
+
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < waiter_count; i++) {
+        results.emplace_back(acquire_and_count(limiter, executor, 1, counter));
+    }
+
+    // a single timer node fires per wakeup, and hands out all the permits accumulated meanwhile
+    for (size_t i = 0; i < waiter_count / 10; i++) {
+        assert_equal(timer_queue->advance_by(1ms), static_cast<size_t>(1));
+        assert_equal(executor->size(), static_cast<size_t>(10));
+        executor->loop(100);
+        assert_equal(*counter, (i + 1) * 10);
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_equal(timer_queue->next_deadline(), concurrencpp::timer_queue::time_point::max());
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_rate_limiter_shutdown() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    auto limiter = std::make_shared<rate_limiter>(timer_queue, 1, 1);
+    auto counter = std::make_shared<size_t>(0);
+    assert_true(limiter->try_acquire());
+
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < 3; i++) {
+        results.emplace_back(acquire_and_count(limiter, executor, 1, counter));
+    }
+
+    // shutting down the timer_queue interrupts all the waiters, not just the one that is linked to it
+    timer_queue->shutdown();
+
+    for (auto& result : results) {
+        assert_equal(result.status(), result_status::exception);
+        assert_throws<errors::broken_task>([&result] {
+            result.get();
+        });
+    }
+
+    // new waiters are interrupted immediately
+    auto result = acquire_and_count(limiter, executor, 1, counter);
+    assert_throws<errors::broken_task>([&result] {
+        result.get();
+    });
+
+    assert_equal(*counter, static_cast<size_t>(0));
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester test("rate_limiter test");
+
+    test.add_step("constructor", test_rate_limiter_constructor);
+    test.add_step("try_acquire", test_rate_limiter_try_acquire);
+    test.add_step("acquire", test_rate_limiter_acquire);
+    test.add_step("batched wakeup", test_rate_limiter_batched_wakeup);
+    test.add_step("shutdown", test_rate_limiter_shutdown);
+
+    test.launch_test();
+    return 0;
+}
@@ -0,0 +1,254 @@
+#include "concurrencpp/concurrencpp.h"
+
+#include "infra/tester.h"
+#include "infra/assertions.h"
+#include "utils/custom_exception.h"
+#include "utils/executor_shutdowner.h"
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+namespace concurrencpp::tests {
+    void test_retry_validation();
+    void test_retry_backoff_delay();
+    void test_retry_succeeds();
+    void test_retry_exhausted();
+    void test_retry_awaitable_callable();
+    void test_retry_shutdown();
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_retry_validation() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    auto executor = std::make_shared<concurrencpp::inline_executor>();
+    const auto callable = [] {
+        return 0;
+    };
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&] {
+            concurrencpp::retry({}, {}, timer_queue, callable);
+        },
+        concurrencpp::details::consts::k_retry_null_executor_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [&] {
+            concurrencpp::retry({}, executor, {}, callable);
+        },
+        concurrencpp::details::consts::k_retry_null_timer_queue_err_msg);
+
+    const auto assert_invalid_policy = [&](const retry_policy& policy, const char* error_msg) {
+        assert_throws_with_error_message<std::invalid_argument>(
+            [&] {
+                concurrencpp::retry(policy, executor, timer_queue, callable);
+            },
+            error_msg);
+    };
+
+    retry_policy policy;
+    policy.max_attempts = 0;
+    assert_invalid_policy(policy, concurrencpp::details::consts::k_retry_invalid_max_attempts_err_msg);
+
+    policy = {};
+    policy.initial_delay = -1ms;
+    assert_invalid_policy(policy, concurrencpp::details::consts::k_retry_invalid_delay_err_msg);
+
+    policy = {};
+    policy.multiplier = 0.5;
+    assert_invalid_policy(policy, concurrencpp::details::consts::k_retry_invalid_multiplier_err_msg);
+
+    policy = {};
+    policy.jitter = 1.5;
+    assert_invalid_policy(policy, concurrencpp::details::consts::k_retry_invalid_jitter_err_msg);
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_retry_backoff_delay() {
+    retry_policy policy;
+    policy.initial_delay = 100ms;
+    policy.max_delay = 1'000ms;
+    policy.multiplier = 2.0;
+    policy.jitter = 0.0;
+
+    // without jitter, the delay grows exponentially up to max_delay
+    const std::chrono::milliseconds expected[] = {100ms, 200ms, 400ms, 800ms, 1'000ms, 1'000ms};
+    for (size_t i = 0; i < std::size(expected); i++) {
+        assert_equal(concurrencpp::details::retry_backoff_delay(policy, i + 1), expected[i]);
+    }
+
+    assert_equal(concurrencpp::details::retry_backoff_delay(policy, 1'000), 1'000ms);
+
+    // with jitter, the delay is somewhere in [(1 - jitter) * backoff, backoff]
+    policy.jitter = 0.5;
+    for (size_t i = 0; i < 1'000; i++) {
+        const auto delay = concurrencpp::details::retry_backoff_delay(policy, 3);
+        assert_bigger_equal(delay, 200ms);
+        assert_smaller_equal(delay, 400ms);
+    }
+
+    policy.jitter = 1.0;
+    bool differs = false;
+    const auto first = concurrencpp::details::retry_backoff_delay(policy, 4);
+    for (size_t i = 0; i < 1'000; i++) {
+        const auto delay = concurrencpp::details::retry_backoff_delay(policy, 4);
+        assert_smaller_equal(delay, 800ms);
+        differs |= (delay != first);
+    }
+
+    assert_true(differs);
+}
+
+void concurrencpp::tests::test_retry_succeeds() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    retry_policy policy;
+    policy.initial_delay = 100ms;
+    policy.jitter = 0.0;
+
+    size_t attempts = 0;
+    auto result = concurrencpp::retry(policy, executor, timer_queue, [&attempts] {
+                      ++attempts;
+                      if (attempts < 3) {
+                          throw custom_exception(attempts);
+                      }
+
+                      return 42;
+                  }).run();
+
+    // the first attempt runs immediately, then the coroutine sleeps 100ms and 200ms between attempts
+    assert_equal(attempts, static_cast<size_t>(1));
+    assert_equal(timer_queue->next_deadline(), timer_queue->now() + 100ms);
+
+    timer_queue->advance_by(100ms);
+    assert_equal(executor->loop(100), static_cast<size_t>(1));
+    assert_equal(attempts, static_cast<size_t>(2));
+    assert_equal(timer_queue->next_deadline(), timer_queue->now() + 200ms);
+
+    timer_queue->advance_by(199ms);
+    assert_equal(executor->size(), static_cast<size_t>(0));
+    timer_queue->advance_by(1ms);
+    assert_equal(executor->loop(100), static_cast<size_t>(1));
+
+    assert_equal(attempts, static_cast<size_t>(3));
+    assert_equal(result.get(), 42);
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_retry_exhausted() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    retry_policy policy;
+    policy.max_attempts = 3;
+    policy.initial_delay = 10ms;
+
+    size_t attempts = 0;
+    auto result = concurrencpp::retry(policy, executor, timer_queue, [&attempts] {
+                      ++attempts;
+                      throw custom_exception(attempts);
+                  }).run();
+
+    while (result.status() == result_status::idle) {
+        timer_queue->advance_by(10ms);
+        executor->loop(100);
+    }
+
+    // the exception of the last attempt is propagated
+    assert_equal(attempts, static_cast<size_t>(3));
+    try {
+        result.get();
+        assert_false(true);
+    } catch (const custom_exception& e) {
+        assert_equal(e.id, static_cast<intptr_t>(3));
+    }
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_retry_awaitable_callable() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    retry_policy policy;
+    policy.initial_delay = 1ms;
+
+    // a result returned by the callable is awaited, its exception counts as a failed attempt
+    size_t attempts = 0;
+    auto result = concurrencpp::retry(policy, executor, timer_queue, [&attempts] {
+                      ++attempts;
+                      if (attempts < 2) {
+                          return make_exceptional_result<std::string>(custom_exception(attempts));
+                      }
+
+                      return make_ready_result<std::string>("done");
+                  }).run();
+
+    while (result.status() == result_status::idle) {
+        timer_queue->advance_by(1ms);
+        executor->loop(100);
+    }
+
+    assert_equal(attempts, static_cast<size_t>(2));
+    assert_equal(result.get(), std::string("done"));
+
+    // void callables
+    attempts = 0;
+    auto void_result = concurrencpp::retry(policy, executor, timer_queue, [&attempts]() -> lazy_result<void> {
+                           ++attempts;
+                           if (attempts < 2) {
+                               throw custom_exception(attempts);
+                           }
+
+                           co_return;
+                       }).run();
+
+    while (void_result.status() == result_status::idle) {
+        timer_queue->advance_by(1ms);
+        executor->loop(100);
+    }
+
+    assert_equal(attempts, static_cast<size_t>(2));
+    void_result.get();
+
+    timer_queue->shutdown();
+}
+
+void concurrencpp::tests::test_retry_shutdown() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    auto executor = std::make_shared<concurrencpp::manual_executor>();
+    executor_shutdowner es(executor);
+
+    auto result = concurrencpp::retry({}, executor, timer_queue, [] {
+                      throw custom_exception(0);
+                  }).run();
+
+    // a retry that is sleeping when the timer_queue is shut down is interrupted
+    assert_equal(result.status(), result_status::idle);
+    timer_queue->shutdown();
+
+    assert_throws<errors::broken_task>([&result] {
+        result.get();
+    });
+}
+
+using namespace concurrencpp::tests;
+
+int main() {
+    tester test("retry test");
+
+    test.add_step("validation", test_retry_validation);
+    test.add_step("backoff delay", test_retry_backoff_delay);
+    test.add_step("succeeds", test_retry_succeeds);
+    test.add_step("exhausted", test_retry_exhausted);
+    test.add_step("awaitable callable", test_retry_awaitable_callable);
+    test.add_step("shutdown", test_retry_shutdown);
+
+    test.launch_test();
+    return 0;
+}
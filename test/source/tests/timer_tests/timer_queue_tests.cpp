@@ -4,6 +4,7 @@
 #include "infra/assertions.h"
 #include "utils/object_observer.h"
 #include "utils/executor_shutdowner.h"
+#include "utils/enqueue_counting_executor.h"
 
 #include <chrono>
 
@@ -13,8 +14,11 @@ namespace concurrencpp::tests {
     void test_timer_queue_make_timer();
     void test_timer_queue_make_oneshot_timer();
     void test_timer_queue_make_delay_object();
+    void test_timer_queue_sleep_for();
     void test_timer_queue_max_worker_idle_time();
     void test_timer_queue_thread_injection();
+    void test_timer_queue_virtual_time();
+    void test_timer_queue_batched_firing();
 }  // namespace concurrencpp::tests
 
 void concurrencpp::tests::test_timer_queue_make_timer() {
@@ -84,6 +88,49 @@ void concurrencpp::tests::test_timer_queue_make_delay_object() {
         concurrencpp::details::consts::k_broken_task_exception_error_msg);
 }
 
+void concurrencpp::tests::test_timer_queue_sleep_for() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(120s);
+    auto inline_executor = std::make_shared<concurrencpp::inline_executor>();
+    executor_shutdowner es(inline_executor);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [timer_queue] {
+            timer_queue->sleep_for(100ms, {});
+        },
+        concurrencpp::details::consts::k_timer_queue_sleep_for_executor_null_err_msg);
+
+    assert_throws_with_error_message<std::invalid_argument>(
+        [timer_queue] {
+            timer_queue->sleep_until(concurrencpp::timer_queue::clock_type::now(), {});
+        },
+        concurrencpp::details::consts::k_timer_queue_sleep_until_executor_null_err_msg);
+
+    auto sleeper = [](std::shared_ptr<concurrencpp::timer_queue> timer_queue,
+                      std::shared_ptr<concurrencpp::executor> executor) -> result<void> {
+        co_await timer_queue->sleep_for(1h, executor);
+    };
+
+    // pending sleepers are interrupted when the timer_queue is shut down
+    auto pending = sleeper(timer_queue, inline_executor);
+    assert_equal(pending.status(), result_status::idle);
+
+    timer_queue->shutdown();
+    assert_true(timer_queue->shutdown_requested());
+
+    assert_throws_with_error_message<errors::broken_task>(
+        [&pending] {
+            pending.get();
+        },
+        concurrencpp::details::consts::k_broken_task_exception_error_msg);
+
+    // sleeping on a queue that was already shut down reports the shutdown itself
+    assert_throws_with_error_message<errors::runtime_shutdown>(
+        [timer_queue, inline_executor, sleeper] {
+            sleeper(timer_queue, inline_executor).get();
+        },
+        concurrencpp::details::consts::k_timer_queue_shutdown_err_msg);
+}
+
 void concurrencpp::tests::test_timer_queue_max_worker_idle_time() {
     auto timer_queue = std::make_shared<concurrencpp::timer_queue>(1234567ms);
     assert_equal(timer_queue->max_worker_idle_time(), 1234567ms);
@@ -107,6 +154,169 @@ void concurrencpp::tests::test_timer_queue_thread_injection() {
     }
 }
 
+void concurrencpp::tests::test_timer_queue_virtual_time() {
+    const auto start_time = concurrencpp::timer_queue::time_point {} + 1h;
+
+    // a real-time timer_queue can't be advanced
+    {
+        auto timer_queue = std::make_shared<concurrencpp::timer_queue>(120s);
+        assert_false(timer_queue->uses_virtual_time());
+
+        assert_throws_with_error_message<std::logic_error>(
+            [timer_queue] {
+                timer_queue->advance_by(1s);
+            },
+            concurrencpp::details::consts::k_timer_queue_advance_by_not_virtual_err_msg);
+
+        assert_throws_with_error_message<std::logic_error>(
+            [timer_queue] {
+                timer_queue->next_deadline();
+            },
+            concurrencpp::details::consts::k_timer_queue_next_deadline_not_virtual_err_msg);
+    }
+
+    // time only passes when advanced, timers fire in deadline order with the clock set to their deadline
+    {
+        auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {}, start_time);
+        auto inline_executor = std::make_shared<concurrencpp::inline_executor>();
+        executor_shutdowner es(inline_executor);
+
+        assert_true(timer_queue->uses_virtual_time());
+        assert_equal(timer_queue->now(), start_time);
+        assert_equal(timer_queue->next_deadline(), concurrencpp::timer_queue::time_point::max());
+
+        std::vector<concurrencpp::timer_queue::time_point> fire_times;
+        auto periodic = timer_queue->make_timer(100ms, 1h, inline_executor, [&] {
+            fire_times.emplace_back(timer_queue->now());
+        });
+
+        auto oneshot = timer_queue->make_one_shot_timer(30min, inline_executor, [&] {
+            fire_times.emplace_back(timer_queue->now());
+        });
+
+        std::this_thread::sleep_for(50ms);
+        assert_equal(timer_queue->now(), start_time);
+        assert_true(fire_times.empty());
+        assert_equal(timer_queue->next_deadline(), start_time + 100ms);
+
+        // one simulated day, in no time
+        assert_equal(timer_queue->advance_by(24h), static_cast<size_t>(25));
+        assert_equal(timer_queue->now(), start_time + 24h);
+        assert_equal(fire_times.size(), static_cast<size_t>(25));
+        assert_equal(fire_times[0], start_time + 100ms);
+        assert_equal(fire_times[1], start_time + 30min);
+        assert_equal(fire_times[2], start_time + 1h + 100ms);
+        assert_equal(fire_times.back(), start_time + 23h + 100ms);
+
+        // time never goes backwards
+        assert_equal(timer_queue->advance_to(start_time), static_cast<size_t>(0));
+        assert_equal(timer_queue->now(), start_time + 24h);
+
+        // sleepers and delay objects use the virtual clock as well
+        auto sleeper = [](std::shared_ptr<concurrencpp::timer_queue> timer_queue,
+                          std::shared_ptr<concurrencpp::executor> executor) -> result<concurrencpp::timer_queue::time_point> {
+            co_await timer_queue->sleep_for(10min, executor);
+            co_await timer_queue->make_delay_object(10min, executor);
+            co_return timer_queue->now();
+        };
+
+        periodic.cancel();
+
+        const auto sleep_start = timer_queue->now();
+        auto sleeping = sleeper(timer_queue, inline_executor);
+        assert_equal(timer_queue->advance_by(15min), static_cast<size_t>(1));
+        assert_equal(sleeping.status(), result_status::idle);
+        assert_equal(timer_queue->advance_by(15min), static_cast<size_t>(1));
+        assert_equal(sleeping.get(), sleep_start + 20min);
+
+        // a timer can't drive the virtual time it's fired by
+        auto reentrant = timer_queue->make_one_shot_timer(1s, inline_executor, [timer_queue] {
+            assert_throws_with_error_message<std::logic_error>(
+                [timer_queue] {
+                    timer_queue->advance_by(1s);
+                },
+                concurrencpp::details::consts::k_timer_queue_advance_reentrancy_err_msg);
+        });
+
+        assert_equal(timer_queue->advance_by(1s), static_cast<size_t>(1));
+
+        timer_queue->shutdown();
+    }
+
+    // advancing to the end of time doesn't spin when no timer is pending
+    {
+        using time_point = concurrencpp::timer_queue::time_point;
+
+        auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {}, start_time);
+        auto inline_executor = std::make_shared<concurrencpp::inline_executor>();
+        executor_shutdowner es(inline_executor);
+
+        size_t fired = 0;
+        auto oneshot = timer_queue->make_one_shot_timer(1h, inline_executor, [&fired] {
+            ++fired;
+        });
+
+        assert_equal(timer_queue->advance_to(time_point::max()), static_cast<size_t>(1));
+        assert_equal(fired, static_cast<size_t>(1));
+        assert_equal(timer_queue->now(), start_time + 1h);
+
+        assert_equal(timer_queue->next_deadline(), time_point::max());
+        assert_equal(timer_queue->advance_to(time_point::max()), static_cast<size_t>(0));
+        assert_equal(timer_queue->now(), start_time + 1h);
+
+        // the clock stayed on the last fired deadline, timers made afterwards don't overflow and fire on time
+        time_point fired_at;
+        auto late = timer_queue->make_one_shot_timer(30min, inline_executor, [&fired_at, timer_queue] {
+            fired_at = timer_queue->now();
+        });
+
+        assert_equal(timer_queue->next_deadline(), start_time + 1h + 30min);
+        assert_equal(timer_queue->advance_to(time_point::max()), static_cast<size_t>(1));
+        assert_equal(fired_at, start_time + 1h + 30min);
+        assert_equal(timer_queue->now(), start_time + 1h + 30min);
+
+        timer_queue->shutdown();
+    }
+}
+
+void concurrencpp::tests::test_timer_queue_batched_firing() {
+    constexpr size_t timer_count = 1'000;
+
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(concurrencpp::virtual_time_tag {});
+    auto executor_0 = std::make_shared<enqueue_counting_executor>();
+    auto executor_1 = std::make_shared<enqueue_counting_executor>();
+
+    size_t executed = 0;
+    std::vector<concurrencpp::timer> timers;
+
+    for (size_t i = 0; i < timer_count; i++) {
+        std::shared_ptr<concurrencpp::executor> executor = (i % 2 == 0) ? executor_0 : executor_1;
+        timers.emplace_back(timer_queue->make_one_shot_timer(100ms, executor, [&executed] {
+            ++executed;
+        }));
+
+        timers.emplace_back(timer_queue->make_timer(100ms, 100ms, std::move(executor), [&executed] {
+            ++executed;
+        }));
+    }
+
+    // all the timers expire together: each executor gets a single batch per tick
+    assert_equal(timer_queue->advance_by(100ms), timer_count * 2);
+    assert_equal(executed, timer_count * 2);
+
+    assert_equal(timer_queue->advance_by(100ms), timer_count);
+    assert_equal(executed, timer_count * 3);
+
+    for (const auto& executor : {executor_0, executor_1}) {
+        assert_equal(executor->single_enqueues, static_cast<size_t>(0));
+        assert_equal(executor->batch_sizes.size(), static_cast<size_t>(2));
+        assert_equal(executor->batch_sizes[0], timer_count);
+        assert_equal(executor->batch_sizes[1], timer_count / 2);
+    }
+
+    timer_queue->shutdown();
+}
+
 using namespace concurrencpp::tests;
 
 int main() {
@@ -115,8 +325,11 @@ int main() {
     test.add_step("make_timer", test_timer_queue_make_timer);
     test.add_step("make_oneshot_timer", test_timer_queue_make_timer);
     test.add_step("make_delay_object", test_timer_queue_make_delay_object);
+    test.add_step("sleep_for", test_timer_queue_sleep_for);
     test.add_step("max_worker_idle_time", test_timer_queue_max_worker_idle_time);
     test.add_step("thread injection", test_timer_queue_thread_injection);
+    test.add_step("virtual time", test_timer_queue_virtual_time);
+    test.add_step("batched firing", test_timer_queue_batched_firing);
 
     test.launch_test();
     return 0;
@@ -38,6 +38,7 @@ namespace concurrencpp::tests {
 
     void test_timer_oneshot_timer();
     void test_timer_delay_object();
+    void test_timer_sleep_for();
 
     void test_timer_assignment_operator_empty_to_empty();
     void test_timer_assignment_operator_non_empty_to_non_empty();
@@ -68,8 +69,10 @@ namespace concurrencpp::tests {
             task();
         }
 
-        void enqueue(std::span<concurrencpp::task>) override {
-            // do nothing
+        void enqueue(std::span<concurrencpp::task> tasks) override {
+            for (auto& task : tasks) {
+                enqueue(std::move(task));
+            }
         }
 
         int max_concurrency_level() const noexcept override {
@@ -112,8 +115,10 @@ namespace concurrencpp::tests {
             task();
         }
 
-        void enqueue(std::span<concurrencpp::task>) override {
-            // do nothing
+        void enqueue(std::span<concurrencpp::task> tasks) override {
+            for (auto& task : tasks) {
+                enqueue(std::move(task));
+            }
         }
 
         int max_concurrency_level() const noexcept override {
@@ -565,6 +570,55 @@ void concurrencpp::tests::test_timer_delay_object() {
     wt_executor->shutdown();
 }
 
+namespace concurrencpp::tests {
+    result<void> sleep_and_record(std::shared_ptr<concurrencpp::timer_queue> timer_queue,
+                                  std::shared_ptr<concurrencpp::executor> executor,
+                                  milliseconds due_time,
+                                  std::vector<size_t>& order,
+                                  size_t id) {
+        co_await timer_queue->sleep_for(due_time, executor);
+        order.emplace_back(id);
+    }
+}  // namespace concurrencpp::tests
+
+void concurrencpp::tests::test_timer_sleep_for() {
+    auto timer_queue = std::make_shared<concurrencpp::timer_queue>(120s);
+    auto wt_executor = std::make_shared<concurrencpp::worker_thread_executor>();
+    const auto expected_interval = 150ms;
+
+    auto sleeper = [](std::shared_ptr<concurrencpp::timer_queue> timer_queue,
+                      std::shared_ptr<concurrencpp::executor> executor,
+                      milliseconds due_time) -> result<void> {
+        co_await timer_queue->sleep_for(due_time, executor);
+    };
+
+    for (size_t i = 0; i < 15; i++) {
+        const auto before = high_resolution_clock::now();
+        sleeper(timer_queue, wt_executor, expected_interval).get();
+        const auto after = high_resolution_clock::now();
+        const auto interval_ms = duration_cast<milliseconds>(after - before);
+        timer_tester::interval_ok(interval_ms.count(), expected_interval.count());
+    }
+
+    // sleepers are resumed by the order of their deadlines, not by the order of their registration
+    std::vector<size_t> order;
+    std::vector<result<void>> results;
+    for (size_t i = 0; i < 10; i++) {
+        results.emplace_back(sleep_and_record(timer_queue, wt_executor, milliseconds(500 - i * 50), order, i));
+    }
+
+    for (auto& result : results) {
+        result.get();
+    }
+
+    assert_equal(order.size(), 10);
+    for (size_t i = 0; i < 10; i++) {
+        assert_equal(order[i], 9 - i);
+    }
+
+    wt_executor->shutdown();
+}
+
 void concurrencpp::tests::test_timer_assignment_operator_empty_to_empty() {
     concurrencpp::timer timer1, timer2;
     assert_false(static_cast<bool>(timer1));
@@ -667,6 +721,7 @@ int main() {
     test.add_step("set_frequency", test_timer_set_frequency);
     test.add_step("oneshot_timer", test_timer_oneshot_timer);
     test.add_step("delay_object", test_timer_delay_object);
+    test.add_step("sleep_for", test_timer_sleep_for);
     test.add_step("operator =", test_timer_assignment_operator);
 
     test.launch_test();